@@ -35,6 +35,7 @@
 
 #include <libsolutil/JSON.h>
 #include <libsolutil/StringUtils.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <fmt/format.h>
 
@@ -44,8 +45,10 @@
 #include <range/v3/view/map.hpp>
 
 #include <fstream>
+#include <future>
 #include <limits>
 #include <iterator>
+#include <optional>
 #include <stack>
 
 using namespace solidity;
@@ -788,6 +791,56 @@ Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 	return *this;
 }
 
+namespace
+{
+
+/// Pool for optimising blocks in parallel. Shared by all assemblies, so that the threads and
+/// their copies of the simplification rules can be reused.
+util::ThreadPool& optimiserThreadPool()
+{
+	static util::ThreadPool pool;
+	return pool;
+}
+
+/// Minimum number of items optimised by a single task of the common subexpression eliminator.
+size_t constexpr c_minItemsPerCSETask = 256;
+
+/// Runs the common subexpression eliminator on a single block.
+/// @returns the optimised block or nullopt if it should not be replaced.
+std::optional<AssemblyItems> optimiseBlock(
+	AssemblyItems::const_iterator _begin,
+	AssemblyItems::const_iterator _end,
+	bool _usesMSize
+)
+{
+	KnownState emptyState;
+	CommonSubexpressionEliminator eliminator{emptyState};
+	try
+	{
+		solAssert(eliminator.feedItems(_begin, _end, _usesMSize) == _end);
+		AssemblyItems optimisedBlock = eliminator.getOptimizedItems();
+		if (optimisedBlock.size() < static_cast<size_t>(_end - _begin))
+			return optimisedBlock;
+	}
+	catch (StackTooDeepException const&)
+	{
+		// This might happen if the opcode reconstruction is not as efficient
+		// as the hand-crafted code.
+	}
+	catch (ItemNotAvailableException const&)
+	{
+		// This might happen if e.g. associativity and commutativity rules
+		// reorganise the expression tree, but not all leaves are available.
+	}
+	catch (ExpressionClassesLimitException const&)
+	{
+		// The block is too complex to be analysed within the memory limit.
+	}
+	return std::nullopt;
+}
+
+}
+
 std::map<u256, u256> const& Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
@@ -899,39 +952,49 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 			});
 
-			auto iter = items.begin();
-			while (iter != items.end())
+			std::vector<std::pair<AssemblyItems::const_iterator, AssemblyItems::const_iterator>> blocks;
+			for (auto iter = items.cbegin(); iter != items.cend();)
 			{
-				KnownState emptyState;
-				CommonSubexpressionEliminator eliminator{emptyState};
-				auto orig = iter;
-				iter = eliminator.feedItems(iter, items.end(), usesMSize);
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
-				try
-				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < static_cast<size_t>(iter - orig));
-				}
-				catch (StackTooDeepException const&)
-				{
-					// This might happen if the opcode reconstruction is not as efficient
-					// as the hand-crafted code.
-				}
-				catch (ItemNotAvailableException const&)
-				{
-					// This might happen if e.g. associativity and commutativity rules
-					// reorganise the expression tree, but not all leaves are available.
-				}
+				auto blockEnd = CommonSubexpressionEliminator::blockEnd(iter, items.cend(), usesMSize);
+				blocks.emplace_back(iter, blockEnd);
+				iter = blockEnd;
+			}
+
+			// Blocks are optimised independently of each other, so this is done in parallel and the
+			// results are combined in the original order. Most blocks are only a few items long, so
+			// consecutive blocks are grouped into tasks of a minimum size to keep the scheduling
+			// overhead low.
+			std::vector<std::future<std::vector<std::optional<AssemblyItems>>>> optimisedChunks;
+			for (size_t chunkBegin = 0; chunkBegin < blocks.size();)
+			{
+				size_t chunkEnd = chunkBegin;
+				for (size_t chunkSize = 0; chunkEnd < blocks.size() && chunkSize < c_minItemsPerCSETask; ++chunkEnd)
+					chunkSize += static_cast<size_t>(blocks[chunkEnd].second - blocks[chunkEnd].first);
+				optimisedChunks.emplace_back(optimiserThreadPool().submit([&blocks, chunkBegin, chunkEnd, usesMSize]() {
+					std::vector<std::optional<AssemblyItems>> optimisedBlocks;
+					for (size_t i = chunkBegin; i < chunkEnd; ++i)
+						optimisedBlocks.emplace_back(optimiseBlock(blocks[i].first, blocks[i].second, usesMSize));
+					return optimisedBlocks;
+				}));
+				chunkBegin = chunkEnd;
+			}
+			// The tasks reference the items, so they have to be finished before any exception is rethrown.
+			for (auto& optimisedChunk: optimisedChunks)
+				optimisedChunk.wait();
 
-				if (shouldReplace)
+			size_t blockIndex = 0;
+			for (auto& optimisedChunk: optimisedChunks)
+				for (std::optional<AssemblyItems> const& optimisedBlock: optimisedChunk.get())
 				{
-					count++;
-					optimisedItems += optimisedChunk;
+					if (optimisedBlock)
+					{
+						count++;
+						optimisedItems += *optimisedBlock;
+					}
+					else
+						copy(blocks[blockIndex].first, blocks[blockIndex].second, back_inserter(optimisedItems));
+					++blockIndex;
 				}
-				else
-					copy(orig, iter, back_inserter(optimisedItems));
-			}
 			if (optimisedItems.size() < items.size())
 			{
 				items = std::move(optimisedItems);
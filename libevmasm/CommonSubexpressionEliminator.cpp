@@ -79,6 +79,11 @@ void CommonSubexpressionEliminator::feedItem(AssemblyItem const& _item, bool _co
 	StoreOperation op = m_state.feedItem(_item, _copyItem);
 	if (op.isValid())
 		m_storeOperations.push_back(op);
+	assertThrow(
+		m_state.expressionClasses().size() <= c_maxExpressionClasses,
+		ExpressionClassesLimitException,
+		"Too many expression classes in block."
+	);
 }
 
 void CommonSubexpressionEliminator::optimizeBreakingItem()
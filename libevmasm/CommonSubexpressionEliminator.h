@@ -29,6 +29,7 @@
 #include <set>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/Exceptions.h>
@@ -71,13 +72,35 @@ public:
 	/// Feeds AssemblyItems into the eliminator and @returns the iterator pointing at the first
 	/// item that must be fed into a new instance of the eliminator.
 	/// @param _msizeImportant if false, do not consider modification of MSIZE a side-effect
+	/// @throws ExpressionClassesLimitException if the block is too complex to be analysed,
+	/// the eliminator cannot be used anymore in that case.
 	template <class AssemblyItemIterator>
 	AssemblyItemIterator feedItems(AssemblyItemIterator _iterator, AssemblyItemIterator _end, bool _msizeImportant);
 
+	/// @returns the iterator pointing at the first item after the block starting at @a _iterator,
+	/// i.e. the same iterator feedItems would return, without analysing the items.
+	template <class AssemblyItemIterator>
+	static AssemblyItemIterator blockEnd(AssemblyItemIterator _iterator, AssemblyItemIterator _end, bool _msizeImportant);
+
 	/// @returns the resulting items after optimization.
 	AssemblyItems getOptimizedItems();
 
 private:
+	/// Maximum number of items in a block. Longer sequences of items are split into several blocks.
+	static unsigned constexpr c_maxBlockSize = 2000;
+	/// Maximum number of expression classes created while analysing a block, which bounds the
+	/// memory needed for a single block.
+	static size_t constexpr c_maxExpressionClasses = 100000;
+
+	/// @returns the end of the items of the block starting at @a _iterator that are not the
+	/// item breaking the block and whether such an item follows.
+	template <class AssemblyItemIterator>
+	static std::pair<AssemblyItemIterator, bool> findBlockEnd(
+		AssemblyItemIterator _iterator,
+		AssemblyItemIterator _end,
+		bool _msizeImportant
+	);
+
 	/// Feeds the item into the system for analysis.
 	void feedItem(AssemblyItem const& _item, bool _copyItem = false);
 
@@ -179,17 +202,40 @@ AssemblyItemIterator CommonSubexpressionEliminator::feedItems(
 )
 {
 	assertThrow(!m_breakingItem, OptimizerException, "Invalid use of CommonSubexpressionEliminator.");
-	unsigned const maxChunkSize = 2000;
-	unsigned chunkSize = 0;
-	for (
-		;
-		_iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant) && chunkSize < maxChunkSize;
-		++_iterator, ++chunkSize
-	)
+	auto [itemsEnd, hasBreakingItem] = findBlockEnd(_iterator, _end, _msizeImportant);
+	for (; _iterator != itemsEnd; ++_iterator)
 		feedItem(*_iterator);
-	if (_iterator != _end && chunkSize < maxChunkSize)
+	if (hasBreakingItem)
 		m_breakingItem = &(*_iterator++);
 	return _iterator;
 }
 
+template <class AssemblyItemIterator>
+AssemblyItemIterator CommonSubexpressionEliminator::blockEnd(
+	AssemblyItemIterator _iterator,
+	AssemblyItemIterator _end,
+	bool _msizeImportant
+)
+{
+	auto [itemsEnd, hasBreakingItem] = findBlockEnd(_iterator, _end, _msizeImportant);
+	return hasBreakingItem ? std::next(itemsEnd) : itemsEnd;
+}
+
+template <class AssemblyItemIterator>
+std::pair<AssemblyItemIterator, bool> CommonSubexpressionEliminator::findBlockEnd(
+	AssemblyItemIterator _iterator,
+	AssemblyItemIterator _end,
+	bool _msizeImportant
+)
+{
+	unsigned blockSize = 0;
+	for (
+		;
+		_iterator != _end && !SemanticInformation::breaksCSEAnalysisBlock(*_iterator, _msizeImportant) && blockSize < c_maxBlockSize;
+		++_iterator, ++blockSize
+	)
+	{}
+	return {_iterator, _iterator != _end && blockSize < c_maxBlockSize};
+}
+
 }
@@ -32,5 +32,6 @@ struct AssemblyImportException: virtual AssemblyException {};
 struct OptimizerException: virtual AssemblyException {};
 struct StackTooDeepException: virtual OptimizerException {};
 struct ItemNotAvailableException: virtual OptimizerException {};
+struct ExpressionClassesLimitException: virtual OptimizerException {};
 
 }
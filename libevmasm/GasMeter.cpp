@@ -243,12 +243,7 @@ GasMeter::GasConsumption GasMeter::memoryGas(ExpressionClasses::Id _position)
 		return GasConsumption(0);
 	u256 previous = m_largestMemoryAccess;
 	m_largestMemoryAccess = *value;
-	auto memGas = [=](u256 const& pos) -> u256
-	{
-		u256 size = (pos + 31) / 32;
-		return GasCosts::memoryGas * size + size * size / GasCosts::quadCoeffDiv;
-	};
-	return memGas(*value) - memGas(previous);
+	return memoryCost(*value) - memoryCost(previous);
 }
 
 GasMeter::GasConsumption GasMeter::memoryGas(int _stackPosOffset, int _stackPosSize)
@@ -320,3 +315,9 @@ u256 GasMeter::dataGas(uint64_t _length, bool _inCreation, langutil::EVMVersion
 	assertThrow(gas < bigint(u256(-1)), OptimizerException, "Gas cost exceeds 256 bits.");
 	return u256(gas);
 }
+
+u256 GasMeter::memoryCost(u256 const& _largestMemoryAccess)
+{
+	u256 size = (_largestMemoryAccess + 31) / 32;
+	return GasCosts::memoryGas * size + size * size / GasCosts::quadCoeffDiv;
+}
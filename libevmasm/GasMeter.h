@@ -239,6 +239,9 @@ public:
 	/// otherwise code will be stored and have to pay "createDataGas" cost.
 	static u256 dataGas(uint64_t _length, bool _inCreation, langutil::EVMVersion _evmVersion);
 
+	/// @returns the total gas costs of expanding memory so that it includes @a _largestMemoryAccess.
+	static u256 memoryCost(u256 const& _largestMemoryAccess);
+
 private:
 	/// @returns _multiplier * (_value + 31) / 32, if _value is a known constant and infinite otherwise.
 	GasConsumption wordGas(u256 const& _multiplier, ExpressionClasses::Id _value);
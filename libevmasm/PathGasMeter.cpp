@@ -24,9 +24,31 @@
 #include <libevmasm/KnownState.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <algorithm>
+#include <optional>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 
+namespace
+{
+
+/// Upper bound on the number of times a block is summarized for different sets of tags on the
+/// stack at its entry or with reduced knowledge, on average. Exceeding it results in infinite gas.
+size_t constexpr maxSummariesPerBlock = 64;
+
+std::set<u256> tagsOnStack(KnownState& _state)
+{
+	std::set<u256> tags;
+	for (auto const& [height, id]: _state.stackElements())
+		if (height <= _state.stackHeight())
+			for (u256 const& tag: _state.tagsInExpression(id))
+				tags.insert(tag);
+	return tags;
+}
+
+}
+
 PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
 	m_items(_items), m_evmVersion(_evmVersion)
 {
@@ -40,67 +62,102 @@ GasMeter::GasConsumption PathGasMeter::estimateMax(
 	std::shared_ptr<KnownState> const& _state
 )
 {
+	m_queue.clear();
+	m_blockIDs.clear();
+	m_blocks.clear();
+	m_summaries = 0;
+
+	assertThrow(
+		_startIndex < m_items.size() && (_startIndex == 0 || m_items.at(_startIndex).type() == Tag),
+		OptimizerException,
+		"Gas estimation has to start at the beginning of the code or at a tag."
+	);
+
 	auto path = std::make_unique<GasPath>();
 	path->index = _startIndex;
 	path->state = _state->copy();
-	queue(std::move(path));
-
-	GasMeter::GasConsumption gas;
-	while (!m_queue.empty() && !gas.isInfinite)
-		gas = std::max(gas, handleQueueItem());
-	return gas;
-}
+	m_queue.emplace(_startIndex, std::move(path));
 
-void PathGasMeter::queue(std::unique_ptr<GasPath>&& _newPath)
-{
-	if (
-		m_highestGasUsagePerJumpdest.count(_newPath->index) &&
-		_newPath->gas < m_highestGasUsagePerJumpdest.at(_newPath->index)
-	)
-		return;
-	m_highestGasUsagePerJumpdest[_newPath->index] = _newPath->gas;
-	m_queue[_newPath->index] = std::move(_newPath);
+	while (!m_queue.empty())
+		if (!summarizeQueueItem())
+			return GasMeter::GasConsumption::infinite();
+	// The block of the start path is summarized first.
+	return longestPath(0);
 }
 
-GasMeter::GasConsumption PathGasMeter::handleQueueItem()
+bool PathGasMeter::summarizeQueueItem()
 {
 	assertThrow(!m_queue.empty(), OptimizerException, "");
 
-	std::unique_ptr<GasPath> path = std::move(m_queue.rbegin()->second);
-	m_queue.erase(--m_queue.end());
+	std::unique_ptr<GasPath> path = std::move(std::prev(m_queue.end())->second);
+	m_queue.erase(std::prev(m_queue.end()));
+
+	auto [blockID, inserted] = m_blockIDs.try_emplace(
+		BlockKey{path->index, tagsOnStack(*path->state)},
+		m_blocks.size()
+	);
+	size_t const id = blockID->second;
+	if (inserted)
+		m_blocks.emplace_back();
+	BlockSummary& block = m_blocks[id];
+	if (path->predecessor)
+	{
+		std::vector<size_t>& successors = m_blocks[*path->predecessor].successors;
+		if (std::find(successors.begin(), successors.end(), id) == successors.end())
+			successors.push_back(id);
+	}
+
+	if (inserted)
+		block.entryState = path->state->copy();
+	else
+	{
+		// The block is summarized again with the knowledge that is common to all paths reaching it,
+		// so that the summary also covers this path. The paths leaving the block are explored again
+		// with the reduced knowledge. Nothing has to be done if no knowledge is lost.
+		std::shared_ptr<KnownState> commonState = block.entryState->copy();
+		commonState->reduceToCommonKnowledge(*path->state, true);
+		if (*commonState == *block.entryState)
+			return true;
+		block.entryState = commonState;
+		path->state = commonState->copy();
+	}
+	if (++m_summaries > maxSummariesPerBlock * (m_tagPositions.size() + 1))
+		return false;
 
+	size_t index = path->index;
 	std::shared_ptr<KnownState> state = path->state;
-	GasMeter meter(state, m_evmVersion, path->largestMemoryAccess);
+	// Memory expansion costs depend on the memory accessed before the block and are
+	// accounted for in longestPath().
+	GasMeter meter(state, m_evmVersion);
 	ExpressionClasses& classes = state->expressionClasses();
-	GasMeter::GasConsumption gas = path->gas;
-	size_t index = path->index;
+	GasMeter::GasConsumption gas;
+	std::vector<std::unique_ptr<GasPath>> continuations;
 
-	if (index >= m_items.size() || (index > 0 && m_items.at(index).type() != Tag))
-		// Invalid jump usually provokes an out-of-gas exception, but we want to give an upper
-		// bound on the gas that is needed without changing the behaviour, so it is fine to
-		// return the current gas value.
-		return gas;
+	auto const continueAt = [&](size_t _index) {
+		auto newPath = std::make_unique<GasPath>();
+		newPath->index = _index;
+		newPath->state = state->copy();
+		continuations.emplace_back(std::move(newPath));
+	};
 
 	std::set<u256> jumpTags;
-	for (; index < m_items.size() && !gas.isInfinite; ++index)
+	for (; index < m_items.size(); ++index)
 	{
 		bool branchStops = false;
+		bool branches = false;
 		jumpTags.clear();
 		AssemblyItem const& item = m_items.at(index);
-		if (item.type() == Tag || item == AssemblyItem(Instruction::JUMPDEST))
+		if (item.type() == Tag && index > path->index)
 		{
-			// Do not allow any backwards jump. This is quite restrictive but should work for
-			// the simplest things.
-			if (path->visitedJumpdests.count(index))
-				return GasMeter::GasConsumption::infinite();
-			path->visitedJumpdests.insert(index);
+			continueAt(index);
+			break;
 		}
 		else if (item == AssemblyItem(Instruction::JUMP))
 		{
 			branchStops = true;
 			jumpTags = state->tagsInExpression(state->relativeStackElement(0));
 			if (jumpTags.empty()) // unknown jump destination
-				return GasMeter::GasConsumption::infinite();
+				return false;
 		}
 		else if (item == AssemblyItem(Instruction::JUMPI))
 		{
@@ -109,31 +166,111 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 			{
 				jumpTags = state->tagsInExpression(state->relativeStackElement(0));
 				if (jumpTags.empty()) // unknown jump destination
-					return GasMeter::GasConsumption::infinite();
+					return false;
 			}
 			branchStops = classes.knownNonZero(condition);
+			branches = !branchStops;
 		}
 		else if (SemanticInformation::altersControlFlow(item))
 			branchStops = true;
 
 		gas += meter.estimateMax(item);
+		if (gas.isInfinite)
+			return false;
 
 		for (u256 const& tag: jumpTags)
-		{
-			auto newPath = std::make_unique<GasPath>();
-			newPath->index = m_items.size();
+			// Invalid jump usually provokes an out-of-gas exception, but we want to give an upper
+			// bound on the gas that is needed without changing the behaviour, so it is fine to
+			// end the path here.
 			if (m_tagPositions.count(tag))
-				newPath->index = m_tagPositions.at(tag);
-			newPath->gas = gas;
-			newPath->largestMemoryAccess = meter.largestMemoryAccess();
-			newPath->state = state->copy();
-			newPath->visitedJumpdests = path->visitedJumpdests;
-			queue(std::move(newPath));
-		}
+				continueAt(m_tagPositions.at(tag));
 
-		if (branchStops)
+		if (branches)
+			// The code after a conditional jump is a separate block, so that the gas of the
+			// code after it is not attributed to the jump.
+			continueAt(index + 1);
+		if (branchStops || branches)
 			break;
 	}
 
-	return gas;
+	// The memory expansion costs computed by the meter are relative to unused memory.
+	u256 const largestMemoryAccess = meter.largestMemoryAccess();
+	block.gas = std::max(block.gas, GasMeter::GasConsumption(gas.value - GasMeter::memoryCost(largestMemoryAccess)));
+	block.largestMemoryAccess = std::max(block.largestMemoryAccess, largestMemoryAccess);
+
+	for (auto& continuation: continuations)
+	{
+		continuation->predecessor = id;
+		size_t const continuationIndex = continuation->index;
+		m_queue.emplace(continuationIndex, std::move(continuation));
+	}
+	return true;
+}
+
+GasMeter::GasConsumption PathGasMeter::longestPath(size_t _start) const
+{
+	// Depth-first search for a topological order of the blocks, which fails on cycles.
+	enum class Visit { None, Active, Done };
+	std::vector<Visit> visits(m_blocks.size(), Visit::None);
+	std::vector<size_t> postOrder;
+	std::vector<std::pair<size_t, size_t>> stack{{_start, 0}};
+	visits[_start] = Visit::Active;
+	while (!stack.empty())
+	{
+		auto& [id, successorIndex] = stack.back();
+		if (successorIndex == m_blocks[id].successors.size())
+		{
+			visits[id] = Visit::Done;
+			postOrder.push_back(id);
+			stack.pop_back();
+			continue;
+		}
+		size_t const successor = m_blocks[id].successors[successorIndex++];
+		if (visits[successor] == Visit::Active)
+			return GasMeter::GasConsumption::infinite();
+		if (visits[successor] == Visit::None)
+		{
+			visits[successor] = Visit::Active;
+			stack.emplace_back(successor, 0);
+		}
+	}
+
+	std::reverse(postOrder.begin(), postOrder.end());
+
+	// The gas excluding memory expansion and the largest memory access are maximized separately
+	// over all paths reaching a block. Since the memory expansion costs only grow with the
+	// largest memory access, the sum is an upper bound for every single path, even though
+	// the two maxima might stem from different paths.
+	struct Entry
+	{
+		GasMeter::GasConsumption gas;
+		u256 largestMemoryAccess;
+	};
+	std::vector<std::optional<Entry>> entries(m_blocks.size());
+	entries[_start] = Entry{};
+	GasMeter::GasConsumption maxGas;
+	for (size_t id: postOrder)
+	{
+		if (!entries[id])
+			continue;
+		BlockSummary const& block = m_blocks[id];
+		Entry exit = *entries[id];
+		exit.gas += block.gas;
+		exit.largestMemoryAccess = std::max(exit.largestMemoryAccess, block.largestMemoryAccess);
+		GasMeter::GasConsumption total = exit.gas + GasMeter::memoryCost(exit.largestMemoryAccess);
+		if (total.isInfinite)
+			return total;
+		maxGas = std::max(maxGas, total);
+
+		for (size_t successor: block.successors)
+			if (!entries[successor])
+				entries[successor] = exit;
+			else
+			{
+				Entry& entry = *entries[successor];
+				entry.gas = std::max(entry.gas, exit.gas);
+				entry.largestMemoryAccess = std::max(entry.largestMemoryAccess, exit.largestMemoryAccess);
+			}
+	}
+	return maxGas;
 }
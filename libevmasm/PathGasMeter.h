@@ -26,7 +26,10 @@
 
 #include <liblangutil/EVMVersion.h>
 
+#include <map>
+#include <optional>
 #include <set>
+#include <utility>
 #include <vector>
 #include <memory>
 
@@ -39,21 +42,31 @@ struct GasPath
 {
 	size_t index = 0;
 	std::shared_ptr<KnownState> state;
-	u256 largestMemoryAccess;
-	GasMeter::GasConsumption gas;
-	std::set<size_t> visitedJumpdests;
+	/// ID of the block the path comes from, if any.
+	std::optional<size_t> predecessor;
 };
 
 /**
  * Computes an upper bound on the gas usage of a computation starting at a certain position in
  * a list of AssemblyItems in a given state until the computation stops.
  * Can be used to estimate the gas usage of functions on any given input.
+ *
+ * The items are split into blocks that start at a tag and end at the next tag or at an
+ * instruction that stops the control flow. Each block is summarized per set of tags on the stack
+ * at its entry (which distinguishes the call sites of internal functions), which yields a graph
+ * of block summaries. A block reached by paths with different knowledge about the state is
+ * summarized again with the knowledge common to all of them, so that its summary covers every
+ * path. The result is the longest path through that graph, where
+ * the gas excluding memory expansion and the largest memory access are maximized separately,
+ * which keeps the result an upper bound.
+ * Any cycle in the graph (i.e. a loop or recursion) results in infinite gas.
  */
 class PathGasMeter
 {
 public:
 	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
 
+	/// @a _startIndex has to be zero or the index of a tag.
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
 	static GasMeter::GasConsumption estimateMax(
@@ -67,17 +80,36 @@ public:
 	}
 
 private:
-	/// Adds a new path item to the queue, but only if we do not already have
-	/// a higher gas usage at that point.
-	/// This is not exact as different state might influence higher gas costs at a later
-	/// point in time, but it greatly reduces computational overhead.
-	void queue(std::unique_ptr<GasPath>&& _newPath);
-	GasMeter::GasConsumption handleQueueItem();
-
-	/// Map of jumpdest -> gas path, so not really a queue. We only have one queued up
-	/// item per jumpdest, because of the behaviour of `queue` above.
-	std::map<size_t, std::unique_ptr<GasPath>> m_queue;
-	std::map<size_t, GasMeter::GasConsumption> m_highestGasUsagePerJumpdest;
+	/// Start index of a block and set of tags on the stack at its entry.
+	using BlockKey = std::pair<size_t, std::set<u256>>;
+
+	struct BlockSummary
+	{
+		/// Gas used by the block, excluding the costs of memory expansion.
+		GasMeter::GasConsumption gas;
+		/// Largest memory position accessed inside the block.
+		u256 largestMemoryAccess;
+		/// IDs of the blocks the control flow can continue at.
+		std::vector<size_t> successors;
+		/// Knowledge common to all paths that reached the block so far.
+		std::shared_ptr<KnownState> entryState;
+	};
+
+	/// Runs the queued path that starts at the highest index through its block and queues the
+	/// paths leaving the block. If the block was summarized before, it is only run again if the
+	/// path reduces the knowledge at its entry, and then with the reduced knowledge.
+	/// @returns false if the gas usage is unbounded.
+	bool summarizeQueueItem();
+	/// @returns the highest gas usage along any path through the summarized blocks starting
+	/// at block @a _start.
+	GasMeter::GasConsumption longestPath(size_t _start) const;
+
+	/// Map of start index -> paths that reach the block starting there.
+	std::multimap<size_t, std::unique_ptr<GasPath>> m_queue;
+	std::map<BlockKey, size_t> m_blockIDs;
+	std::vector<BlockSummary> m_blocks;
+	/// Number of times a block was summarized.
+	size_t m_summaries = 0;
 	std::map<u256, size_t> m_tagPositions;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
@@ -33,6 +33,10 @@ using namespace solidity::evmasm;
 namespace
 {
 
+/// Largest number of items any method looks at to decide whether it applies.
+/// Changes can only enable or disable methods at positions at most this far before them.
+constexpr size_t maxWindowSize = 8;
+
 struct OptimiserState
 {
 	AssemblyItems const& items;
@@ -64,6 +68,7 @@ struct SimplePeepholeOptimizerMethod
 	static bool apply(OptimiserState& _state)
 	{
 		static constexpr size_t WindowSize = FunctionParameterCount<decltype(Method::applySimple)>::value - 1;
+		static_assert(WindowSize <= maxWindowSize);
 		if (
 			_state.i + WindowSize <= _state.items.size() &&
 			applyRule(_state.items.begin() + static_cast<ptrdiff_t>(_state.i), _state.out, std::make_index_sequence<WindowSize>{})
@@ -77,18 +82,6 @@ struct SimplePeepholeOptimizerMethod
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity>
-{
-	static bool applySimple(
-		AssemblyItem const& _item,
-		std::back_insert_iterator<AssemblyItems> _out
-	)
-	{
-		*_out = _item;
-		return true;
-	}
-};
-
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 {
 	static bool applySimple(
@@ -566,6 +559,7 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	/// Only depends on the first two items whether this applies, the rest is removed anyway.
 	static bool apply(OptimiserState& _state)
 	{
 		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
@@ -690,74 +684,157 @@ struct DeduplicateNextTagSize1 : SimplePeepholeOptimizerMethod<DeduplicateNextTa
 	}
 };
 
-void applyMethods(OptimiserState&)
+bool applyMethods(OptimiserState&)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	return false;
 }
 
 template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+bool applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return Method::apply(_state) || applyMethods(_state, _other...);
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+/// Change of the item count, the approximate code size and the number of POPs caused by rewrites.
+struct Improvement
 {
-	return static_cast<size_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
-}
+	ptrdiff_t items = 0;
+	ptrdiff_t bytes = 0;
+	ptrdiff_t pops = 0;
+
+	void add(AssemblyItems::const_iterator _begin, AssemblyItems::const_iterator _end, ptrdiff_t _sign, langutil::EVMVersion _evmVersion)
+	{
+		// Avoid referencing immutables too early by using approx. counting in bytesRequired()
+		for (auto it = _begin; it != _end; ++it)
+		{
+			items += _sign;
+			bytes += _sign * static_cast<ptrdiff_t>(it->bytesRequired(3, _evmVersion, Precision::Approximate));
+			if (*it == Instruction::POP)
+				pops += _sign;
+		}
+	}
+
+	bool worthApplying() const
+	{
+		return items < 0 || (items == 0 && (bytes < 0 || pops > 0));
+	}
+};
+
+/// A window of the input items that is replaced by the output of a method.
+struct Rewrite
+{
+	size_t begin;
+	size_t end;
+	AssemblyItems replacement;
+};
 
 }
 
 PeepholeOptimiser::PeepholeOptimiser(AssemblyItems& _items, langutil::EVMVersion const _evmVersion):
 	m_items(_items),
-	m_evmVersion(_evmVersion)
+	m_evmVersion(_evmVersion),
+	m_pendingRanges{{0, _items.size()}}
 {
 }
 
 bool PeepholeOptimiser::optimise()
 {
-	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
-	auto const approx = evmasm::Precision::Approximate;
-	OptimiserState state {m_items, 0, back_inserter(m_optimisedItems), m_evmVersion};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(),
-			OpPop(),
-			OpStop(),
-			OpReturnRevert(),
-			DoublePush(),
-			DoubleSwap(),
-			CommutativeSwap(),
-			SwapComparison(),
-			DupSwap(),
-			IsZeroIsZeroJumpI(),
-			IsZeroIsZeroRJumpI(), // EOF specific
-			EqIsZeroJumpI(),
-			EqIsZeroRJumpI(),     // EOF specific
-			DoubleJump(),
-			DoubleRJump(),        // EOF specific
-			JumpToNext(),
-			RJumpToNext(),        // EOF specific
-			UnreachableCode(),
-			DeduplicateNextTagSize3(),
-			DeduplicateNextTagSize2(),
-			DeduplicateNextTagSize1(),
-			TagConjunctions(),
-			TruthyAnd(),
-			Identity()
-		);
-	if (m_optimisedItems.size() < m_items.size() || (
-		m_optimisedItems.size() == m_items.size() && (
-			evmasm::bytesRequired(m_optimisedItems, 3, m_evmVersion, approx) < evmasm::bytesRequired(m_items, 3, m_evmVersion, approx) ||
-			numberOfPops(m_optimisedItems) > numberOfPops(m_items)
-		)
-	))
+	// Only the positions close to changes of the previous pass are visited. At all other positions,
+	// no method applied last time and the items they would look at are still the same. Since the
+	// result of such a full pass would be the same, this does not change the outcome.
+	AssemblyItems replacement;
+	OptimiserState state {m_items, 0, back_inserter(replacement), m_evmVersion};
+	std::vector<Rewrite> rewrites;
+	Improvement improvement;
+	for (auto const& [begin, end]: m_pendingRanges)
+		for (state.i = std::max(state.i, begin); state.i < std::min(end, m_items.size());)
+		{
+			size_t const position = state.i;
+			if (!applyMethods(
+				state,
+				PushPop(),
+				OpPop(),
+				OpStop(),
+				OpReturnRevert(),
+				DoublePush(),
+				DoubleSwap(),
+				CommutativeSwap(),
+				SwapComparison(),
+				DupSwap(),
+				IsZeroIsZeroJumpI(),
+				IsZeroIsZeroRJumpI(), // EOF specific
+				EqIsZeroJumpI(),
+				EqIsZeroRJumpI(),     // EOF specific
+				DoubleJump(),
+				DoubleRJump(),        // EOF specific
+				JumpToNext(),
+				RJumpToNext(),        // EOF specific
+				UnreachableCode(),
+				DeduplicateNextTagSize3(),
+				DeduplicateNextTagSize2(),
+				DeduplicateNextTagSize1(),
+				TagConjunctions(),
+				TruthyAnd()
+			))
+			{
+				state.i++;
+				continue;
+			}
+			assertThrow(state.i > position, OptimizerException, "Peephole optimizer method did not consume any items.");
+			auto const items = m_items.cbegin();
+			improvement.add(items + static_cast<ptrdiff_t>(position), items + static_cast<ptrdiff_t>(state.i), -1, m_evmVersion);
+			improvement.add(replacement.cbegin(), replacement.cend(), 1, m_evmVersion);
+			rewrites.emplace_back(Rewrite{position, state.i, std::move(replacement)});
+			replacement.clear();
+		}
+
+	if (rewrites.empty() || !improvement.worthApplying())
+		return false;
+
+	// Splice the replacements into the items. This can be done in place unless a replacement
+	// would overwrite items that have not been moved yet.
+	bool inPlace = true;
+	ptrdiff_t growth = 0;
+	for (Rewrite const& rewrite: rewrites)
 	{
-		m_items = std::move(m_optimisedItems);
-		return true;
+		growth += static_cast<ptrdiff_t>(rewrite.replacement.size()) - static_cast<ptrdiff_t>(rewrite.end - rewrite.begin);
+		inPlace = inPlace && growth <= 0;
 	}
+	AssemblyItems copy;
+	if (!inPlace)
+		copy.reserve(static_cast<size_t>(static_cast<ptrdiff_t>(m_items.size()) + growth));
+	size_t written = 0;
+	auto emit = [&](AssemblyItem&& _item) {
+		if (!inPlace)
+			copy.emplace_back(std::move(_item));
+		else if (&m_items[written] != &_item)
+			m_items[written] = std::move(_item);
+		written++;
+	};
+
+	std::vector<std::pair<size_t, size_t>> pendingRanges;
+	size_t read = 0;
+	for (Rewrite& rewrite: rewrites)
+	{
+		for (; read < rewrite.begin; read++)
+			emit(std::move(m_items[read]));
+		read = rewrite.end;
+		// Methods at positions up to maxWindowSize - 1 before the change can see it.
+		size_t const rangeBegin = written >= maxWindowSize - 1 ? written - (maxWindowSize - 1) : 0;
+		for (AssemblyItem& item: rewrite.replacement)
+			emit(std::move(item));
+		if (!pendingRanges.empty() && pendingRanges.back().second >= rangeBegin)
+			pendingRanges.back().second = written;
+		else
+			pendingRanges.emplace_back(rangeBegin, written);
+	}
+	for (; read < m_items.size(); read++)
+		emit(std::move(m_items[read]));
+
+	if (inPlace)
+		m_items.erase(m_items.begin() + static_cast<ptrdiff_t>(written), m_items.end());
 	else
-		return false;
+		m_items = std::move(copy);
+	m_pendingRanges = std::move(pendingRanges);
+	return true;
 }
@@ -24,6 +24,7 @@
 #include <vector>
 #include <cstddef>
 #include <iterator>
+#include <utility>
 
 #include <liblangutil/EVMVersion.h>
 
@@ -46,12 +47,18 @@ public:
 	explicit PeepholeOptimiser(AssemblyItems& _items, langutil::EVMVersion _evmVersion);
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Performs one pass over the items, applying the first matching method at each position
+	/// and continuing after the replaced items.
+	/// Later passes only revisit the positions around the changes made by the previous one,
+	/// which requires that the items are not modified by anything else in between.
+	/// @returns false and leaves the items unchanged if the pass does not improve the code.
 	bool optimise();
 
 private:
 	AssemblyItems& m_items;
-	AssemblyItems m_optimisedItems;
 	langutil::EVMVersion const m_evmVersion;
+	/// Sorted, disjoint ranges of positions that have to be visited by the next pass.
+	std::vector<std::pair<size_t, size_t>> m_pendingRanges;
 };
 
 }
@@ -0,0 +1,227 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Index over simplification rules used to avoid matching rules that cannot apply.
+ */
+
+#pragma once
+
+#include <libevmasm/Exceptions.h>
+#include <libevmasm/Instruction.h>
+#include <libevmasm/SimplificationRule.h>
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/Numeric.h>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace solidity::evmasm
+{
+
+/// What a pattern requires from an argument of the matched operation, disregarding anything
+/// nested deeper and all match groups.
+struct PatternSummary
+{
+	enum class Kind { Any, Constant, Operation };
+	Kind kind = Kind::Any;
+	/// Only valid if kind is Operation.
+	Instruction instruction = Instruction::STOP;
+	/// Only valid if kind is Constant, nullopt if any constant matches.
+	std::optional<u256> value;
+};
+
+/// The properties of an argument of the matched operation that can be checked against a
+/// PatternSummary, i.e. whether it is a constant (and its value) or an operation (and which one).
+struct ExpressionSummary
+{
+	enum class Kind { Other, Constant, Operation };
+	Kind kind = Kind::Other;
+	/// Only valid if kind is Operation.
+	Instruction instruction = Instruction::STOP;
+	/// Only valid if kind is Constant.
+	u256 const* value = nullptr;
+};
+
+/**
+ * Simplification rules grouped by the instruction at the root of their pattern, together with
+ * an index over the arguments of that instruction.
+ *
+ * For every argument position, the index stores the set of rules (as a bit set over the rules of
+ * the instruction) that are compatible with a constant of a certain value, with any constant,
+ * with a certain operation or with anything. Intersecting these sets for the arguments of an
+ * expression results in the rules that might match it, in their original order, which are
+ * then matched as usual. Since only the first matching rule is of interest, the rule order
+ * has to be preserved and the index only serves to skip rules.
+ *
+ * @a Pattern has to provide instruction(), arguments() and a summary() function returning
+ * a PatternSummary.
+ */
+template <class Pattern>
+class SimplificationRuleIndex
+{
+public:
+	using Rule = SimplificationRule<Pattern>;
+
+	/// Adds a rule after all rules with the same root instruction.
+	/// Pointers to rules returned by findFirst are only valid as long as no rules are added.
+	void addRule(Rule const& _rule)
+	{
+		Bucket& bucket = m_buckets[static_cast<uint8_t>(_rule.pattern.instruction())];
+		std::vector<Pattern> const arguments = _rule.pattern.arguments();
+		if (bucket.rules.empty())
+		{
+			assertThrow(arguments.size() <= maxArguments, OptimizerException, "Too many arguments for rule index.");
+			bucket.arguments.resize(arguments.size());
+		}
+		assertThrow(arguments.size() == bucket.arguments.size(), OptimizerException, "Rules with different arity.");
+
+		size_t const ruleIndex = bucket.rules.size();
+		bucket.rules.push_back(_rule);
+		for (size_t i = 0; i < arguments.size(); ++i)
+		{
+			PatternSummary const summary = arguments[i].summary();
+			ArgumentIndex& argumentIndex = bucket.arguments[i];
+			switch (summary.kind)
+			{
+			case PatternSummary::Kind::Any:
+				set(argumentIndex.any, ruleIndex);
+				set(argumentIndex.anyOrAnyConstant, ruleIndex);
+				break;
+			case PatternSummary::Kind::Constant:
+				if (summary.value)
+					set(argumentIndex.constants[*summary.value], ruleIndex);
+				else
+					set(argumentIndex.anyOrAnyConstant, ruleIndex);
+				break;
+			case PatternSummary::Kind::Operation:
+				set(argumentIndex.operations[summary.instruction], ruleIndex);
+				break;
+			}
+		}
+	}
+
+	bool hasRules(Instruction _instruction) const
+	{
+		return !m_buckets[static_cast<uint8_t>(_instruction)].rules.empty();
+	}
+
+	/// Tries the rules for @a _instruction that are compatible with the arguments of the expression
+	/// to simplify in order, until one of them is accepted.
+	/// @param _summarizeArgument called with the position of each argument, has to return its
+	/// summary or nullopt if no rule can match the expression at all.
+	/// @param _match called with the candidate rules, has to return true if the rule matches.
+	/// @returns the first rule accepted by @a _match or nullptr.
+	template <class SummarizeArgument, class Match>
+	Rule const* findFirst(Instruction _instruction, SummarizeArgument&& _summarizeArgument, Match&& _match) const
+	{
+		Bucket const& bucket = m_buckets[static_cast<uint8_t>(_instruction)];
+		if (bucket.rules.empty())
+			return nullptr;
+
+		// For every argument, the union of the two sets is the set of compatible rules.
+		std::array<std::pair<Bitset const*, Bitset const*>, maxArguments> compatibleRules;
+		for (size_t i = 0; i < bucket.arguments.size(); ++i)
+		{
+			std::optional<ExpressionSummary> const summary = _summarizeArgument(i);
+			if (!summary)
+				return nullptr;
+			ArgumentIndex const& argumentIndex = bucket.arguments[i];
+			switch (summary->kind)
+			{
+			case ExpressionSummary::Kind::Other:
+				compatibleRules[i] = {&argumentIndex.any, nullptr};
+				break;
+			case ExpressionSummary::Kind::Constant:
+				compatibleRules[i] = {&argumentIndex.anyOrAnyConstant, find(argumentIndex.constants, *summary->value)};
+				break;
+			case ExpressionSummary::Kind::Operation:
+				compatibleRules[i] = {&argumentIndex.any, find(argumentIndex.operations, summary->instruction)};
+				break;
+			}
+		}
+
+		size_t const numWords = (bucket.rules.size() + 63) / 64;
+		for (size_t word = 0; word < numWords; ++word)
+		{
+			uint64_t candidates = ~uint64_t(0);
+			for (size_t i = 0; i < bucket.arguments.size(); ++i)
+				candidates &= wordOf(compatibleRules[i].first, word) | wordOf(compatibleRules[i].second, word);
+			while (candidates)
+			{
+				size_t const bit = static_cast<size_t>(std::countr_zero(candidates));
+				candidates &= candidates - 1;
+				Rule const& rule = bucket.rules[word * 64 + bit];
+				if (_match(rule))
+					return &rule;
+			}
+		}
+		return nullptr;
+	}
+
+private:
+	/// Operations in the rule list have at most three arguments.
+	static constexpr size_t maxArguments = 4;
+
+	using Bitset = std::vector<uint64_t>;
+
+	struct ArgumentIndex
+	{
+		/// Rules accepting anything at this position.
+		Bitset any;
+		/// Rules accepting anything or any constant at this position.
+		Bitset anyOrAnyConstant;
+		/// Rules requiring a specific constant at this position.
+		std::map<u256, Bitset> constants;
+		/// Rules requiring a specific operation at this position.
+		std::map<Instruction, Bitset> operations;
+	};
+
+	struct Bucket
+	{
+		std::vector<Rule> rules;
+		std::vector<ArgumentIndex> arguments;
+	};
+
+	static void set(Bitset& _bitset, size_t _index)
+	{
+		if (_bitset.size() <= _index / 64)
+			_bitset.resize(_index / 64 + 1, 0);
+		_bitset[_index / 64] |= uint64_t(1) << (_index % 64);
+	}
+
+	static uint64_t wordOf(Bitset const* _bitset, size_t _word)
+	{
+		return _bitset && _word < _bitset->size() ? (*_bitset)[_word] : 0;
+	}
+
+	template <class Key>
+	static Bitset const* find(std::map<Key, Bitset> const& _map, Key const& _key)
+	{
+		auto it = _map.find(_key);
+		return it == _map.end() ? nullptr : &it->second;
+	}
+
+	std::array<Bucket, 256> m_buckets;
+};
+
+}
@@ -41,23 +41,28 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	ExpressionClasses const& _classes
 )
 {
-	resetMatchGroups();
-
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
-	{
-		if (rule.pattern.matches(_expr, _classes))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
-
-		resetMatchGroups();
-	}
-	return nullptr;
+	return m_rules.findFirst(
+		_expr.item->instruction(),
+		[&](size_t _argument) -> std::optional<ExpressionSummary> {
+			AssemblyItem const* item = _classes.representative(_expr.arguments.at(_argument)).item;
+			if (item && item->type() == Push)
+				return ExpressionSummary{ExpressionSummary::Kind::Constant, Instruction::STOP, &item->data()};
+			else if (item && item->type() == Operation)
+				return ExpressionSummary{ExpressionSummary::Kind::Operation, item->instruction(), nullptr};
+			else
+				return ExpressionSummary{};
+		},
+		[&](SimplificationRule<Pattern> const& _rule) {
+			resetMatchGroups();
+			return _rule.pattern.matches(_expr, _classes) && (!_rule.feasible || _rule.feasible());
+		}
+	);
 }
 
 bool Rules::isInitialized() const
 {
-	return !m_rules[uint8_t(Instruction::ADD)].empty();
+	return m_rules.hasRules(Instruction::ADD);
 }
 
 void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
@@ -68,7 +73,7 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_rules.addRule(_rule);
 }
 
 Rules::Rules()
@@ -126,6 +131,21 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 	return true;
 }
 
+PatternSummary Pattern::summary() const
+{
+	if (m_type == Operation)
+		return PatternSummary{PatternSummary::Kind::Operation, m_instruction, std::nullopt};
+	else if (m_type == Push)
+		return PatternSummary{
+			PatternSummary::Kind::Constant,
+			Instruction::STOP,
+			m_requireDataMatch ? std::make_optional(data()) : std::nullopt
+		};
+	else
+		// Other item types are not indexed, rules with such patterns are always tried.
+		return PatternSummary{};
+}
+
 AssemblyItem Pattern::toAssemblyItem(langutil::DebugData::ConstPtr _debugData) const
 {
 	if (m_type == Operation)
@@ -26,6 +26,7 @@
 
 #include <libevmasm/ExpressionClasses.h>
 #include <libevmasm/SimplificationRule.h>
+#include <libevmasm/SimplificationRuleIndex.h>
 
 #include <libsolutil/CommonData.h>
 
@@ -76,7 +77,7 @@ private:
 	std::map<unsigned, Expression const*> m_matchGroups;
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
-	std::vector<SimplificationRule<Pattern>> m_rules[256];
+	SimplificationRuleIndex<Pattern> m_rules;
 };
 
 /**
@@ -113,6 +114,8 @@ public:
 
 	AssemblyItem toAssemblyItem(langutil::DebugData::ConstPtr _debugData) const;
 	std::vector<Pattern> arguments() const { return m_arguments; }
+	/// @returns the requirements of this pattern used by SimplificationRuleIndex.
+	PatternSummary summary() const;
 
 	/// @returns the id of the matched expression if this pattern is part of a match group.
 	Id id() const { return matchGroupValue().id; }
@@ -77,6 +77,13 @@ void ErrorReporter::error(ErrorId _errorId, Error::Type _type, SourceLocation co
 	m_errorList.push_back(std::make_shared<Error>(_errorId, _type, _description, _location, _secondaryLocation));
 }
 
+void ErrorReporter::replay(ErrorList const& _errorList)
+{
+	for (std::shared_ptr<Error const> const& error: _errorList)
+		if (!checkForExcessiveErrors(error->type()))
+			m_errorList.push_back(error);
+}
+
 bool ErrorReporter::hasExcessiveErrors() const
 {
 	return m_errorCount > c_maxErrorsAllowed;
@@ -53,6 +53,11 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Reports all errors in @a _errorList, which were collected by a different reporter, e.g. one
+	/// used on a different thread. Unlike append(), they count towards the limits for the number of
+	/// errors, warnings and infos, i.e. this throws FatalError if there are too many errors.
+	void replay(ErrorList const& _errorList);
+
 	void warning(ErrorId _error, std::string const& _description);
 
 	void warning(ErrorId _error, SourceLocation const& _location, std::string const& _description);
@@ -44,7 +44,8 @@
 #include <liblangutil/Token.h>
 #include <libsolutil/StringUtils.h>
 
-#include <map>
+#include <string_view>
+#include <unordered_map>
 
 namespace solidity::langutil
 {
@@ -140,7 +141,9 @@ static Token keywordByName(std::string_view const _name)
 	// and keywords to be put inside the keywords variable.
 #define KEYWORD(name, string, precedence) {string, Token::name},
 #define TOKEN(name, string, precedence)
-	static std::map<std::string, Token, std::less<>> const keywords({TOKEN_LIST(TOKEN, KEYWORD)});
+	// Every identifier the scanner sees is looked up here, so use a hash map. The keys refer to
+	// the string literals of the token list.
+	static std::unordered_map<std::string_view, Token> const keywords({TOKEN_LIST(TOKEN, KEYWORD)});
 #undef KEYWORD
 #undef TOKEN
 	auto it = keywords.find(_name);
@@ -183,7 +186,7 @@ std::tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(std::strin
 	auto positionM = find_if(_literal.begin(), _literal.end(), util::isDigit);
 	if (positionM != _literal.end())
 	{
-		std::string baseType(_literal.begin(), positionM);
+		std::string_view baseType(_literal.data(), static_cast<size_t>(positionM - _literal.begin()));
 		auto positionX = find_if_not(positionM, _literal.end(), util::isDigit);
 		int m = parseSize(positionM, positionX);
 		Token keyword = keywordByName(baseType);
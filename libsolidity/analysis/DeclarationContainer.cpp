@@ -29,6 +29,8 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/range/conversion.hpp>
 
+#include <algorithm>
+
 using namespace solidity;
 using namespace solidity::frontend;
 
@@ -41,10 +43,13 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 		_name = &_declaration.name();
 	solAssert(!_name->empty(), "");
 	std::vector<Declaration const*> declarations;
-	if (m_declarations.count(*_name))
-		declarations += m_declarations.at(*_name);
-	if (m_invisibleDeclarations.count(*_name))
-		declarations += m_invisibleDeclarations.at(*_name);
+	if (std::optional<Symbol> symbol = m_symbols->find(*_name))
+	{
+		if (m_declarations.count(*symbol))
+			declarations += m_declarations.at(*symbol);
+		if (m_invisibleDeclarations.count(*symbol))
+			declarations += m_invisibleDeclarations.at(*symbol);
+	}
 
 	if (
 		dynamic_cast<FunctionDefinition const*>(&_declaration) ||
@@ -84,18 +89,20 @@ Declaration const* DeclarationContainer::conflictingDeclaration(
 
 void DeclarationContainer::activateVariable(ASTString const& _name)
 {
+	std::optional<Symbol> symbol = m_symbols->find(_name);
 	solAssert(
-		m_invisibleDeclarations.count(_name) && m_invisibleDeclarations.at(_name).size() == 1,
+		symbol && m_invisibleDeclarations.count(*symbol) && m_invisibleDeclarations.at(*symbol).size() == 1,
 		"Tried to activate a non-inactive variable or multiple inactive variables with the same name."
 	);
-	solAssert(m_declarations.count(_name) == 0 || m_declarations.at(_name).empty(), "");
-	m_declarations[_name].emplace_back(m_invisibleDeclarations.at(_name).front());
-	m_invisibleDeclarations.erase(_name);
+	solAssert(m_declarations.count(*symbol) == 0 || m_declarations.at(*symbol).empty(), "");
+	m_declarations[*symbol].emplace_back(m_invisibleDeclarations.at(*symbol).front());
+	m_invisibleDeclarations.erase(*symbol);
 }
 
 bool DeclarationContainer::isInvisible(ASTString const& _name) const
 {
-	return m_invisibleDeclarations.count(_name);
+	std::optional<Symbol> symbol = m_symbols->find(_name);
+	return symbol && m_invisibleDeclarations.count(*symbol);
 }
 
 bool DeclarationContainer::registerDeclaration(
@@ -111,22 +118,20 @@ bool DeclarationContainer::registerDeclaration(
 	if (_name->empty())
 		return true;
 
+	if (!_update && conflictingDeclaration(_declaration, _name))
+		return false;
+
+	Symbol const symbol = m_symbols->intern(*_name);
 	if (_update)
 	{
 		solAssert(!dynamic_cast<FunctionDefinition const*>(&_declaration), "Attempt to update function definition.");
-		m_declarations.erase(*_name);
-		m_invisibleDeclarations.erase(*_name);
-	}
-	else
-	{
-		if (conflictingDeclaration(_declaration, _name))
-			return false;
-
-		if (m_enclosingContainer && _declaration.isVisibleAsUnqualifiedName())
-			m_homonymCandidates.emplace_back(*_name, _location ? _location : &_declaration.location());
+		m_declarations.erase(symbol);
+		m_invisibleDeclarations.erase(symbol);
 	}
+	else if (m_enclosingContainer && _declaration.isVisibleAsUnqualifiedName())
+		m_homonymCandidates.emplace_back(symbol, _location ? _location : &_declaration.location());
 
-	std::vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[*_name] : m_declarations[*_name];
+	std::vector<Declaration const*>& decls = _invisible ? m_invisibleDeclarations[symbol] : m_declarations[symbol];
 	if (!util::contains(decls, &_declaration))
 		decls.push_back(&_declaration);
 	return true;
@@ -147,55 +152,79 @@ std::vector<Declaration const*> DeclarationContainer::resolveName(
 ) const
 {
 	solAssert(!_name.empty(), "Attempt to resolve empty name.");
+	// Names that were never registered in any scope cannot be resolved.
+	if (std::optional<Symbol> symbol = m_symbols->find(_name))
+		return resolveSymbol(*symbol, _settings);
+	return {};
+}
+
+std::vector<Declaration const*> DeclarationContainer::resolveSymbol(Symbol _symbol, ResolvingSettings const& _settings) const
+{
 	std::vector<Declaration const*> result;
 
-	if (m_declarations.count(_name))
+	if (auto it = m_declarations.find(_symbol); it != m_declarations.end())
 	{
 		if (_settings.onlyVisibleAsUnqualifiedNames)
-			result += m_declarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+			result += it->second | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
 		else
-			result += m_declarations.at(_name);
+			result += it->second;
 	}
 
-	if (_settings.alsoInvisible && m_invisibleDeclarations.count(_name))
-	{
-		if (_settings.onlyVisibleAsUnqualifiedNames)
-			result += m_invisibleDeclarations.at(_name) | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
-		else
-			result += m_invisibleDeclarations.at(_name);
-	}
+	if (_settings.alsoInvisible)
+		if (auto it = m_invisibleDeclarations.find(_symbol); it != m_invisibleDeclarations.end())
+		{
+			if (_settings.onlyVisibleAsUnqualifiedNames)
+				result += it->second | ranges::views::filter(&Declaration::isVisibleAsUnqualifiedName) | ranges::to_vector;
+			else
+				result += it->second;
+		}
 
 	if (result.empty() && _settings.recursive && m_enclosingContainer)
-		result = m_enclosingContainer->resolveName(_name, _settings);
+		result = m_enclosingContainer->resolveSymbol(_symbol, _settings);
 
 	return result;
 }
 
+std::vector<std::pair<ASTString const*, std::vector<Declaration const*> const*>> DeclarationContainer::declarations() const
+{
+	std::vector<std::pair<ASTString const*, std::vector<Declaration const*> const*>> declarations;
+	declarations.reserve(m_declarations.size());
+	for (auto const& [symbol, declarationsOfSymbol]: m_declarations)
+		declarations.emplace_back(&m_symbols->name(symbol), &declarationsOfSymbol);
+	std::sort(declarations.begin(), declarations.end(), [](auto const& _a, auto const& _b) { return *_a.first < *_b.first; });
+	return declarations;
+}
+
 std::vector<ASTString> DeclarationContainer::similarNames(ASTString const& _name) const
 {
+	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
+	std::vector<ASTString> similar = similarNames(m_declarations, _name, maximumEditDistance);
+	similar += similarNames(m_invisibleDeclarations, _name, maximumEditDistance);
 
+	if (m_enclosingContainer)
+		similar += m_enclosingContainer->similarNames(_name);
+
+	return similar;
+}
+
+std::vector<ASTString> DeclarationContainer::similarNames(
+	DeclarationsBySymbol const& _declarations,
+	ASTString const& _name,
+	size_t _maximumEditDistance
+) const
+{
 	// because the function below has quadratic runtime - it will not magically improve once a better algorithm is discovered ;)
 	// since 80 is the suggested line length limit, we use 80^2 as length threshold
 	static size_t const MAXIMUM_LENGTH_THRESHOLD = 80 * 80;
 
 	std::vector<ASTString> similar;
-	size_t maximumEditDistance = _name.size() > 3 ? 2 : _name.size() / 2;
-	for (auto const& declaration: m_declarations)
-	{
-		std::string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
-			similar.push_back(declarationName);
-	}
-	for (auto const& declaration: m_invisibleDeclarations)
+	for (auto const& declaration: _declarations)
 	{
-		std::string const& declarationName = declaration.first;
-		if (util::stringWithinDistance(_name, declarationName, maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
+		std::string const& declarationName = m_symbols->name(declaration.first);
+		if (util::stringWithinDistance(_name, declarationName, _maximumEditDistance, MAXIMUM_LENGTH_THRESHOLD))
 			similar.push_back(declarationName);
 	}
-
-	if (m_enclosingContainer)
-		similar += m_enclosingContainer->similarNames(_name);
-
+	std::sort(similar.begin(), similar.end());
 	return similar;
 }
 
@@ -204,12 +233,12 @@ void DeclarationContainer::populateHomonyms(std::back_insert_iterator<Homonyms>
 	for (DeclarationContainer const* innerContainer: m_innerContainers)
 		innerContainer->populateHomonyms(_it);
 
-	for (auto [name, location]: m_homonymCandidates)
+	for (auto [symbol, location]: m_homonymCandidates)
 	{
 		ResolvingSettings settings;
 		settings.recursive = true;
 		settings.alsoInvisible = true;
-		std::vector<Declaration const*> const& declarations = m_enclosingContainer->resolveName(name, std::move(settings));
+		std::vector<Declaration const*> const& declarations = m_enclosingContainer->resolveSymbol(symbol, settings);
 		if (!declarations.empty())
 			_it = make_pair(location, declarations);
 	}
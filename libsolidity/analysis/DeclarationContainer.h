@@ -23,11 +23,15 @@
 
 #pragma once
 
+#include <libsolidity/analysis/SymbolTable.h>
 #include <libsolidity/ast/ASTForward.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/SourceLocation.h>
 
+#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace solidity::frontend
 {
@@ -51,16 +55,20 @@ struct ResolvingSettings
 /**
  * Container that stores mappings between names and declarations. It also contains a link to the
  * enclosing scope.
+ *
+ * Names are stored as symbols of a symbol table shared with the enclosing containers, so
+ * resolving a name through several scopes only needs a single string lookup.
  */
 class DeclarationContainer
 {
 public:
 	using Homonyms = std::vector<std::pair<langutil::SourceLocation const*, std::vector<Declaration const*>>>;
 
-	DeclarationContainer() = default;
+	DeclarationContainer(): m_symbols(std::make_shared<SymbolTable>()) {}
 	explicit DeclarationContainer(ASTNode const* _enclosingNode, DeclarationContainer* _enclosingContainer):
 		m_enclosingNode(_enclosingNode),
-		m_enclosingContainer(_enclosingContainer)
+		m_enclosingContainer(_enclosingContainer),
+		m_symbols(_enclosingContainer ? _enclosingContainer->m_symbols : std::make_shared<SymbolTable>())
 	{
 		if (_enclosingContainer)
 			_enclosingContainer->m_innerContainers.emplace_back(this);
@@ -80,7 +88,9 @@ public:
 	std::vector<Declaration const*> resolveName(ASTString const& _name, ResolvingSettings _settings = ResolvingSettings{}) const;
 	ASTNode const* enclosingNode() const { return m_enclosingNode; }
 	DeclarationContainer const* enclosingContainer() const { return m_enclosingContainer; }
-	std::map<ASTString, std::vector<Declaration const*>> const& declarations() const { return m_declarations; }
+	/// @returns the visible declarations together with their names, ordered by name.
+	/// The result refers to the container and is invalidated by registering declarations in it.
+	std::vector<std::pair<ASTString const*, std::vector<Declaration const*> const*>> declarations() const;
 	/// @returns whether declaration is valid, and if not also returns previous declaration.
 	Declaration const* conflictingDeclaration(Declaration const& _declaration, ASTString const* _name = nullptr) const;
 
@@ -100,13 +110,25 @@ public:
 	void populateHomonyms(std::back_insert_iterator<Homonyms> _it) const;
 
 private:
+	using Symbol = SymbolTable::Symbol;
+	using DeclarationsBySymbol = std::unordered_map<Symbol, std::vector<Declaration const*>>;
+
+	std::vector<Declaration const*> resolveSymbol(Symbol _symbol, ResolvingSettings const& _settings) const;
+	/// @returns the names in @a _declarations similar to @a _name, in alphabetical order.
+	std::vector<ASTString> similarNames(
+		DeclarationsBySymbol const& _declarations,
+		ASTString const& _name,
+		size_t _maximumEditDistance
+	) const;
+
 	ASTNode const* m_enclosingNode = nullptr;
 	DeclarationContainer const* m_enclosingContainer = nullptr;
 	std::vector<DeclarationContainer const*> m_innerContainers;
-	std::map<ASTString, std::vector<Declaration const*>> m_declarations;
-	std::map<ASTString, std::vector<Declaration const*>> m_invisibleDeclarations;
+	std::shared_ptr<SymbolTable> m_symbols;
+	DeclarationsBySymbol m_declarations;
+	DeclarationsBySymbol m_invisibleDeclarations;
 	/// List of declarations (name and location) to check later for homonymity.
-	std::vector<std::pair<std::string, langutil::SourceLocation const*>> m_homonymCandidates;
+	std::vector<std::pair<Symbol, langutil::SourceLocation const*>> m_homonymCandidates;
 };
 
 }
@@ -113,14 +113,17 @@ bool NameAndTypeResolver::performImports(SourceUnit& _sourceUnit, std::map<std::
 								error = true;
 				}
 			else if (imp->name().empty())
-				for (auto const& nameAndDeclaration: scope->second->declarations())
-					for (auto const& declaration: nameAndDeclaration.second)
+				for (auto const& [name, declarations]: scope->second->declarations())
+					for (Declaration const* declaration: *declarations)
 						if (!DeclarationRegistrationHelper::registerDeclaration(
-							target, *declaration, &nameAndDeclaration.first, &imp->location(), false, m_errorReporter
+							target, *declaration, name, &imp->location(), false, m_errorReporter
 						))
 							error =  true;
 		}
-	_sourceUnit.annotation().exportedSymbols = m_scopes[&_sourceUnit]->declarations();
+	std::map<ASTString, std::vector<Declaration const*>> exportedSymbols;
+	for (auto const& [name, declarations]: m_scopes[&_sourceUnit]->declarations())
+		exportedSymbols.emplace(*name, *declarations);
+	_sourceUnit.annotation().exportedSymbols = std::move(exportedSymbols);
 	return !error;
 }
 
@@ -353,8 +356,8 @@ void NameAndTypeResolver::importInheritedScope(ContractDefinition const& _base)
 {
 	auto iterator = m_scopes.find(&_base);
 	solAssert(iterator != end(m_scopes), "");
-	for (auto const& nameAndDeclaration: iterator->second->declarations())
-		for (auto const& declaration: nameAndDeclaration.second)
+	for (auto const& [name, declarations]: iterator->second->declarations())
+		for (Declaration const* declaration: *declarations)
 			// Import if it was declared in the base, is not the constructor and is visible in derived classes
 			if (declaration->scope() == &_base && declaration->isVisibleInDerivedContracts())
 				if (!m_currentScope->registerDeclaration(*declaration, false, false))
@@ -0,0 +1,37 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/analysis/SymbolTable.h>
+
+using namespace solidity::frontend;
+
+SymbolTable::Symbol SymbolTable::intern(std::string_view _name)
+{
+	if (auto it = m_symbols.find(_name); it != m_symbols.end())
+		return it->second;
+	Symbol const symbol = m_names.size();
+	m_symbols.emplace(m_names.emplace_back(_name), symbol);
+	return symbol;
+}
+
+std::optional<SymbolTable::Symbol> SymbolTable::find(std::string_view _name) const
+{
+	if (auto it = m_symbols.find(_name); it != m_symbols.end())
+		return it->second;
+	return std::nullopt;
+}
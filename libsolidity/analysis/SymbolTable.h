@@ -0,0 +1,57 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Table of interned names.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace solidity::frontend
+{
+
+/**
+ * Assigns a distinct integer to every name, so that names can be compared and hashed cheaply
+ * once they have been looked up.
+ */
+class SymbolTable
+{
+public:
+	using Symbol = size_t;
+
+	/// @returns the symbol for @a _name, adding the name if it is not known yet.
+	Symbol intern(std::string_view _name);
+	/// @returns the symbol for @a _name or nullopt if the name is not known.
+	std::optional<Symbol> find(std::string_view _name) const;
+	/// @returns the name of a symbol returned by intern().
+	std::string const& name(Symbol _symbol) const { return m_names.at(_symbol); }
+
+private:
+	/// The names by symbol. The elements of a deque are never moved, so the keys of
+	/// m_symbols can refer to them.
+	std::deque<std::string> m_names;
+	std::unordered_map<std::string_view, Symbol> m_symbols;
+};
+
+}
@@ -128,8 +128,7 @@ private:
 
 bool ViewPureChecker::check()
 {
-	for (auto const& source: m_ast)
-		source->accept(*this);
+	m_sourceUnit.accept(*this);
 
 	return !m_errors;
 }
@@ -38,8 +38,10 @@ namespace solidity::frontend
 class ViewPureChecker: private ASTConstVisitor
 {
 public:
-	ViewPureChecker(std::vector<std::shared_ptr<ASTNode>> const& _ast, langutil::ErrorReporter& _errorReporter):
-		m_ast(_ast), m_errorReporter(_errorReporter) {}
+	/// Checks the functions of a single source unit. Modifiers defined in other source units are
+	/// only read, so several source units can be checked at the same time.
+	ViewPureChecker(SourceUnit const& _sourceUnit, langutil::ErrorReporter& _errorReporter):
+		m_sourceUnit(_sourceUnit), m_errorReporter(_errorReporter) {}
 
 	bool check();
 
@@ -80,7 +82,7 @@ private:
 	/// Determines the mutability of modifier if not already cached.
 	MutabilityAndLocation const& modifierMutability(ModifierDefinition const& _modifier);
 
-	std::vector<std::shared_ptr<ASTNode>> const& m_ast;
+	SourceUnit const& m_sourceUnit;
 	langutil::ErrorReporter& m_errorReporter;
 
 	bool m_errors = false;
@@ -330,6 +330,15 @@ ContractDefinitionAnnotation& ContractDefinition::annotation() const
 	return initAnnotation<ContractDefinitionAnnotation>();
 }
 
+void ContractDefinition::resetAnnotation()
+{
+	ASTNode::resetAnnotation();
+	for (auto& interfaceFunctionList: m_interfaceFunctionList)
+		interfaceFunctionList.reset();
+	m_interfaceEvents.reset();
+	m_definedFunctionsByName.reset();
+}
+
 ContractDefinition const* ContractDefinition::superContract(ContractDefinition const& _mostDerivedContract) const
 {
 	auto const& hierarchy = _mostDerivedContract.annotation().linearizedBaseContracts;
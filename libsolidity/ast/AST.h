@@ -79,6 +79,9 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	int64_t id() const { return int64_t(m_id); }
+	/// Adds @a _offset to the ID of this node. Only meant to be used right after parsing, to move
+	/// the IDs of sources parsed independently of each other into disjoint ranges.
+	void shiftID(int64_t _offset) { m_id = static_cast<size_t>(id() + _offset); }
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
 	virtual void accept(ASTConstVisitor& _visitor) const = 0;
@@ -116,6 +119,9 @@ public:
 
 	///@todo make this const-safe by providing a different way to access the annotation
 	virtual ASTAnnotation& annotation() const;
+	/// Discards the annotation and any other information attached to the node after parsing,
+	/// so that the node can be analyzed again by another compilation.
+	virtual void resetAnnotation() { m_annotation.reset(); }
 
 	///@{
 	///@name equality operators
@@ -127,7 +133,7 @@ public:
 	virtual bool experimentalSolidityOnly() const { return false; }
 
 protected:
-	size_t const m_id = 0;
+	size_t m_id = 0;
 
 	template <class T>
 	T& initAnnotation() const
@@ -581,6 +587,7 @@ public:
 	Type const* type() const override;
 
 	ContractDefinitionAnnotation& annotation() const override;
+	void resetAnnotation() override;
 
 	ContractKind contractKind() const { return m_contractKind; }
 
@@ -25,134 +25,76 @@ using namespace solidity;
 using namespace solidity::frontend;
 using namespace solidity::util;
 
-BoolType const TypeProvider::m_boolean{};
-InaccessibleDynamicType const TypeProvider::m_inaccessibleDynamic{};
-
-/// The string and bytes unique_ptrs are initialized when they are first used because
-/// they rely on `byte` being available which we cannot guarantee in the static init context.
-std::unique_ptr<ArrayType> TypeProvider::m_bytesStorage;
-std::unique_ptr<ArrayType> TypeProvider::m_bytesMemory;
-std::unique_ptr<ArrayType> TypeProvider::m_bytesCalldata;
-std::unique_ptr<ArrayType> TypeProvider::m_stringStorage;
-std::unique_ptr<ArrayType> TypeProvider::m_stringMemory;
-
-TupleType const TypeProvider::m_emptyTuple{};
-AddressType const TypeProvider::m_payableAddress{StateMutability::Payable};
-AddressType const TypeProvider::m_address{StateMutability::NonPayable};
-
-std::array<std::unique_ptr<IntegerType>, 32> const TypeProvider::m_intM{{
-	{std::make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Signed)},
-	{std::make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Signed)}
-}};
-
-std::array<std::unique_ptr<IntegerType>, 32> const TypeProvider::m_uintM{{
-	{std::make_unique<IntegerType>(8 * 1, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 2, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 3, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 4, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 5, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 6, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 7, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 8, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 9, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 10, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 11, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 12, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 13, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 14, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 15, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 16, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 17, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 18, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 19, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 20, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 21, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 22, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 23, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 24, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 25, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 26, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 27, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 28, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 29, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 30, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 31, IntegerType::Modifier::Unsigned)},
-	{std::make_unique<IntegerType>(8 * 32, IntegerType::Modifier::Unsigned)}
-}};
-
-std::array<std::unique_ptr<FixedBytesType>, 32> const TypeProvider::m_bytesM{{
-	{std::make_unique<FixedBytesType>(1)},
-	{std::make_unique<FixedBytesType>(2)},
-	{std::make_unique<FixedBytesType>(3)},
-	{std::make_unique<FixedBytesType>(4)},
-	{std::make_unique<FixedBytesType>(5)},
-	{std::make_unique<FixedBytesType>(6)},
-	{std::make_unique<FixedBytesType>(7)},
-	{std::make_unique<FixedBytesType>(8)},
-	{std::make_unique<FixedBytesType>(9)},
-	{std::make_unique<FixedBytesType>(10)},
-	{std::make_unique<FixedBytesType>(11)},
-	{std::make_unique<FixedBytesType>(12)},
-	{std::make_unique<FixedBytesType>(13)},
-	{std::make_unique<FixedBytesType>(14)},
-	{std::make_unique<FixedBytesType>(15)},
-	{std::make_unique<FixedBytesType>(16)},
-	{std::make_unique<FixedBytesType>(17)},
-	{std::make_unique<FixedBytesType>(18)},
-	{std::make_unique<FixedBytesType>(19)},
-	{std::make_unique<FixedBytesType>(20)},
-	{std::make_unique<FixedBytesType>(21)},
-	{std::make_unique<FixedBytesType>(22)},
-	{std::make_unique<FixedBytesType>(23)},
-	{std::make_unique<FixedBytesType>(24)},
-	{std::make_unique<FixedBytesType>(25)},
-	{std::make_unique<FixedBytesType>(26)},
-	{std::make_unique<FixedBytesType>(27)},
-	{std::make_unique<FixedBytesType>(28)},
-	{std::make_unique<FixedBytesType>(29)},
-	{std::make_unique<FixedBytesType>(30)},
-	{std::make_unique<FixedBytesType>(31)},
-	{std::make_unique<FixedBytesType>(32)}
-}};
-
-std::array<std::unique_ptr<MagicType>, 5> const TypeProvider::m_magics{{
-	{std::make_unique<MagicType>(MagicType::Kind::Block)},
-	{std::make_unique<MagicType>(MagicType::Kind::Message)},
-	{std::make_unique<MagicType>(MagicType::Kind::Transaction)},
-	{std::make_unique<MagicType>(MagicType::Kind::ABI)},
-	{std::make_unique<MagicType>(MagicType::Kind::Error)}
-	// MetaType is stored separately
-}};
+namespace
+{
+
+/// TypeProvider activated on the current thread by the innermost TypeProvider::ScopedInstance.
+thread_local TypeProvider* activeTypeProvider = nullptr;
+
+TypeProvider& defaultTypeProvider()
+{
+	thread_local TypeProvider defaultProvider;
+	return defaultProvider;
+}
+
+}
+
+TypeProvider::TypeProvider()
+{
+	for (unsigned i = 0; i < 32; ++i)
+	{
+		m_intM[i] = std::make_unique<IntegerType>(8 * (i + 1), IntegerType::Modifier::Signed);
+		m_uintM[i] = std::make_unique<IntegerType>(8 * (i + 1), IntegerType::Modifier::Unsigned);
+		m_bytesM[i] = std::make_unique<FixedBytesType>(i + 1);
+	}
+	m_magics = {{
+		{std::make_unique<MagicType>(MagicType::Kind::Block)},
+		{std::make_unique<MagicType>(MagicType::Kind::Message)},
+		{std::make_unique<MagicType>(MagicType::Kind::Transaction)},
+		{std::make_unique<MagicType>(MagicType::Kind::ABI)},
+		{std::make_unique<MagicType>(MagicType::Kind::Error)}
+		// MetaType is stored separately
+	}};
+}
+
+TypeProvider::ScopedInstance::ScopedInstance(TypeProvider& _provider):
+	m_previous(activeTypeProvider)
+{
+	activeTypeProvider = &_provider;
+}
+
+TypeProvider::ScopedInstance::~ScopedInstance()
+{
+	activeTypeProvider = m_previous;
+}
+
+TypeProvider& TypeProvider::instance() noexcept
+{
+	if (activeTypeProvider)
+		return *activeTypeProvider;
+	return defaultTypeProvider();
+}
+
+size_t TypeProvider::defaultInstanceTypeCount()
+{
+	TypeProvider& provider = defaultTypeProvider();
+	std::lock_guard lock(provider.m_mutex);
+	size_t count =
+		provider.m_generalTypes.size() +
+		provider.m_stringLiteralTypes.size() +
+		provider.m_ufixedMxN.size() +
+		provider.m_fixedMxN.size();
+	for (auto const* arrayType: {
+		&provider.m_bytesStorage,
+		&provider.m_bytesMemory,
+		&provider.m_bytesCalldata,
+		&provider.m_stringStorage,
+		&provider.m_stringMemory
+	})
+		if (*arrayType)
+			++count;
+	return count;
+}
 
 inline void clearCache(Type const& type)
 {
@@ -176,32 +118,51 @@ inline void clearCaches(Container& container)
 
 void TypeProvider::reset()
 {
-	clearCache(m_boolean);
-	clearCache(m_inaccessibleDynamic);
-	clearCache(m_bytesStorage);
-	clearCache(m_bytesMemory);
-	clearCache(m_bytesCalldata);
-	clearCache(m_stringStorage);
-	clearCache(m_stringMemory);
-	clearCache(m_emptyTuple);
-	clearCache(m_payableAddress);
-	clearCache(m_address);
-	clearCaches(instance().m_intM);
-	clearCaches(instance().m_uintM);
-	clearCaches(instance().m_bytesM);
-	clearCaches(instance().m_magics);
-
-	instance().m_generalTypes.clear();
-	instance().m_stringLiteralTypes.clear();
-	instance().m_ufixedMxN.clear();
-	instance().m_fixedMxN.clear();
+	TypeProvider& provider = instance();
+	std::lock_guard lock(provider.m_mutex);
+	clearCache(provider.m_boolean);
+	clearCache(provider.m_inaccessibleDynamic);
+	clearCache(provider.m_bytesStorage);
+	clearCache(provider.m_bytesMemory);
+	clearCache(provider.m_bytesCalldata);
+	clearCache(provider.m_stringStorage);
+	clearCache(provider.m_stringMemory);
+	clearCache(provider.m_emptyTuple);
+	clearCache(provider.m_payableAddress);
+	clearCache(provider.m_address);
+	clearCaches(provider.m_intM);
+	clearCaches(provider.m_uintM);
+	clearCaches(provider.m_bytesM);
+	clearCaches(provider.m_magics);
+
+	provider.m_generalTypes.clear();
+	provider.m_stringLiteralTypes.clear();
+	provider.m_ufixedMxN.clear();
+	provider.m_fixedMxN.clear();
 }
 
 template <typename T, typename... Args>
 inline T const* TypeProvider::createAndGet(Args&& ... _args)
 {
-	instance().m_generalTypes.emplace_back(std::make_unique<T>(std::forward<Args>(_args)...));
-	return static_cast<T const*>(instance().m_generalTypes.back().get());
+	// Constructors can request other types, so the type is created before locking.
+	return static_cast<T const*>(store(std::make_unique<T>(std::forward<Args>(_args)...)));
+}
+
+Type const* TypeProvider::store(std::unique_ptr<Type> _type)
+{
+	TypeProvider& provider = instance();
+	std::lock_guard lock(provider.m_mutex);
+	return provider.m_generalTypes.emplace_back(std::move(_type)).get();
+}
+
+ArrayType const* TypeProvider::lazyArrayType(std::unique_ptr<ArrayType> TypeProvider::* _member, DataLocation _location, bool _isString)
+{
+	TypeProvider& provider = instance();
+	std::lock_guard lock(provider.m_mutex);
+	std::unique_ptr<ArrayType>& type = provider.*_member;
+	if (!type)
+		type = std::make_unique<ArrayType>(_location, _isString);
+	return type.get();
 }
 
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
@@ -306,37 +267,27 @@ Type const* TypeProvider::fromElementaryTypeName(std::string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
-	if (!m_bytesStorage)
-		m_bytesStorage = std::make_unique<ArrayType>(DataLocation::Storage, false);
-	return m_bytesStorage.get();
+	return lazyArrayType(&TypeProvider::m_bytesStorage, DataLocation::Storage, false);
 }
 
 ArrayType const* TypeProvider::bytesMemory()
 {
-	if (!m_bytesMemory)
-		m_bytesMemory = std::make_unique<ArrayType>(DataLocation::Memory, false);
-	return m_bytesMemory.get();
+	return lazyArrayType(&TypeProvider::m_bytesMemory, DataLocation::Memory, false);
 }
 
 ArrayType const* TypeProvider::bytesCalldata()
 {
-	if (!m_bytesCalldata)
-		m_bytesCalldata = std::make_unique<ArrayType>(DataLocation::CallData, false);
-	return m_bytesCalldata.get();
+	return lazyArrayType(&TypeProvider::m_bytesCalldata, DataLocation::CallData, false);
 }
 
 ArrayType const* TypeProvider::stringStorage()
 {
-	if (!m_stringStorage)
-		m_stringStorage = std::make_unique<ArrayType>(DataLocation::Storage, true);
-	return m_stringStorage.get();
+	return lazyArrayType(&TypeProvider::m_stringStorage, DataLocation::Storage, true);
 }
 
 ArrayType const* TypeProvider::stringMemory()
 {
-	if (!m_stringMemory)
-		m_stringMemory = std::make_unique<ArrayType>(DataLocation::Memory, true);
-	return m_stringMemory.get();
+	return lazyArrayType(&TypeProvider::m_stringMemory, DataLocation::Memory, true);
 }
 
 Type const* TypeProvider::forLiteral(Literal const& _literal)
@@ -378,16 +329,20 @@ RationalNumberType const* TypeProvider::rationalNumber(Literal const& _literal)
 
 StringLiteralType const* TypeProvider::stringLiteral(std::string const& literal)
 {
-	auto i = instance().m_stringLiteralTypes.find(literal);
-	if (i != instance().m_stringLiteralTypes.end())
+	TypeProvider& provider = instance();
+	std::lock_guard lock(provider.m_mutex);
+	auto i = provider.m_stringLiteralTypes.find(literal);
+	if (i != provider.m_stringLiteralTypes.end())
 		return i->second.get();
 	else
-		return instance().m_stringLiteralTypes.emplace(literal, std::make_unique<StringLiteralType>(literal)).first->second.get();
+		return provider.m_stringLiteralTypes.emplace(literal, std::make_unique<StringLiteralType>(literal)).first->second.get();
 }
 
 FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPointType::Modifier _modifier)
 {
-	auto& map = _modifier == FixedPointType::Modifier::Unsigned ? instance().m_ufixedMxN : instance().m_fixedMxN;
+	TypeProvider& provider = instance();
+	std::lock_guard lock(provider.m_mutex);
+	auto& map = _modifier == FixedPointType::Modifier::Unsigned ? provider.m_ufixedMxN : provider.m_fixedMxN;
 
 	auto i = map.find(std::make_pair(m, n));
 	if (i != map.end())
@@ -402,7 +357,7 @@ FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPoin
 TupleType const* TypeProvider::tuple(std::vector<Type const*> members)
 {
 	if (members.empty())
-		return &m_emptyTuple;
+		return emptyTuple();
 
 	return createAndGet<TupleType>(std::move(members));
 }
@@ -412,8 +367,7 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
-	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	return static_cast<ReferenceType const*>(store(_type->copyForLocation(_location, _isPointer)));
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
@@ -555,7 +509,7 @@ ModifierType const* TypeProvider::modifier(ModifierDefinition const& _def)
 MagicType const* TypeProvider::magic(MagicType::Kind _kind)
 {
 	solAssert(_kind != MagicType::Kind::MetaType, "MetaType is handled separately");
-	return m_magics.at(static_cast<size_t>(_kind)).get();
+	return instance().m_magics.at(static_cast<size_t>(_kind)).get();
 }
 
 MagicType const* TypeProvider::meta(Type const* _type)
@@ -44,13 +44,14 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/algorithm/string/split.hpp>
 
-#include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/tail.hpp>
 #include <range/v3/view/transform.hpp>
 #include <range/v3/view/filter.hpp>
 
 #include <limits>
+#include <mutex>
+#include <numeric>
 #include <unordered_set>
 #include <utility>
 
@@ -61,6 +62,28 @@ using namespace solidity::frontend;
 namespace
 {
 
+/// Protects the member lists and other data cached in types, since types can be shared between
+/// analysis steps running concurrently.
+std::mutex typeCacheMutex;
+
+/// @returns the value in @a _cache, storing the result of @a _compute there first if it is empty.
+/// The value is computed without holding the lock, since computing it can require cached data of
+/// other types. Cached values are never replaced, so the returned reference stays valid.
+template<typename T, typename F>
+T const& cachedValue(std::optional<T>& _cache, F&& _compute)
+{
+	{
+		std::lock_guard lock(typeCacheMutex);
+		if (_cache.has_value())
+			return *_cache;
+	}
+	T value = _compute();
+	std::lock_guard lock(typeCacheMutex);
+	if (!_cache.has_value())
+		_cache = std::move(value);
+	return *_cache;
+}
+
 /// Checks whether _mantissa * (10 ** _expBase10) fits into 4096 bits.
 bool fitsPrecisionBase10(bigint const& _mantissa, uint32_t _expBase10)
 {
@@ -133,11 +156,30 @@ MemberList::Member::Member(Declaration const* _declaration, Type const* _type, s
 
 void Type::clearCache() const
 {
+	std::lock_guard lock(typeCacheMutex);
 	m_members.clear();
 	m_stackItems.reset();
 	m_stackSize.reset();
 }
 
+std::vector<std::tuple<std::string, Type const*>> const& Type::stackItems() const
+{
+	return cachedValue(m_stackItems, [&] { return makeStackItems(); });
+}
+
+unsigned Type::sizeOnStack() const
+{
+	return static_cast<unsigned>(cachedValue(m_stackSize, [&] {
+		size_t sizeOnStack = 0;
+		for (auto const& slot: stackItems())
+			if (std::get<1>(slot))
+				sizeOnStack += std::get<1>(slot)->sizeOnStack();
+			else
+				++sizeOnStack;
+		return sizeOnStack;
+	}));
+}
+
 void StorageOffsets::computeOffsets(TypePointers const& _types)
 {
 	bigint slotOffset = 0;
@@ -183,16 +225,54 @@ std::pair<u256, unsigned> const* StorageOffsets::offset(size_t _index) const
 void MemberList::combine(MemberList const & _other)
 {
 	m_memberTypes += _other.m_memberTypes;
+	indexMembers();
+}
+
+Type const* MemberList::memberType(std::string const& _name) const
+{
+	auto [begin, end] = membersNamed(_name);
+	if (begin == end)
+		return nullptr;
+	solAssert(std::next(begin) == end, "Requested member type by non-unique name.");
+	return m_memberTypes[*begin].type;
+}
+
+MemberList::MemberMap MemberList::membersByName(std::string const& _name) const
+{
+	auto [begin, end] = membersNamed(_name);
+	MemberMap members;
+	for (auto it = begin; it != end; ++it)
+		members.push_back(m_memberTypes[*it]);
+	return members;
 }
 
 std::pair<u256, unsigned> const* MemberList::memberStorageOffset(std::string const& _name) const
 {
-	StorageOffsets const& offsets = storageOffsets();
+	auto [begin, end] = membersNamed(_name);
+	if (begin == end)
+		return nullptr;
+	return storageOffsets().offset(*begin);
+}
 
-	for (auto&& [index, member]: m_memberTypes | ranges::views::enumerate)
-		if (member.name == _name)
-			return offsets.offset(index);
-	return nullptr;
+void MemberList::indexMembers()
+{
+	m_indicesByName.resize(m_memberTypes.size());
+	std::iota(m_indicesByName.begin(), m_indicesByName.end(), size_t(0));
+	std::stable_sort(m_indicesByName.begin(), m_indicesByName.end(), [&](size_t _a, size_t _b) {
+		return m_memberTypes[_a].name < m_memberTypes[_b].name;
+	});
+}
+
+std::pair<MemberList::IndexIterator, MemberList::IndexIterator> MemberList::membersNamed(std::string const& _name) const
+{
+	auto const byName = [&](size_t _index) -> std::string const& { return m_memberTypes[_index].name; };
+	auto begin = std::lower_bound(m_indicesByName.begin(), m_indicesByName.end(), _name, [&](size_t _index, std::string const& _value) {
+		return byName(_index) < _value;
+	});
+	auto end = std::upper_bound(begin, m_indicesByName.end(), _name, [&](std::string const& _value, size_t _index) {
+		return _value < byName(_index);
+	});
+	return {begin, end};
 }
 
 u256 const& MemberList::storageSize() const
@@ -295,19 +375,28 @@ Type const* Type::commonType(Type const* _a, Type const* _b)
 
 MemberList const& Type::members(ASTNode const* _currentScope) const
 {
-	if (!m_members[_currentScope])
 	{
-		solAssert(
-			_currentScope == nullptr ||
-			dynamic_cast<SourceUnit const*>(_currentScope) ||
-			dynamic_cast<ContractDefinition const*>(_currentScope),
-		"");
-		MemberList::MemberMap members = nativeMembers(_currentScope);
-		if (_currentScope)
-			members += attachedFunctions(*this, *_currentScope);
-		m_members[_currentScope] = std::make_unique<MemberList>(std::move(members));
+		std::lock_guard lock(typeCacheMutex);
+		auto it = m_members.find(_currentScope);
+		if (it != m_members.end() && it->second)
+			return *it->second;
 	}
-	return *m_members[_currentScope];
+
+	solAssert(
+		_currentScope == nullptr ||
+		dynamic_cast<SourceUnit const*>(_currentScope) ||
+		dynamic_cast<ContractDefinition const*>(_currentScope),
+	"");
+	// Determining the members can require the members of other types, so this is done without the lock.
+	MemberList::MemberMap members = nativeMembers(_currentScope);
+	if (_currentScope)
+		members += attachedFunctions(*this, *_currentScope);
+
+	std::lock_guard lock(typeCacheMutex);
+	std::unique_ptr<MemberList>& memberList = m_members[_currentScope];
+	if (!memberList)
+		memberList = std::make_unique<MemberList>(std::move(members));
+	return *memberList;
 }
 
 Type const* Type::fullEncodingType(bool _inLibraryCall, bool _encoderV2, bool) const
@@ -1976,12 +2065,13 @@ Type const* ArrayType::decodingType() const
 
 TypeResult ArrayType::interfaceType(bool _inLibrary) const
 {
-	if (_inLibrary && m_interfaceType_library.has_value())
-		return *m_interfaceType_library;
-
-	if (!_inLibrary && m_interfaceType.has_value())
-		return *m_interfaceType;
+	return cachedValue(_inLibrary ? m_interfaceType_library : m_interfaceType, [&] {
+		return computeInterfaceType(_inLibrary);
+	});
+}
 
+TypeResult ArrayType::computeInterfaceType(bool _inLibrary) const
+{
 	TypeResult result{nullptr};
 	TypeResult baseInterfaceType = m_baseType->interfaceType(_inLibrary);
 
@@ -1999,11 +2089,6 @@ TypeResult ArrayType::interfaceType(bool _inLibrary) const
 	else
 		result = TypeProvider::array(DataLocation::Memory, baseInterfaceType, m_length);
 
-	if (_inLibrary)
-		m_interfaceType_library = result;
-	else
-		m_interfaceType = result;
-
 	return result;
 }
 
@@ -2143,9 +2228,7 @@ MemberList::MemberMap ContractType::nativeMembers(ASTNode const*) const
 
 FunctionType const* ContractType::newExpressionType() const
 {
-	if (!m_constructorType)
-		m_constructorType = FunctionType::newExpressionType(m_contract);
-	return m_constructorType;
+	return cachedValue(m_constructorType, [&] { return FunctionType::newExpressionType(m_contract); });
 }
 
 std::vector<std::tuple<VariableDeclaration const*, u256, unsigned>> ContractType::stateVariables(DataLocation _location) const
@@ -2382,41 +2465,42 @@ MemberList::MemberMap StructType::nativeMembers(ASTNode const*) const
 }
 
 TypeResult StructType::interfaceType(bool _inLibrary) const
+{
+	if (!_inLibrary)
+		return cachedValue(m_interfaceType, [&] { return computeInterfaceType(false); });
+
+	{
+		std::lock_guard lock(typeCacheMutex);
+		if (m_interfaceType_library.has_value())
+			return *m_interfaceType_library;
+	}
+	// Errors are not cached for libraries.
+	TypeResult result = computeInterfaceType(true);
+	if (!result.message().empty())
+		return result;
+	return cachedValue(m_interfaceType_library, [&] { return result; });
+}
+
+TypeResult StructType::computeInterfaceType(bool _inLibrary) const
 {
 	if (!_inLibrary)
 	{
-		if (!m_interfaceType.has_value())
+		if (recursive())
+			return TypeResult::err("Recursive type not allowed for public or external contract functions.");
+
+		for (ASTPointer<VariableDeclaration> const& member: m_struct.members())
 		{
-			if (recursive())
-				m_interfaceType = TypeResult::err("Recursive type not allowed for public or external contract functions.");
-			else
+			if (!member->annotation().type)
+				return TypeResult::err("Invalid type!");
+			auto interfaceType = member->annotation().type->interfaceType(false);
+			if (!interfaceType.get())
 			{
-				TypeResult result{nullptr};
-				for (ASTPointer<VariableDeclaration> const& member: m_struct.members())
-				{
-					if (!member->annotation().type)
-					{
-						result = TypeResult::err("Invalid type!");
-						break;
-					}
-					auto interfaceType = member->annotation().type->interfaceType(false);
-					if (!interfaceType.get())
-					{
-						solAssert(!interfaceType.message().empty(), "Expected detailed error message!");
-						result = interfaceType;
-						break;
-					}
-				}
-				if (result.message().empty())
-					m_interfaceType = TypeProvider::withLocation(this, DataLocation::Memory, true);
-				else
-					m_interfaceType = result;
+				solAssert(!interfaceType.message().empty(), "Expected detailed error message!");
+				return interfaceType;
 			}
 		}
-		return *m_interfaceType;
+		return TypeProvider::withLocation(this, DataLocation::Memory, true);
 	}
-	else if (m_interfaceType_library.has_value())
-		return *m_interfaceType_library;
 
 	TypeResult result{nullptr};
 
@@ -2478,10 +2562,9 @@ TypeResult StructType::interfaceType(bool _inLibrary) const
 		return result;
 
 	if (location() == DataLocation::Storage)
-		m_interfaceType_library = this;
+		return this;
 	else
-		m_interfaceType_library = TypeProvider::withLocation(this, DataLocation::Memory, true);
-	return *m_interfaceType_library;
+		return TypeProvider::withLocation(this, DataLocation::Memory, true);
 }
 
 Declaration const* StructType::typeDefinition() const
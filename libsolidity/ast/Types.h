@@ -119,28 +119,11 @@ public:
 
 	using MemberMap = std::vector<Member>;
 
-	explicit MemberList(MemberMap _members): m_memberTypes(std::move(_members)) {}
+	explicit MemberList(MemberMap _members): m_memberTypes(std::move(_members)) { indexMembers(); }
 
 	void combine(MemberList const& _other);
-	Type const* memberType(std::string const& _name) const
-	{
-		Type const* type = nullptr;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-			{
-				solAssert(!type, "Requested member type by non-unique name.");
-				type = it.type;
-			}
-		return type;
-	}
-	MemberMap membersByName(std::string const& _name) const
-	{
-		MemberMap members;
-		for (auto const& it: m_memberTypes)
-			if (it.name == _name)
-				members.push_back(it);
-		return members;
-	}
+	Type const* memberType(std::string const& _name) const;
+	MemberMap membersByName(std::string const& _name) const;
 	/// @returns the offset of the given member in storage slots and bytes inside a slot or
 	/// a nullptr if the member is not part of storage.
 	std::pair<u256, unsigned> const* memberStorageOffset(std::string const& _name) const;
@@ -151,9 +134,17 @@ public:
 	MemberMap::const_iterator end() const { return m_memberTypes.end(); }
 
 private:
+	using IndexIterator = std::vector<size_t>::const_iterator;
+
 	StorageOffsets const& storageOffsets() const;
+	void indexMembers();
+	/// @returns the indices of the members called @a _name, in ascending order.
+	std::pair<IndexIterator, IndexIterator> membersNamed(std::string const& _name) const;
 
 	MemberMap m_memberTypes;
+	/// Indices into m_memberTypes ordered by the name of the member, so that members can be looked
+	/// up without comparing against every name. Members of the same name keep their order.
+	std::vector<size_t> m_indicesByName;
 	util::LazyInit<StorageOffsets> m_storageOffsets;
 };
 
@@ -309,28 +300,10 @@ public:
 	/// The complete layout of a type on the stack can be obtained from its stack items recursively as follows:
 	/// - Each unnamed stack item is untyped (its type is ``nullptr``) and contributes exactly one stack slot.
 	/// - Each named stack item is typed and contributes the stack slots given by the stack items of its type.
-	std::vector<std::tuple<std::string, Type const*>> const& stackItems() const
-	{
-		if (!m_stackItems)
-			m_stackItems = makeStackItems();
-		return *m_stackItems;
-	}
+	std::vector<std::tuple<std::string, Type const*>> const& stackItems() const;
 	/// Total number of stack slots occupied by this type. This is the sum of ``sizeOnStack`` of all ``stackItems()``.
 	// TODO: consider changing the return type to be size_t
-	unsigned sizeOnStack() const
-	{
-		if (!m_stackSize)
-		{
-			size_t sizeOnStack = 0;
-			for (auto const& slot: stackItems())
-				if (std::get<1>(slot))
-					sizeOnStack += std::get<1>(slot)->sizeOnStack();
-				else
-					++sizeOnStack;
-			m_stackSize = sizeOnStack;
-		}
-		return static_cast<unsigned>(*m_stackSize);
-	}
+	unsigned sizeOnStack() const;
 	/// If it is possible to initialize such a value in memory by just writing zeros
 	/// of the size memoryHeadSize().
 	virtual bool hasSimpleZeroValueInMemory() const { return true; }
@@ -907,6 +880,7 @@ private:
 	enum class ArrayKind { Ordinary, Bytes, String };
 
 	bigint unlimitedStaticCalldataSize(bool _padded) const;
+	TypeResult computeInterfaceType(bool _inLibrary) const;
 
 	///< Byte arrays ("bytes") and strings have different semantics from ordinary arrays.
 	ArrayKind m_arrayKind = ArrayKind::Ordinary;
@@ -1014,7 +988,7 @@ private:
 	/// If true, this is a special "super" type of m_contract containing only members that m_contract inherited
 	bool m_super = false;
 	/// Type of the constructor, @see constructorType. Lazily initialized.
-	mutable FunctionType const* m_constructorType = nullptr;
+	mutable std::optional<FunctionType const*> m_constructorType;
 };
 
 /**
@@ -1076,6 +1050,8 @@ protected:
 	std::vector<Type const*> decomposition() const override;
 
 private:
+	TypeResult computeInterfaceType(bool _inLibrary) const;
+
 	StructDefinition const& m_struct;
 	// Caches for interfaceType(bool)
 	mutable std::optional<TypeResult> m_interfaceType;
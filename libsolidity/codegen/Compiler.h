@@ -41,11 +41,12 @@ public:
 		langutil::EVMVersion _evmVersion,
 		std::optional<uint8_t> _eofVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		std::shared_ptr<InlineAssemblyCache> const& _inlineAssemblyCache = nullptr
 	):
 		m_optimiserSettings(std::move(_optimiserSettings)),
-		m_runtimeContext(_evmVersion, _eofVersion, _revertStrings),
-		m_context(_evmVersion, _eofVersion, _revertStrings, &m_runtimeContext)
+		m_runtimeContext(_evmVersion, _eofVersion, _revertStrings, nullptr, _inlineAssemblyCache),
+		m_context(_evmVersion, _eofVersion, _revertStrings, &m_runtimeContext, _inlineAssemblyCache)
 	{ }
 
 	/// Compiles a contract.
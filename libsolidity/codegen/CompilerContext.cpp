@@ -388,24 +388,49 @@ void CompilerContext::appendInlineAssembly(
 {
 	unsigned startStackHeight = stackHeight();
 
-	std::set<yul::YulName> externallyUsedIdentifiers;
-	for (auto const& fun: _externallyUsedFunctions)
-		externallyUsedIdentifiers.insert(yul::YulName(fun));
-	for (auto const& var: _localVariables)
-		externallyUsedIdentifiers.insert(yul::YulName(var));
-
-	yul::ExternalIdentifierAccess identifierAccess;
-	identifierAccess.resolve = [&](
-		yul::Identifier const& _identifier,
-		yul::IdentifierContext,
-		bool _insideFunction
-	) -> bool
-	{
-		if (_insideFunction)
-			return false;
-		return util::contains(_localVariables, _identifier.name.str());
+	std::optional<langutil::SourceLocation> locationOverride;
+	if (!_system)
+		locationOverride = m_asm->currentSourceLocation();
+
+	// Several optimizer steps cannot handle externally supplied stack variables,
+	// so we essentially only optimize the ABI functions.
+	bool const optimize = _optimiserSettings.runYulOptimiser && _localVariables.empty();
+	InlineAssemblyCache::Key cacheKey{
+		_localVariables,
+		_externallyUsedFunctions,
+		_system,
+		_sourceName,
+		locationOverride,
+		m_evmVersion,
+		optimize ? std::make_optional(_optimiserSettings) : std::nullopt,
+		optimize && runtimeContext() != nullptr
 	};
-	identifierAccess.generateCode = [&](
+	std::shared_ptr<InlineAssemblyCache::Entry const> parsed;
+	if (m_inlineAssemblyCache)
+		parsed = m_inlineAssemblyCache->find(_assembly, cacheKey);
+	if (!parsed)
+	{
+		parsed = std::make_shared<InlineAssemblyCache::Entry const>(parseInlineAssembly(
+			_assembly,
+			_localVariables,
+			_externallyUsedFunctions,
+			_system,
+			std::move(locationOverride),
+			optimize ? &_optimiserSettings : nullptr,
+			_sourceName
+		));
+		if (m_inlineAssemblyCache)
+			m_inlineAssemblyCache->store(_assembly, std::move(cacheKey), parsed);
+	}
+
+	if (_system)
+	{
+		// Store as generated source. Source references from the bytecode point into it.
+		solAssert(m_generatedYulUtilityCode.empty(), "");
+		m_generatedYulUtilityCode = parsed->generatedYulUtilityCode;
+	}
+
+	yul::ExternalIdentifierAccess::CodeGenerator identifierAccess = [&](
 		yul::Identifier const& _identifier,
 		yul::IdentifierContext _context,
 		yul::AbstractAssembly& _assembly
@@ -433,15 +458,48 @@ void CompilerContext::appendInlineAssembly(
 		}
 	};
 
+	yul::CodeGenerator::assemble(
+		parsed->ast->root(),
+		*parsed->analysisInfo,
+		*m_asm,
+		m_evmVersion,
+		std::nullopt,
+		identifierAccess,
+		_system,
+		_optimiserSettings.optimizeStackAllocation
+	);
+
+	// Reset the source location to the one of the node (instead of the CODEGEN source location)
+	updateSourceLocation();
+}
+
+InlineAssemblyCache::Entry CompilerContext::parseInlineAssembly(
+	std::string const& _assembly,
+	std::vector<std::string> const& _localVariables,
+	std::set<std::string> const& _externallyUsedFunctions,
+	bool _system,
+	std::optional<langutil::SourceLocation> _locationOverride,
+	OptimiserSettings const* _optimiserSettings,
+	std::string const& _sourceName
+)
+{
+	auto resolve = [&](
+		yul::Identifier const& _identifier,
+		yul::IdentifierContext,
+		bool _insideFunction
+	) -> bool
+	{
+		if (_insideFunction)
+			return false;
+		return util::contains(_localVariables, _identifier.name.str());
+	};
+
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
 	langutil::CharStream charStream(_assembly, _sourceName);
 	yul::EVMDialect const& dialect = yul::EVMDialect::strictAssemblyForEVM(m_evmVersion, std::nullopt);
-	std::optional<langutil::SourceLocation> locationOverride;
-	if (!_system)
-		locationOverride = m_asm->currentSourceLocation();
 	std::shared_ptr<yul::AST> parserResult =
-		yul::Parser(errorReporter, dialect, std::move(locationOverride))
+		yul::Parser(errorReporter, dialect, std::move(_locationOverride))
 		.parse(charStream);
 #ifdef SOL_OUTPUT_ASM
 	std::cout << yul::AsmPrinter::format(*parserResult) << std::endl;
@@ -464,41 +522,44 @@ void CompilerContext::appendInlineAssembly(
 		solAssert(false, message);
 	};
 
-	yul::AsmAnalysisInfo analysisInfo;
+	auto analysisInfo = std::make_shared<yul::AsmAnalysisInfo>();
 	bool analyzerResult = false;
 	if (parserResult)
 		analyzerResult = yul::AsmAnalyzer(
-			analysisInfo,
+			*analysisInfo,
 			errorReporter,
 			dialect,
-			identifierAccess.resolve
+			resolve
 		).analyze(parserResult->root());
 	if (!parserResult || errorReporter.hasErrorsWarningsOrInfos() || !analyzerResult)
 		reportError("Invalid assembly generated by code generator.");
-	std::shared_ptr<yul::AST const> toBeAssembledAST = parserResult;
 
-	// Several optimizer steps cannot handle externally supplied stack variables,
-	// so we essentially only optimize the ABI functions.
-	if (_optimiserSettings.runYulOptimiser && _localVariables.empty())
+	InlineAssemblyCache::Entry result{parserResult, std::move(analysisInfo), {}};
+	if (_optimiserSettings)
 	{
+		std::set<yul::YulName> externallyUsedIdentifiers;
+		for (auto const& fun: _externallyUsedFunctions)
+			externallyUsedIdentifiers.insert(yul::YulName(fun));
+		for (auto const& var: _localVariables)
+			externallyUsedIdentifiers.insert(yul::YulName(var));
+
 		yul::Object obj;
-		obj.setCode(parserResult, std::make_shared<yul::AsmAnalysisInfo>(analysisInfo));
+		obj.setCode(parserResult, result.analysisInfo);
 
 		solAssert(!dialect.providesObjectAccess());
-		optimizeYul(obj, _optimiserSettings, externallyUsedIdentifiers);
+		optimizeYul(obj, *_optimiserSettings, externallyUsedIdentifiers);
 
 		if (_system)
 		{
 			// Store as generated sources, but first re-parse to update the source references.
-			solAssert(m_generatedYulUtilityCode.empty(), "");
-			m_generatedYulUtilityCode = yul::AsmPrinter::format(*obj.code());
-			langutil::CharStream charStream(m_generatedYulUtilityCode, _sourceName);
+			result.generatedYulUtilityCode = yul::AsmPrinter::format(*obj.code());
+			langutil::CharStream charStream(result.generatedYulUtilityCode, _sourceName);
 			obj.setCode(yul::Parser(errorReporter, dialect).parse(charStream));
 			obj.analysisInfo = std::make_shared<yul::AsmAnalysisInfo>(yul::AsmAnalyzer::analyzeStrictAssertCorrect(obj));
 		}
 
-		analysisInfo = std::move(*obj.analysisInfo);
-		toBeAssembledAST = obj.code();
+		result.ast = obj.code();
+		result.analysisInfo = obj.analysisInfo;
 
 #ifdef SOL_OUTPUT_ASM
 		std::cout << "After optimizer:" << std::endl;
@@ -506,29 +567,13 @@ void CompilerContext::appendInlineAssembly(
 #endif
 	}
 	else if (_system)
-	{
-		// Store as generated source.
-		solAssert(m_generatedYulUtilityCode.empty(), "");
-		m_generatedYulUtilityCode = _assembly;
-	}
+		result.generatedYulUtilityCode = _assembly;
 
 	if (errorReporter.hasErrorsWarningsOrInfos())
 		reportError("Failed to analyze inline assembly block.");
 
 	solAssert(!errorReporter.hasErrorsWarningsOrInfos(), "Failed to analyze inline assembly block.");
-	yul::CodeGenerator::assemble(
-		toBeAssembledAST->root(),
-		analysisInfo,
-		*m_asm,
-		m_evmVersion,
-		std::nullopt,
-		identifierAccess.generateCode,
-		_system,
-		_optimiserSettings.optimizeStackAllocation
-	);
-
-	// Reset the source location to the one of the node (instead of the CODEGEN source location)
-	updateSourceLocation();
+	return result;
 }
 
 
@@ -27,6 +27,7 @@
 #include <libsolidity/ast/ASTForward.h>
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/codegen/ABIFunctions.h>
+#include <libsolidity/codegen/InlineAssemblyCache.h>
 
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/OptimiserSettings.h>
@@ -64,13 +65,15 @@ public:
 		langutil::EVMVersion _evmVersion,
 		std::optional<uint8_t> _eofVersion,
 		RevertStrings _revertStrings,
-		CompilerContext* _runtimeContext = nullptr
+		CompilerContext* _runtimeContext = nullptr,
+		std::shared_ptr<InlineAssemblyCache> _inlineAssemblyCache = nullptr
 	):
 		m_asm(std::make_shared<evmasm::Assembly>(_evmVersion, _runtimeContext != nullptr, std::nullopt, std::string{})),
 		m_evmVersion(_evmVersion),
 		m_revertStrings(_revertStrings),
 		m_reservedMemory{0},
 		m_runtimeContext(_runtimeContext),
+		m_inlineAssemblyCache(std::move(_inlineAssemblyCache)),
 		m_abiFunctions(m_evmVersion, _eofVersion, m_revertStrings, m_yulFunctionCollector),
 		m_yulUtilFunctions(m_evmVersion, _eofVersion, m_revertStrings, m_yulFunctionCollector)
 	{
@@ -264,6 +267,7 @@ public:
 	///                and the code is marked to be exported as "compiler-generated assembly utility file".
 	/// @param _optimiserSettings settings for the Yul optimiser, which is run in this function already.
 	/// @param _sourceName the name of the assembly file to be used for source locations
+	/// The parsed snippet is taken from and stored in the inline assembly cache, if the context has one.
 	void appendInlineAssembly(
 		std::string const& _assembly,
 		std::vector<std::string> const& _localVariables = std::vector<std::string>(),
@@ -312,6 +316,18 @@ public:
 	RevertStrings revertStrings() const { return m_revertStrings; }
 
 private:
+	/// Parses and analyzes an inline assembly snippet for @a appendInlineAssembly and
+	/// optimizes it if @a _optimiserSettings is given.
+	InlineAssemblyCache::Entry parseInlineAssembly(
+		std::string const& _assembly,
+		std::vector<std::string> const& _localVariables,
+		std::set<std::string> const& _externallyUsedFunctions,
+		bool _system,
+		std::optional<langutil::SourceLocation> _locationOverride,
+		OptimiserSettings const* _optimiserSettings,
+		std::string const& _sourceName
+	);
+
 	/// Updates source location set in the assembly.
 	void updateSourceLocation();
 
@@ -375,6 +391,8 @@ private:
 	std::stack<ASTNode const*> m_visitedNodes;
 	/// The runtime context if in Creation mode, this is used for generating tags that would be stored into the storage and then used at runtime.
 	CompilerContext *m_runtimeContext;
+	/// Cache of parsed inline assembly snippets shared with other contexts, if any.
+	std::shared_ptr<InlineAssemblyCache> m_inlineAssemblyCache;
 	/// The index of the runtime subroutine.
 	size_t m_runtimeSub = std::numeric_limits<size_t>::max();
 	/// An index of low-level function labels by name.
@@ -0,0 +1,44 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/codegen/InlineAssemblyCache.h>
+
+#include <libsolutil/Assertions.h>
+
+using namespace solidity::frontend;
+
+std::shared_ptr<InlineAssemblyCache::Entry const> InlineAssemblyCache::find(
+	std::string const& _assembly,
+	Key const& _key
+) const
+{
+	auto it = m_entries.find(_assembly);
+	if (it == m_entries.end())
+		return nullptr;
+	for (auto const& [key, entry]: it->second)
+		if (key == _key)
+			return entry;
+	return nullptr;
+}
+
+void InlineAssemblyCache::store(std::string const& _assembly, Key _key, std::shared_ptr<Entry const> _entry)
+{
+	solAssert(_entry && _entry->ast && _entry->analysisInfo);
+	solAssert(!find(_assembly, _key));
+	m_entries[_assembly].emplace_back(std::move(_key), std::move(_entry));
+}
@@ -0,0 +1,91 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of the inline assembly snippets parsed by the legacy code generator.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libyul/AsmAnalysisInfo.h>
+#include <libyul/ASTForward.h>
+
+#include <liblangutil/EVMVersion.h>
+#include <liblangutil/SourceLocation.h>
+
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace solidity::frontend
+{
+
+/**
+ * Cache of the Yul snippets that were parsed, analyzed and optionally optimized by
+ * CompilerContext::appendInlineAssembly(), so that only code generation has to run
+ * when the same snippet is appended again.
+ *
+ * The cache is shared by the contexts of all contracts compiled in one run of the
+ * legacy code generator and is not thread-safe.
+ */
+class InlineAssemblyCache
+{
+public:
+	/// Everything apart from the source text that influences the result of parsing,
+	/// analyzing and optimizing a snippet.
+	struct Key
+	{
+		std::vector<std::string> localVariables;
+		std::set<std::string> externallyUsedFunctions;
+		bool system = false;
+		std::string sourceName;
+		/// The location all nodes are attributed to, unless the snippet is system code.
+		std::optional<langutil::SourceLocation> locationOverride;
+		langutil::EVMVersion evmVersion;
+		/// Settings of the Yul optimizer, only set if the snippet is optimized.
+		std::optional<OptimiserSettings> optimiserSettings;
+		/// Whether the snippet is optimized for the creation context.
+		bool optimizedForCreation = false;
+
+		bool operator==(Key const& _other) const = default;
+	};
+
+	struct Entry
+	{
+		std::shared_ptr<yul::AST const> ast;
+		std::shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+		/// The Yul source to be stored as generated source. Only set for system code.
+		std::string generatedYulUtilityCode;
+	};
+
+	/// @returns the entry stored for @a _assembly under @a _key or nullptr if there is none.
+	std::shared_ptr<Entry const> find(std::string const& _assembly, Key const& _key) const;
+	void store(std::string const& _assembly, Key _key, std::shared_ptr<Entry const> _entry);
+
+private:
+	/// Entries by source text. Snippets with the same text hardly ever differ in more than
+	/// a few keys, so those are compared linearly.
+	std::unordered_map<std::string, std::vector<std::pair<Key, std::shared_ptr<Entry const>>>> m_entries;
+};
+
+}
@@ -0,0 +1,130 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompileServer.h>
+
+#include <libsolidity/interface/StandardCompiler.h>
+
+#include <libyul/YulString.h>
+
+#include <boost/exception/diagnostic_information.hpp>
+
+#include <string>
+
+using namespace std::string_literals;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::lsp;
+
+CompileServer::CompileServer(
+	Transport& _transport,
+	ReadCallback::Callback _readFile,
+	std::function<void()> _requestFinished,
+	size_t _memoryBudget
+):
+	m_client{_transport},
+	m_readFile{std::move(_readFile)},
+	m_requestFinished{std::move(_requestFinished)},
+	m_memoryBudget{_memoryBudget}
+{
+	// The server takes over the responsibility for the YulString repository from the
+	// StandardCompiler, start from a clean state.
+	clearCache();
+}
+
+bool CompileServer::run()
+{
+	while (!m_exitRequested && !m_client.closed())
+	{
+		MessageID id;
+		try
+		{
+			std::optional<Json> const jsonMessage = m_client.receive();
+			if (!jsonMessage)
+				continue;
+
+			if (!jsonMessage->contains("method") || !(*jsonMessage)["method"].is_string())
+			{
+				m_client.error({}, ErrorCode::ParseError, "\"method\" has to be a string.");
+				continue;
+			}
+
+			std::string const methodName = (*jsonMessage)["method"].get<std::string>();
+			if (jsonMessage->contains("id"))
+				id = (*jsonMessage)["id"];
+
+			if (methodName == "compile")
+				handleCompile(id, jsonMessage->contains("params") ? (*jsonMessage)["params"] : Json{});
+			else if (methodName == "clearCache")
+			{
+				clearCache();
+				m_client.reply(id, Json{});
+			}
+			else if (methodName == "exit")
+				m_exitRequested = true;
+			else
+				m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
+		}
+		catch (Json::exception const&)
+		{
+			m_client.error(id, ErrorCode::InvalidParams, "JSON object access error. Most likely due to a badly formatted JSON request message."s);
+		}
+		catch (...)
+		{
+			m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+			// Do not trust anything cached after an unexpected failure.
+			clearCache();
+		}
+	}
+	return m_exitRequested;
+}
+
+void CompileServer::handleCompile(MessageID _id, Json const& _params)
+{
+	if (!_params.is_object())
+	{
+		m_client.error(_id, ErrorCode::InvalidParams, "Expected a Standard JSON input object as parameters.");
+		return;
+	}
+
+	StandardCompiler compiler(m_readFile, util::JsonFormat{}, m_objectOptimizer, m_parsedSourceCache);
+	Json output = compiler.compile(_params);
+	if (m_requestFinished)
+		m_requestFinished();
+	m_client.reply(_id, std::move(output));
+
+	enforceMemoryBudget();
+}
+
+void CompileServer::enforceMemoryBudget()
+{
+	size_t const usage =
+		m_objectOptimizer->approximateMemoryUsage() +
+		m_parsedSourceCache->approximateMemoryUsage() +
+		yul::YulStringRepository::instance().approximateMemoryUsage();
+	if (usage > m_memoryBudget)
+		clearCache();
+}
+
+void CompileServer::clearCache()
+{
+	// Cached ASTs refer to YulStrings, so all of them have to be dropped together.
+	m_objectOptimizer->clear();
+	m_parsedSourceCache->clear();
+	yul::YulStringRepository::reset();
+}
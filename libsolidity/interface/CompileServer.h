@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Resident compiler process answering Standard JSON requests.
+ */
+
+#pragma once
+
+#include <libsolidity/interface/ParsedSourceCache.h>
+#include <libsolidity/interface/ReadFile.h>
+#include <libsolidity/lsp/Transport.h>
+
+#include <libsolutil/JSON.h>
+
+#include <libyul/ObjectOptimizer.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace solidity::frontend
+{
+
+/**
+ * Compiler server that keeps running between compilations, so that clients compiling many times
+ * do not pay for process startup and for rebuilding static tables and caches on every compilation.
+ *
+ * Requests are JSON-RPC 2.0 messages framed by a Content-Length header, just like in the
+ * language server. Supported methods:
+ *  - "compile": params is a Standard JSON input, the result the corresponding Standard JSON output.
+ *  - "clearCache": drops all cached data.
+ *  - "exit": terminates the server.
+ *
+ * Requests are processed one at a time, in the order they are received. A request is only read
+ * once the previous one has been answered. Compilations cannot run concurrently because the type
+ * provider and the caches of the analysis are process-global, even though the YulString repository
+ * supports concurrent access. Parsed sources, optimized Yul objects
+ * and everything kept alive by the YulString repository, such as the EVM dialects, are cached
+ * across requests for as long as their estimated size stays within the given memory budget.
+ */
+class CompileServer
+{
+public:
+	/// @param _transport the transport to read requests from and write responses to.
+	/// @param _readFile callback used to read files for import statements.
+	/// @param _requestFinished called after every compilation, e.g. to make the file reader forget
+	/// about the files it has loaded.
+	/// @param _memoryBudget approximate number of bytes the caches may occupy between requests.
+	CompileServer(
+		lsp::Transport& _transport,
+		ReadCallback::Callback _readFile,
+		std::function<void()> _requestFinished,
+		size_t _memoryBudget
+	);
+
+	/// Handles requests until "exit" was received or the transport was closed.
+	/// @returns false if the transport was closed without an "exit" request.
+	bool run();
+
+private:
+	void handleCompile(lsp::MessageID _id, Json const& _params);
+	void enforceMemoryBudget();
+	void clearCache();
+
+	lsp::Transport& m_client;
+	ReadCallback::Callback m_readFile;
+	std::function<void()> m_requestFinished;
+	size_t m_memoryBudget = 0;
+	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer = std::make_shared<yul::ObjectOptimizer>();
+	std::shared_ptr<ParsedSourceCache> m_parsedSourceCache = std::make_shared<ParsedSourceCache>();
+	bool m_exitRequested = false;
+};
+
+}
@@ -51,6 +51,7 @@
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
 #include <libsolidity/interface/Natspec.h>
+#include <libsolidity/interface/ParsedSourceCache.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
 #include <libsolidity/interface/UniversalCallback.h>
@@ -72,6 +73,7 @@
 #include <libyul/YulStack.h>
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <liblangutil/Scanner.h>
@@ -84,6 +86,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -94,6 +97,7 @@
 #include <fmt/format.h>
 
 #include <utility>
+#include <future>
 #include <map>
 #include <limits>
 #include <string>
@@ -107,24 +111,18 @@ using namespace std::string_literals;
 
 using solidity::util::errinfo_comment;
 
-static int g_compilerStackCounts = 0;
-
-CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
+CompilerStack::CompilerStack(
+	ReadCallback::Callback _readFile,
+	std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer
+):
+	m_typeProvider(std::make_unique<TypeProvider>()),
 	m_readFile{std::move(_readFile)},
-	m_objectOptimizer(std::make_shared<yul::ObjectOptimizer>()),
+	m_objectOptimizer(_objectOptimizer ? std::move(_objectOptimizer) : std::make_shared<yul::ObjectOptimizer>()),
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
 }
 
-CompilerStack::~CompilerStack()
-{
-	--g_compilerStackCounts;
-	TypeProvider::reset();
-}
+CompilerStack::~CompilerStack() = default;
 
 void CompilerStack::createAndAssignCallGraphs()
 {
@@ -294,6 +292,12 @@ void CompilerStack::setMetadataHash(MetadataHash _metadataHash)
 	m_metadataHash = _metadataHash;
 }
 
+void CompilerStack::setParsedSourceCache(std::shared_ptr<ParsedSourceCache> _parsedSourceCache)
+{
+	solAssert(m_stackState < ParsedAndImported, "Must set the parsed source cache before parsing.");
+	m_parsedSourceCache = std::move(_parsedSourceCache);
+}
+
 void CompilerStack::selectDebugInfo(DebugInfoSelection _debugInfoSelection)
 {
 	solAssert(m_stackState < CompilationSuccessful, "Must select debug info components before compilation.");
@@ -335,6 +339,7 @@ void CompilerStack::reset(bool _keepSettings)
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	TypeProvider::reset();
 }
 
@@ -347,8 +352,34 @@ void CompilerStack::setSources(StringMap _sources)
 	m_stackState = SourcesSet;
 }
 
+namespace
+{
+
+/// Result of parsing a single source on its own, i.e. with node IDs starting at one.
+struct ParseResult
+{
+	ASTPointer<SourceUnit> ast;
+	std::vector<ASTNode*> nodes;
+	int64_t numIDs = 0;
+	ErrorList errors;
+};
+
+ParseResult parseSource(CharStream& _source, EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion)
+{
+	ParseResult result;
+	ErrorReporter errorReporter{result.errors};
+	frontend::Parser parser{errorReporter, _evmVersion, _eofVersion};
+	result.ast = parser.parse(_source);
+	result.nodes = parser.parsedNodes();
+	result.numIDs = parser.maxID();
+	return result;
+}
+
+}
+
 bool CompilerStack::parse()
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState == SourcesSet, "Must call parse only after the SourcesSet state.");
 	m_errorReporter.clear();
 
@@ -357,17 +388,86 @@ bool CompilerStack::parse()
 
 	try
 	{
-		Parser parser{m_errorReporter, m_evmVersion, m_eofVersion};
+		// Every source is parsed on its own on a worker thread as soon as it is known. The results are
+		// processed here in the order in which a single parser would have encountered the sources,
+		// which is where the final node IDs are assigned and the diagnostics are reported, so that
+		// the output does not depend on the number of threads.
+		// The import callback is only ever invoked from this thread.
+		EVMDialect::strictAssemblyForEVM(m_evmVersion, m_eofVersion);
+		YulStringRepository::ConcurrentAccess concurrentYulStringAccess;
+
+		struct PendingSource
+		{
+			std::string path;
+			std::optional<util::h256> cacheKey;
+			std::optional<ParsedSourceCache::CachedSource> cached;
+			std::future<ParseResult> result;
+		};
+		std::vector<PendingSource> pendingSources;
+		// The workers may only access the strings concurrently while parsing is in progress,
+		// so the remaining tasks have to be finished if parsing is aborted.
+		ScopeGuard waitForParsing([&]() {
+			for (PendingSource const& pending: pendingSources)
+				if (pending.result.valid())
+					pending.result.wait();
+		});
+		auto scheduleParsing = [&](std::string const& _path)
+		{
+			PendingSource& pending = pendingSources.emplace_back();
+			pending.path = _path;
+			std::shared_ptr<CharStream> charStream = m_sources[_path].charStream;
+			if (m_parsedSourceCache)
+			{
+				pending.cacheKey = ParsedSourceCache::key(*charStream, m_evmVersion, m_eofVersion);
+				pending.cached = m_parsedSourceCache->acquire(*pending.cacheKey);
+			}
+			if (!pending.cached)
+				pending.result = m_threadPool.submit([charStream, evmVersion = m_evmVersion, eofVersion = m_eofVersion]() {
+					return parseSource(*charStream, evmVersion, eofVersion);
+				});
+		};
 
-		std::vector<std::string> sourcesToParse;
 		for (auto const& s: m_sources)
-			sourcesToParse.push_back(s.first);
+			scheduleParsing(s.first);
 
-		for (size_t i = 0; i < sourcesToParse.size(); ++i)
+		int64_t maxID = 0;
+		for (size_t i = 0; i < pendingSources.size(); ++i)
 		{
-			std::string const& path = sourcesToParse[i];
+			std::string const path = pendingSources[i].path;
 			Source& source = m_sources[path];
-			source.ast = parser.parse(*source.charStream);
+
+			ParseResult parsed;
+			// Offset the node IDs currently have, i.e. they range from firstID + 1 to firstID + numIDs.
+			int64_t firstID = 0;
+			if (pendingSources[i].cached)
+			{
+				ParsedSourceCache::CachedSource& cached = *pendingSources[i].cached;
+				firstID = cached.ast->id() - cached.numIDs;
+				parsed = ParseResult{std::move(cached.ast), std::move(cached.nodes), cached.numIDs, {}};
+			}
+			else
+			{
+				parsed = pendingSources[i].result.get();
+				m_errorReporter.replay(parsed.errors);
+			}
+
+			if (firstID != maxID)
+				for (ASTNode* node: parsed.nodes)
+					node->shiftID(maxID - firstID);
+			maxID += parsed.numIDs;
+
+			// Only sources parsed without any diagnostics are cached, so that reusing them
+			// does not require replaying the diagnostics.
+			if (
+				pendingSources[i].cacheKey &&
+				!pendingSources[i].cached &&
+				parsed.ast &&
+				!parsed.ast->experimentalSolidity() &&
+				parsed.errors.empty()
+			)
+				m_parsedSourceCache->store(*pendingSources[i].cacheKey, {parsed.ast, parsed.nodes, parsed.numIDs});
+
+			source.ast = std::move(parsed.ast);
 			if (!source.ast)
 				solAssert(Error::containsErrors(m_errorReporter.errors()), "Parser returned null but did not report error.");
 			else
@@ -384,7 +484,7 @@ bool CompilerStack::parse()
 					{
 						auto [name, content] = *it;
 						m_sources[name].charStream = std::make_unique<CharStream>(content, name);
-						sourcesToParse.push_back(name);
+						scheduleParsing(name);
 					}
 
 					// The current value of `path` is the absolute path as seen from this source file.
@@ -402,7 +502,7 @@ bool CompilerStack::parse()
 						std::string const& newPath = newSource.first;
 						std::string const& newContents = newSource.second;
 						m_sources[newPath].charStream = std::make_shared<CharStream>(newContents, newPath);
-						sourcesToParse.push_back(newPath);
+						scheduleParsing(newPath);
 					}
 			}
 		}
@@ -414,7 +514,13 @@ bool CompilerStack::parse()
 		storeContractDefinitions();
 
 		solAssert(!m_maxAstId.has_value());
-		m_maxAstId = parser.maxID();
+		m_maxAstId = maxID;
+	}
+	catch (FatalError const& _error)
+	{
+		// Too many errors while replaying the diagnostics of the worker threads.
+		solAssert(m_errorReporter.hasErrors(), "Unreported fatal error: "s + _error.what());
+		return false;
 	}
 	catch (UnimplementedFeatureError const& _error)
 	{
@@ -427,6 +533,7 @@ bool CompilerStack::parse()
 
 void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState == Empty, "Must call importASTs only before the SourcesSet state.");
 	std::map<std::string, ASTPointer<SourceUnit>> reconstructedSources =
 		ASTJsonImporter(m_evmVersion, m_eofVersion).jsonToSourceUnit(_sources);
@@ -451,6 +558,7 @@ void CompilerStack::importASTs(std::map<std::string, Json> const& _sources)
 
 bool CompilerStack::analyze()
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState == ParsedAndImported, "Must call analyze only after parsing was successful.");
 
 	if (!resolveImports())
@@ -466,10 +574,11 @@ bool CompilerStack::analyze()
 	{
 		bool experimentalSolidity = isExperimentalSolidity();
 
-		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		bool const runYulOptimiser = m_optimiserSettings.runYulOptimiser;
+		if (!checkSourcesConcurrently([&](SourceUnit const& _sourceUnit, ErrorReporter& _errorReporter) {
+			return SyntaxChecker(_errorReporter, runYulOptimiser).checkSyntax(_sourceUnit);
+		}))
+			noErrors = false;
 
 		m_globalContext = std::make_shared<GlobalContext>(m_evmVersion);
 		// We need to keep the same resolver during the whole process.
@@ -487,12 +596,10 @@ bool CompilerStack::analyze()
 
 		resolver.warnHomonymDeclarations();
 
-		{
-			DocStringTagParser docStringTagParser(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !docStringTagParser.parseDocStrings(*source->ast))
-					noErrors = false;
-		}
+		if (!checkSourcesConcurrently([](SourceUnit const& _sourceUnit, ErrorReporter& _errorReporter) {
+			return DocStringTagParser(_errorReporter).parseDocStrings(_sourceUnit);
+		}))
+			noErrors = false;
 
 		// Requires DocStringTagParser
 		for (Source const* source: m_sourceOrder)
@@ -526,6 +633,50 @@ bool CompilerStack::analyze()
 }
 
 
+bool CompilerStack::checkSourcesConcurrently(std::function<bool(SourceUnit const&, ErrorReporter&)> const& _check)
+{
+	struct CheckResult
+	{
+		ErrorList errors;
+		bool success = false;
+		bool fatal = false;
+	};
+
+	std::vector<std::future<CheckResult>> results;
+	{
+		YulStringRepository::ConcurrentAccess concurrentYulStringAccess;
+		for (Source const* source: m_sourceOrder)
+			if (source->ast)
+				results.emplace_back(m_threadPool.submit([this, &_check, ast = source->ast]() {
+					TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
+					CheckResult result;
+					ErrorReporter errorReporter(result.errors);
+					try
+					{
+						result.success = _check(*ast, errorReporter);
+					}
+					catch (FatalError const&)
+					{
+						result.fatal = true;
+					}
+					return result;
+				}));
+		for (std::future<CheckResult> const& result: results)
+			result.wait();
+	}
+
+	bool success = true;
+	for (std::future<CheckResult>& future: results)
+	{
+		CheckResult result = future.get();
+		m_errorReporter.replay(result.errors);
+		if (result.fatal)
+			BOOST_THROW_EXCEPTION(FatalError());
+		success = success && result.success;
+	}
+	return success;
+}
+
 bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 {
 	bool noErrors = _noErrorsSoFar;
@@ -558,6 +709,10 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	//
 	// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 	// which is only done one step later.
+	//
+	// Source units are checked one after the other, in the order of their imports, since checking
+	// references to constants from inline assembly relies on the values of constants in imported
+	// source units having been type checked already.
 	TypeChecker typeChecker(m_evmVersion, m_eofVersion, m_errorReporter);
 	for (Source const* source: m_sourceOrder)
 		if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
@@ -628,21 +783,21 @@ bool CompilerStack::analyzeLegacy(bool _noErrorsSoFar)
 	if (noErrors)
 	{
 		// Checks for common mistakes. Only generates warnings.
-		StaticAnalyzer staticAnalyzer(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !staticAnalyzer.analyze(*source->ast))
-				noErrors = false;
+		if (!checkSourcesConcurrently([](SourceUnit const& _sourceUnit, ErrorReporter& _errorReporter) {
+			return StaticAnalyzer(_errorReporter).analyze(_sourceUnit);
+		}))
+			noErrors = false;
+		// The analyzer also fails if errors were reported by earlier steps.
+		if (Error::containsErrors(m_errorReporter.errors()))
+			noErrors = false;
 	}
 
 	if (noErrors)
 	{
 		// Check for state mutability in every function.
-		std::vector<ASTPointer<ASTNode>> ast;
-		for (Source const* source: m_sourceOrder)
-			if (source->ast)
-				ast.push_back(source->ast);
-
-		if (!ViewPureChecker(ast, m_errorReporter).check())
+		if (!checkSourcesConcurrently([](SourceUnit const& _sourceUnit, ErrorReporter& _errorReporter) {
+			return ViewPureChecker(_sourceUnit, _errorReporter).check();
+		}))
 			noErrors = false;
 	}
 
@@ -743,6 +898,7 @@ CompilerStack::PipelineConfig CompilerStack::requestedPipelineConfig(ContractDef
 
 bool CompilerStack::compile(State _stopAfter)
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	m_stopAfter = _stopAfter;
 	if (m_stackState < AnalysisSuccessful)
 		if (!parseAndAnalyze(_stopAfter))
@@ -753,6 +909,8 @@ bool CompilerStack::compile(State _stopAfter)
 
 	// Only compile contracts individually which have been requested.
 	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> otherCompilers;
+	// Inline assembly snippets of the legacy code generator are mostly the same for all contracts.
+	auto inlineAssemblyCache = std::make_shared<InlineAssemblyCache>();
 
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
@@ -773,7 +931,7 @@ bool CompilerStack::compile(State _stopAfter)
 							{
 								if (m_experimentalAnalysis)
 									solThrow(CompilerError, "Legacy codegen after experimental analysis is unsupported.");
-								compileContract(*contract, otherCompilers);
+								compileContract(*contract, otherCompilers, inlineAssemblyCache);
 							}
 						}
 					}
@@ -1026,6 +1184,20 @@ std::optional<Json> CompilerStack::yulIROptimizedAst(std::string const& _contrac
 	return loadGeneratedIR(*currentContract.yulIROptimized).astJson();
 }
 
+std::optional<bytes> CompilerStack::yulIROptimizedBinary(std::string const& _contractName) const
+{
+	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
+	solUnimplementedAssert(!isExperimentalSolidity());
+
+	// NOTE: Intentionally not using LazyInit, see yulIROptimizedAst().
+	Contract const& currentContract = contract(_contractName);
+	yulAssert(currentContract.contract);
+	yulAssert(currentContract.yulIROptimized.has_value() == currentContract.contract->canBeDeployed());
+	if (!currentContract.yulIROptimized)
+		return std::nullopt;
+	return loadGeneratedIR(*currentContract.yulIROptimized).binary();
+}
+
 evmasm::LinkerObject const& CompilerStack::object(std::string const& _contractName) const
 {
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
@@ -1087,6 +1259,7 @@ Json const& CompilerStack::contractABI(std::string const& _contractName) const
 
 Json const& CompilerStack::contractABI(Contract const& _contract) const
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
@@ -1101,6 +1274,7 @@ Json const& CompilerStack::storageLayout(std::string const& _contractName) const
 
 Json const& CompilerStack::storageLayout(Contract const& _contract) const
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
@@ -1116,6 +1290,7 @@ Json const& CompilerStack::transientStorageLayout(std::string const& _contractNa
 
 Json const& CompilerStack::transientStorageLayout(Contract const& _contract) const
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
@@ -1131,6 +1306,7 @@ Json const& CompilerStack::natspecUser(std::string const& _contractName) const
 
 Json const& CompilerStack::natspecUser(Contract const& _contract) const
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
@@ -1145,6 +1321,7 @@ Json const& CompilerStack::natspecDev(std::string const& _contractName) const
 
 Json const& CompilerStack::natspecDev(Contract const& _contract) const
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
@@ -1153,6 +1330,7 @@ Json const& CompilerStack::natspecDev(Contract const& _contract) const
 
 Json CompilerStack::interfaceSymbols(std::string const& _contractName) const
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
 
@@ -1216,12 +1394,14 @@ Json CompilerStack::ethdebug(Contract const& _contract, bool _runtime) const
 
 bytes CompilerStack::cborMetadata(std::string const& _contractName, bool _forIR) const
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	return createCBORMetadata(contract(_contractName), _forIR);
 }
 
 std::string const& CompilerStack::metadata(Contract const& _contract) const
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
 	solAssert(_contract.contract);
 	solUnimplementedAssert(!isExperimentalSolidity());
@@ -1517,7 +1697,8 @@ void CompilerStack::assembleYul(
 
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
-	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+	std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers,
+	std::shared_ptr<InlineAssemblyCache> const& _inlineAssemblyCache
 )
 {
 	solAssert(!m_viaIR, "");
@@ -1528,7 +1709,7 @@ void CompilerStack::compileContract(
 		return;
 
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
-		compileContract(*dependency, _otherCompilers);
+		compileContract(*dependency, _otherCompilers, _inlineAssemblyCache);
 
 	if (!_contract.canBeDeployed())
 		return;
@@ -1539,7 +1720,8 @@ void CompilerStack::compileContract(
 		m_evmVersion,
 		m_eofVersion,
 		m_revertStrings,
-		m_optimiserSettings
+		m_optimiserSettings,
+		_inlineAssemblyCache
 	);
 
 	solAssert(!m_viaIR, "");
@@ -1959,6 +2141,7 @@ Json gasToJson(GasEstimator::GasConsumption const& _gas)
 
 Json CompilerStack::gasEstimates(std::string const& _contractName) const
 {
+	TypeProvider::ScopedInstance typeProviderScope{*m_typeProvider};
 	solAssert(m_stackState == CompilationSuccessful, "Compilation was not successful.");
 	solUnimplementedAssert(!isExperimentalSolidity());
 
@@ -48,6 +48,7 @@
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <libyul/ObjectOptimizer.h>
 
@@ -86,8 +87,11 @@ class FunctionDefinition;
 class SourceUnit;
 class Compiler;
 class GlobalContext;
+class InlineAssemblyCache;
 class Natspec;
 class DeclarationContainer;
+class ParsedSourceCache;
+class TypeProvider;
 namespace experimental
 {
 class Analysis;
@@ -184,7 +188,12 @@ public:
 	/// Creates a new compiler stack.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
-	explicit CompilerStack(ReadCallback::Callback _readFile = ReadCallback::Callback());
+	/// @param _objectOptimizer cache of optimized Yul objects, possibly shared with other
+	/// compilations. A new, empty one is created if not provided.
+	explicit CompilerStack(
+		ReadCallback::Callback _readFile = ReadCallback::Callback(),
+		std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer = nullptr
+	);
 
 	~CompilerStack() override;
 
@@ -255,6 +264,11 @@ public:
 	/// Select components of debug info that should be included in comments in generated assembly.
 	void selectDebugInfo(langutil::DebugInfoSelection _debugInfoSelection);
 
+	/// Sets a cache of parsed source units, possibly shared with other compilations,
+	/// to take unchanged sources from instead of parsing them again.
+	/// The cache is kept when the compiler is reset. Must be set before parsing.
+	void setParsedSourceCache(std::shared_ptr<ParsedSourceCache> _parsedSourceCache);
+
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
 
@@ -332,6 +346,9 @@ public:
 	/// @returns the optimized IR representation of a contract AST in JSON format.
 	std::optional<Json> yulIROptimizedAst(std::string const& _contractName) const;
 
+	/// @returns the optimized IR representation of a contract in the binary format of yul::ObjectBinaryWriter.
+	std::optional<bytes> yulIROptimizedBinary(std::string const& _contractName) const;
+
 	std::optional<Json> yulCFGJson(std::string const& _contractName) const;
 
 	/// @returns the assembled object for a contract.
@@ -431,6 +448,11 @@ public:
 
 	yul::ObjectOptimizer const& objectOptimizer() const { return *m_objectOptimizer; }
 
+	/// @returns the TypeProvider owning all types of this compilation. Code that works with
+	/// the AST or types outside of the member functions of this class has to activate it using
+	/// TypeProvider::ScopedInstance if it might create new types.
+	TypeProvider& typeProvider() const { return *m_typeProvider; }
+
 private:
 	/// The state per source unit. Filled gradually during parsing.
 	struct Source
@@ -496,6 +518,13 @@ private:
 	///     multiple entries if the contact is matched by wildcards.
 	PipelineConfig requestedPipelineConfig(ContractDefinition const& _contract) const;
 
+	/// Runs @a _check on all source units concurrently. Every check reports to its own error
+	/// reporter and the errors are added to m_errorReporter in the order of the sources afterwards,
+	/// so the result is the same as if the sources had been checked one after the other.
+	/// Only suitable for checks that do not modify anything outside of the given source unit.
+	/// @returns false if any check returned false.
+	bool checkSourcesConcurrently(std::function<bool(SourceUnit const&, langutil::ErrorReporter&)> const& _check);
+
 	/// Perform the analysis steps of legacy language mode.
 	/// @returns false on error.
 	bool analyzeLegacy(bool _noErrorsSoFar);
@@ -515,9 +544,11 @@ private:
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
+	/// @param _inlineAssemblyCache snippets of inline assembly already parsed for other contracts.
 	void compileContract(
 		ContractDefinition const& _contract,
-		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers,
+		std::shared_ptr<InlineAssemblyCache> const& _inlineAssemblyCache
 	);
 
 	/// Generate Yul IR for a single contract.
@@ -602,6 +633,8 @@ private:
 	void reportCodeGenerationError(langutil::Error const& _error, ContractDefinition const* _contractDefinition);
 	void reportIRPostAnalysisError(langutil::Error const* _error, ContractDefinition const* _contractDefinition);
 
+	/// Declared first so that it outlives everything referring to its types.
+	std::unique_ptr<TypeProvider> m_typeProvider;
 	ReadCallback::Callback m_readFile;
 	OptimiserSettings m_optimiserSettings;
 	RevertStrings m_revertStrings = RevertStrings::Default;
@@ -621,6 +654,7 @@ private:
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
 	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
+	std::shared_ptr<ParsedSourceCache> m_parsedSourceCache;
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
@@ -631,6 +665,9 @@ private:
 	State m_stackState = Empty;
 	CompilationSourceType m_compilationSourceType = CompilationSourceType::Solidity;
 	MetadataFormat m_metadataFormat = defaultMetadataFormat();
+	/// Workers for parsing and checking sources concurrently, shared by all compilations of this
+	/// stack so that the threads are only started once.
+	util::ThreadPool m_threadPool;
 };
 
 }
@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/ParsedSourceCache.h>
+
+#include <libsolidity/ast/AST.h>
+
+#include <liblangutil/CharStream.h>
+
+#include <libsolutil/Keccak256.h>
+
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+h256 ParsedSourceCache::key(
+	CharStream const& _source,
+	EVMVersion _evmVersion,
+	std::optional<uint8_t> _eofVersion
+)
+{
+	bytes rawKey;
+	rawKey += keccak256(_source.name()).asBytes();
+	rawKey += keccak256(_source.source()).asBytes();
+	rawKey += keccak256(_evmVersion.name()).asBytes();
+	rawKey += FixedHash<1>(_eofVersion.value_or(0)).asBytes();
+	return keccak256(rawKey);
+}
+
+std::optional<ParsedSourceCache::CachedSource> ParsedSourceCache::acquire(h256 const& _key)
+{
+	auto [begin, end] = m_entries.equal_range(_key);
+	for (auto it = begin; it != end; ++it)
+	{
+		Entry& entry = it->second;
+		// Analysis results are stored in the AST itself, so it cannot be shared by multiple compilations.
+		if (entry.source.ast.use_count() > 1)
+			continue;
+
+		for (ASTNode* node: entry.source.nodes)
+			node->resetAnnotation();
+		entry.lastUse = ++m_useCounter;
+		return entry.source;
+	}
+	return std::nullopt;
+}
+
+void ParsedSourceCache::store(h256 const& _key, CachedSource _source)
+{
+	solAssert(_source.ast);
+	// Assume that each node occupies about as much memory as an identifier with its annotation.
+	size_t const approximateMemoryUsage = _source.nodes.size() * (sizeof(Identifier) + sizeof(IdentifierAnnotation));
+	m_entries.emplace(_key, Entry{std::move(_source), ++m_useCounter, approximateMemoryUsage});
+	m_approximateMemoryUsage += approximateMemoryUsage;
+	if (m_entries.size() > m_maxEntries)
+		evict();
+}
+
+void ParsedSourceCache::evict()
+{
+	while (m_entries.size() > m_maxEntries)
+	{
+		auto leastRecentlyUsed = m_entries.end();
+		for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+			if (
+				it->second.source.ast.use_count() == 1 &&
+				(leastRecentlyUsed == m_entries.end() || it->second.lastUse < leastRecentlyUsed->second.lastUse)
+			)
+				leastRecentlyUsed = it;
+		if (leastRecentlyUsed == m_entries.end())
+			// Everything is in use, nothing can be evicted for now.
+			return;
+		m_approximateMemoryUsage -= leastRecentlyUsed->second.approximateMemoryUsage;
+		m_entries.erase(leastRecentlyUsed);
+	}
+}
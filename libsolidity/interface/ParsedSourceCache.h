@@ -0,0 +1,113 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache of parsed source units shared by consecutive compilations.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace solidity::langutil
+{
+class CharStream;
+}
+
+namespace solidity::frontend
+{
+
+/**
+ * Keeps the ASTs of parsed source units so that later compilations of the same sources can skip
+ * scanning and parsing them.
+ *
+ * Entries are keyed by the name and content of the source and the parser settings. Since node IDs
+ * depend on the sources parsed before, the IDs of a cached AST are shifted to the range the parser
+ * would have used when it is reused.
+ *
+ * A cached AST is handed out to at most one compilation at a time, i.e. only if no other
+ * compilation still refers to it. Its annotations are discarded before it is handed out again.
+ * There can be several entries for the same key, so that compilations that are alive at the
+ * same time can each reuse their own copy of an unchanged source.
+ *
+ * Since ASTs contain YulStrings, the cache has to be cleared whenever
+ * yul::YulStringRepository is reset.
+ */
+class ParsedSourceCache
+{
+public:
+	struct CachedSource
+	{
+		ASTPointer<SourceUnit> ast;
+		/// All nodes of the AST, as returned by Parser::parsedNodes().
+		std::vector<ASTNode*> nodes;
+		/// Number of IDs the parser assigned while parsing the source, including the IDs of
+		/// discarded nodes. Since the source unit is created last, its ID is the largest one.
+		int64_t numIDs = 0;
+	};
+
+	explicit ParsedSourceCache(size_t _maxEntries = 1024): m_maxEntries(_maxEntries) {}
+
+	static util::h256 key(
+		langutil::CharStream const& _source,
+		langutil::EVMVersion _evmVersion,
+		std::optional<uint8_t> _eofVersion
+	);
+
+	/// @returns an AST stored under @a _key, stripped of all annotations, or nullopt
+	/// if there is none or all of them are still in use by other compilations.
+	std::optional<CachedSource> acquire(util::h256 const& _key);
+	/// Stores a freshly parsed AST in addition to the ones already stored under @a _key.
+	/// Evicts the least recently used entries not in use if the cache grows beyond its size limit.
+	void store(util::h256 const& _key, CachedSource _source);
+
+	size_t size() const { return m_entries.size(); }
+	/// @returns a rough estimate of the number of bytes occupied by the cached ASTs.
+	size_t approximateMemoryUsage() const { return m_approximateMemoryUsage; }
+	void clear()
+	{
+		m_entries.clear();
+		m_approximateMemoryUsage = 0;
+	}
+
+private:
+	struct Entry
+	{
+		CachedSource source;
+		uint64_t lastUse = 0;
+		size_t approximateMemoryUsage = 0;
+	};
+
+	void evict();
+
+	size_t m_maxEntries = 0;
+	uint64_t m_useCounter = 0;
+	size_t m_approximateMemoryUsage = 0;
+	std::multimap<util::h256, Entry> m_entries;
+};
+
+}
@@ -25,6 +25,7 @@
 #include <libsolidity/interface/ImportRemapper.h>
 
 #include <libsolidity/ast/ASTJsonExporter.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libyul/YulStack.h>
 #include <libyul/Exceptions.h>
 #include <libyul/optimiser/Suite.h>
@@ -1347,7 +1348,9 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 {
 	solAssert(_inputsAndSettings.jsonSources.empty());
 
-	CompilerStack compilerStack(m_readFile);
+	CompilerStack compilerStack(m_readFile, m_objectOptimizer);
+	if (m_parsedSourceCache)
+		compilerStack.setParsedSourceCache(m_parsedSourceCache);
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
 	if (_inputsAndSettings.language == "Solidity")
@@ -1494,7 +1497,11 @@ Json StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inpu
 			Json sourceResult;
 			sourceResult["id"] = sourceIndex++;
 			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+			{
+				// The exporter creates types (e.g. for function selectors), which have to belong to the compilation.
+				TypeProvider::ScopedInstance typeProviderScope{compilerStack.typeProvider()};
 				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+			}
 			output["sources"][sourceName] = sourceResult;
 		}
 
@@ -1691,7 +1698,9 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		_inputsAndSettings.optimiserSettings,
 		_inputsAndSettings.debugInfoSelection.has_value() ?
 			_inputsAndSettings.debugInfoSelection.value() :
-			DebugInfoSelection::Default()
+			DebugInfoSelection::Default(),
+		nullptr /* _soliditySourceProvider */,
+		m_objectOptimizer
 	);
 	std::string const& sourceName = _inputsAndSettings.sources.begin()->first;
 	std::string const& sourceContents = _inputsAndSettings.sources.begin()->second;
@@ -1797,7 +1806,8 @@ Json StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json StandardCompiler::compile(Json const& _input) noexcept
 {
-	YulStringRepository::reset();
+	if (!m_objectOptimizer && !m_parsedSourceCache)
+		YulStringRepository::reset();
 
 	try
 	{
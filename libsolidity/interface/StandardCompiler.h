@@ -49,10 +49,18 @@ public:
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
+	/// @param _objectOptimizer cache of optimized Yul objects to be kept across calls to compile().
+	/// @param _parsedSourceCache cache of parsed sources to be kept across calls to compile().
+	/// Since the caches refer to YulStrings, compile() does not reset YulStringRepository if
+	/// any of them is provided. The caller has to clear the caches whenever it resets the repository.
 	explicit StandardCompiler(ReadCallback::Callback _readFile = ReadCallback::Callback(),
-		util::JsonFormat const& _format = {}):
+		util::JsonFormat const& _format = {},
+		std::shared_ptr<yul::ObjectOptimizer> _objectOptimizer = nullptr,
+		std::shared_ptr<ParsedSourceCache> _parsedSourceCache = nullptr):
 		m_readFile(std::move(_readFile)),
-		m_jsonPrintingFormat(std::move(_format))
+		m_jsonPrintingFormat(std::move(_format)),
+		m_objectOptimizer(std::move(_objectOptimizer)),
+		m_parsedSourceCache(std::move(_parsedSourceCache))
 	{
 	}
 
@@ -103,6 +111,9 @@ private:
 	ReadCallback::Callback m_readFile;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	std::shared_ptr<yul::ObjectOptimizer> m_objectOptimizer;
+	std::shared_ptr<ParsedSourceCache> m_parsedSourceCache;
 };
 
 }
@@ -0,0 +1,191 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/lsp/ASTIndex.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTUtils.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <range/v3/view/map.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::lsp;
+
+/// Records the nodes of a source unit and the references in it.
+class ASTIndex::Builder: public ASTConstVisitor
+{
+public:
+	Builder(ASTIndex& _index, SourceUnit const& _sourceUnit):
+		m_index(_index),
+		m_sourceUnit(_sourceUnit),
+		m_nodes(_index.m_sourceUnits[&_sourceUnit].nodes)
+	{}
+
+	bool visit(ImportDirective const& _importDirective) override
+	{
+		for (ImportDirective::SymbolAlias const& symbolAlias: _importDirective.symbolAliases())
+			addReference(symbolAlias.symbol->annotation().referencedDeclaration, _importDirective);
+		return visitNode(_importDirective);
+	}
+
+	bool visit(IdentifierPath const& _identifierPath) override
+	{
+		for (Declaration const* declaration: _identifierPath.annotation().pathDeclarations)
+			addReference(declaration, _identifierPath);
+		return visitNode(_identifierPath);
+	}
+
+	bool visit(InlineAssembly const& _inlineAssembly) override
+	{
+		for (auto const& externalReference: _inlineAssembly.annotation().externalReferences | ranges::views::values)
+			addReference(externalReference.declaration, _inlineAssembly);
+		return visitNode(_inlineAssembly);
+	}
+
+	bool visit(FunctionCall const& _functionCall) override
+	{
+		// Named arguments refer to the parameters of the called function.
+		if (
+			auto const* functionType = dynamic_cast<FunctionType const*>(_functionCall.expression().annotation().type);
+			functionType && functionType->hasDeclaration()
+		)
+			if (auto const* functionDefinition = dynamic_cast<FunctionDefinition const*>(&functionType->declaration()))
+				for (ASTPointer<ASTString> const& name: _functionCall.names())
+					for (ASTPointer<VariableDeclaration> const& parameter: functionDefinition->parameters())
+						if (name && parameter && parameter->name() == *name)
+							addReference(parameter.get(), _functionCall);
+		return visitNode(_functionCall);
+	}
+
+	bool visit(MemberAccess const& _memberAccess) override
+	{
+		addReference(_memberAccess.annotation().referencedDeclaration, _memberAccess);
+		return visitNode(_memberAccess);
+	}
+
+	bool visit(Identifier const& _identifier) override
+	{
+		addReference(_identifier.annotation().referencedDeclaration, _identifier);
+		return visitNode(_identifier);
+	}
+
+protected:
+	bool visitNode(ASTNode const& _node) override
+	{
+		// The root is its own parent.
+		m_nodes.push_back({&_node, m_path.empty() ? 0 : m_path.back()});
+		m_path.push_back(m_nodes.size() - 1);
+		return true;
+	}
+
+	void endVisitNode(ASTNode const&) override
+	{
+		m_path.pop_back();
+	}
+
+private:
+	void addReference(Declaration const* _declaration, ASTNode const& _node)
+	{
+		if (!_declaration)
+			return;
+		std::vector<Reference>& references = m_index.m_references[_declaration];
+		// References of the same node are added one after the other.
+		if (references.empty() || references.back().node != &_node)
+			references.push_back({&m_sourceUnit, &_node});
+	}
+
+	ASTIndex& m_index;
+	SourceUnit const& m_sourceUnit;
+	std::vector<Node>& m_nodes;
+	/// Positions of the nodes that are currently being visited.
+	std::vector<size_t> m_path;
+};
+
+ASTIndex::ASTIndex(CompilerStack const& _compilerStack)
+{
+	for (std::string const& sourceName: _compilerStack.sourceNames())
+	{
+		SourceUnit const& sourceUnit = _compilerStack.ast(sourceName);
+		Builder builder(*this, sourceUnit);
+		sourceUnit.accept(builder);
+
+		SourceUnitIndex& index = m_sourceUnits.at(&sourceUnit);
+		for (size_t position = 0; position < index.nodes.size(); ++position)
+			if (index.nodes[position].node->location().hasText())
+				index.byStart.push_back(position);
+		std::sort(index.byStart.begin(), index.byStart.end(), [&](size_t _a, size_t _b) {
+			langutil::SourceLocation const& a = index.nodes[_a].node->location();
+			langutil::SourceLocation const& b = index.nodes[_b].node->location();
+			// Outer nodes first, which are visited before the nodes they contain.
+			return std::make_tuple(a.start, -a.end, _a) < std::make_tuple(b.start, -b.end, _b);
+		});
+	}
+}
+
+ASTNode const* ASTIndex::innermostNode(SourceUnit const& _sourceUnit, int _offset) const
+{
+	auto sourceUnitIndex = m_sourceUnits.find(&_sourceUnit);
+	if (sourceUnitIndex == m_sourceUnits.end())
+		return locateInnermostASTNode(_offset, _sourceUnit);
+	std::vector<Node> const& nodes = sourceUnitIndex->second.nodes;
+	std::vector<size_t> const& byStart = sourceUnitIndex->second.byStart;
+
+	auto const containsOffset = [&](size_t _position) {
+		return nodes[_position].node->location().containsOffset(_offset);
+	};
+
+	// Since the location of a node covers the locations of all nodes it contains, the innermost
+	// node containing the offset is either the last node starting at or before the offset or one
+	// of the nodes containing that node.
+	auto next = std::upper_bound(byStart.begin(), byStart.end(), _offset, [&](int _value, size_t _position) {
+		return _value < nodes[_position].node->location().start;
+	});
+	if (next == byStart.begin())
+		return nullptr;
+	size_t position = *std::prev(next);
+	while (!containsOffset(position))
+	{
+		if (position == 0)
+			return nullptr;
+		position = nodes[position].parent;
+	}
+
+	// The search through the AST only enters nodes containing the offset. Fall back to it
+	// if the node found here is not reachable that way.
+	for (size_t ancestor = position; ancestor != 0;)
+	{
+		ancestor = nodes[ancestor].parent;
+		if (!containsOffset(ancestor))
+			return locateInnermostASTNode(_offset, _sourceUnit);
+	}
+	return nodes[position].node;
+}
+
+std::vector<ASTIndex::Reference> const& ASTIndex::references(Declaration const& _declaration) const
+{
+	static std::vector<Reference> const noReferences;
+	auto it = m_references.find(&_declaration);
+	return it == m_references.end() ? noReferences : it->second;
+}
@@ -0,0 +1,92 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Index over the analyzed ASTs used to answer requests of the language server.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/ASTForward.h>
+
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::frontend
+{
+class CompilerStack;
+}
+
+namespace solidity::lsp
+{
+
+/**
+ * Index over all source units of a compilation that passed analysis, built once after the
+ * analysis so that requests do not have to walk the ASTs.
+ *
+ * For every source unit, the nodes are stored sorted by the start of their location, together
+ * with their parent, which allows finding the innermost node at an offset with a binary search.
+ * In addition, the index maps every declaration to the nodes referring to it.
+ */
+class ASTIndex
+{
+public:
+	/// A node referring to a declaration and the source unit it is part of.
+	struct Reference
+	{
+		frontend::SourceUnit const* sourceUnit = nullptr;
+		frontend::ASTNode const* node = nullptr;
+	};
+
+	explicit ASTIndex(frontend::CompilerStack const& _compilerStack);
+
+	/// @returns the innermost node of @a _sourceUnit whose location contains @a _offset,
+	/// i.e. the same node as locateInnermostASTNode, or nullptr if there is none.
+	frontend::ASTNode const* innermostNode(frontend::SourceUnit const& _sourceUnit, int _offset) const;
+
+	/// @returns the identifiers, member accesses, identifier paths, import directives,
+	/// function calls with named arguments and inline assembly blocks referring to @a _declaration.
+	/// Every node is contained at most once.
+	std::vector<Reference> const& references(frontend::Declaration const& _declaration) const;
+
+private:
+	class Builder;
+
+	struct Node
+	{
+		frontend::ASTNode const* node = nullptr;
+		/// Position of the parent node in the list of nodes of the source unit.
+		size_t parent = 0;
+	};
+	struct SourceUnitIndex
+	{
+		/// All nodes of the source unit in the order in which they are visited.
+		std::vector<Node> nodes;
+		/// Positions in @a nodes of the nodes with a location, sorted by the start of the location,
+		/// outer nodes first.
+		std::vector<size_t> byStart;
+	};
+
+	void addReference(frontend::Declaration const* _declaration, frontend::SourceUnit const& _sourceUnit, frontend::ASTNode const& _node);
+
+	std::map<frontend::SourceUnit const*, SourceUnitIndex> m_sourceUnits;
+	std::unordered_map<frontend::Declaration const*, std::vector<Reference>> m_references;
+};
+
+}
@@ -18,6 +18,8 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/ASTUtils.h>
 #include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/interface/ParsedSourceCache.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/lsp/LanguageServer.h>
@@ -43,6 +45,8 @@
 
 #include <ostream>
 #include <string>
+#include <tuple>
+#include <utility>
 
 #include <fmt/format.h>
 
@@ -86,6 +90,78 @@ int toDiagnosticSeverity(Error::Type _errorType)
 	return -1;
 }
 
+/// Number of integers that encode a single semantic token.
+size_t constexpr semanticTokenSize = 5;
+
+/// @returns the edits that turn the encoded semantic tokens @a _old into @a _new.
+/// Since token positions are encoded relative to the preceding token, changes to a document
+/// usually only affect a contiguous range of tokens, which is replaced by a single edit.
+Json semanticTokensEdits(std::vector<int> const& _old, std::vector<int> const& _new)
+{
+	size_t prefix = 0;
+	while (prefix < _old.size() && prefix < _new.size() && _old[prefix] == _new[prefix])
+		++prefix;
+	size_t suffix = 0;
+	while (
+		suffix < _old.size() - prefix &&
+		suffix < _new.size() - prefix &&
+		_old[_old.size() - 1 - suffix] == _new[_new.size() - 1 - suffix]
+	)
+		++suffix;
+	// Only replace whole tokens.
+	prefix -= prefix % semanticTokenSize;
+	suffix -= suffix % semanticTokenSize;
+
+	Json edits = Json::array();
+	if (prefix == _old.size() && prefix == _new.size())
+		return edits;
+
+	Json edit;
+	edit["start"] = prefix;
+	edit["deleteCount"] = _old.size() - prefix - suffix;
+	edit["data"] = std::vector<int>(
+		_new.begin() + static_cast<std::ptrdiff_t>(prefix),
+		_new.end() - static_cast<std::ptrdiff_t>(suffix)
+	);
+	edits.emplace_back(std::move(edit));
+	return edits;
+}
+
+/// @returns the encoded semantic tokens of @a _tokens that start inside the
+/// range from @a _start (inclusive) to @a _end (exclusive).
+std::vector<int> semanticTokensInRange(std::vector<int> const& _tokens, LineColumn const& _start, LineColumn const& _end)
+{
+	auto const before = [](int _line, int _column, LineColumn const& _position) {
+		return std::tie(_line, _column) < std::tie(_position.line, _position.column);
+	};
+
+	std::vector<int> result;
+	int line = 0;
+	int column = 0;
+	int lastLine = 0;
+	int lastColumn = 0;
+	for (size_t i = 0; i + semanticTokenSize <= _tokens.size(); i += semanticTokenSize)
+	{
+		column = _tokens[i] == 0 ? column + _tokens[i + 1] : _tokens[i + 1];
+		line += _tokens[i];
+		if (before(line, column, _start))
+			continue;
+		if (!before(line, column, _end))
+			break;
+
+		result.push_back(line - lastLine);
+		result.push_back(line == lastLine ? column - lastColumn : column);
+		result.insert(
+			result.end(),
+			_tokens.begin() + static_cast<std::ptrdiff_t>(i + 2),
+			_tokens.begin() + static_cast<std::ptrdiff_t>(i + semanticTokenSize)
+		);
+		lastLine = line;
+		lastColumn = column;
+	}
+	return result;
+}
+
 Json semanticTokensLegend()
 {
 	Json legend;
@@ -129,13 +205,19 @@ Json semanticTokensLegend()
 	return legend;
 }
 
+/// Time to wait for further changes before compiling a changed document.
+std::chrono::milliseconds constexpr compilationDelayAfterChange{100};
+
 }
 
 LanguageServer::LanguageServer(Transport& _transport):
 	m_client{_transport},
 	m_handlers{
-		{"$/cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
-		{"cancelRequest", [](auto, auto) {/*nothing for now as we are synchronous */}},
+		// Requests are answered as soon as they are handled, so there is nothing left to cancel
+		// by the time the cancellation is handled. Compilations are abandoned once they are
+		// superseded, without the client having to ask for it.
+		{"$/cancelRequest", [](auto, auto) {}},
+		{"cancelRequest", [](auto, auto) {}},
 		{"exit", [this](auto, auto) { m_state = (m_state == State::ShutdownRequested ? State::ExitRequested : State::ExitWithoutShutdown); }},
 		{"initialize", std::bind(&LanguageServer::handleInitialize, this, _1, _2)},
 		{"initialized", std::bind(&LanguageServer::handleInitialized, this, _1, _2)},
@@ -149,21 +231,51 @@ LanguageServer::LanguageServer(Transport& _transport):
 		{"textDocument/rename", RenameSymbol(*this) },
 		{"textDocument/implementation", GotoDefinition(*this) },
 		{"textDocument/semanticTokens/full", std::bind(&LanguageServer::semanticTokensFull, this, _1, _2)},
+		{"textDocument/semanticTokens/full/delta", std::bind(&LanguageServer::semanticTokensFullDelta, this, _1, _2)},
+		{"textDocument/semanticTokens/range", std::bind(&LanguageServer::semanticTokensRange, this, _1, _2)},
 		{"workspace/didChangeConfiguration", std::bind(&LanguageServer::handleWorkspaceDidChangeConfiguration, this, _2)},
 	},
 	m_fileRepository("/" /* basePath */, {} /* no search paths */),
-	m_compilerStack{m_fileRepository.reader()}
+	m_analyzed(std::make_unique<Compilation>(m_fileRepository)),
+	m_nextCompilation(std::make_unique<Compilation>(m_fileRepository))
 {
+	// Files that have not been edited since the last compilation do not have to be parsed again.
+	// The cache is shared by both compilations, since the sources of the compilation read
+	// requests are answered from are still in use while the next one is compiled.
+	auto parsedSourceCache = std::make_shared<ParsedSourceCache>();
+	m_analyzed->compilerStack.setParsedSourceCache(parsedSourceCache);
+	m_nextCompilation->compilerStack.setParsedSourceCache(parsedSourceCache);
 }
 
-Json LanguageServer::toRange(SourceLocation const& _location)
+LanguageServer::~LanguageServer()
 {
-	return HandlerBase(*this).toRange(_location);
+	{
+		std::lock_guard lock(m_mutex);
+		m_stopping = true;
+	}
+	m_compilationRequested.notify_all();
 }
 
-Json LanguageServer::toJson(SourceLocation const& _location)
+Json LanguageServer::toRange(Compilation const& _compilation, SourceLocation const& _location)
 {
-	return HandlerBase(*this).toJson(_location);
+	if (!_location.hasText())
+		return toJsonRange({}, {});
+
+	solAssert(_location.sourceName);
+	CharStream const& stream = _compilation.compilerStack.charStream(*_location.sourceName);
+	return toJsonRange(
+		stream.translatePositionToLineColumn(_location.start),
+		stream.translatePositionToLineColumn(_location.end)
+	);
+}
+
+Json LanguageServer::toJson(Compilation const& _compilation, SourceLocation const& _location)
+{
+	solAssert(_location.sourceName);
+	Json item;
+	item["uri"] = _compilation.files.sourceUnitNameToUri(*_location.sourceName);
+	item["range"] = toRange(_compilation, _location);
+	return item;
 }
 
 void LanguageServer::changeConfiguration(Json const& _settings)
@@ -214,7 +326,7 @@ void LanguageServer::changeConfiguration(Json const& _settings)
 	}
 }
 
-std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject() const
+std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject(fs::path const& _basePath)
 {
 	std::vector<fs::path> collectedPaths{};
 
@@ -222,9 +334,9 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	// open for a future PR to enable such a feature to be optionally enabled (default disabled).
 	// Note: Newer versions of boost have deprecated symlink_option::recurse
 #if (BOOST_VERSION < 107200)
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::symlink_option::recurse);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::symlink_option::recurse);
 #else
-	auto directoryIterator = fs::recursive_directory_iterator(m_fileRepository.basePath(), fs::directory_options::follow_directory_symlink);
+	auto directoryIterator = fs::recursive_directory_iterator(_basePath, fs::directory_options::follow_directory_symlink);
 #endif
 	for (fs::directory_entry const& dirEntry: directoryIterator)
 		if (
@@ -236,52 +348,142 @@ std::vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject
 	return collectedPaths;
 }
 
-void LanguageServer::compile()
+void LanguageServer::requestCompilation(std::chrono::milliseconds _delay)
+{
+	++m_requestedGeneration;
+	m_compilationDue = std::chrono::steady_clock::now() + _delay;
+	m_compilationRequested.notify_all();
+}
+
+void LanguageServer::startCompilation()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		if (m_compilationThreadRunning || m_finishedGeneration == m_requestedGeneration)
+			return;
+		m_compilationThreadRunning = true;
+	}
+	m_compilationThread.submit([this]() { compileRequestedSources(); });
+}
+
+void LanguageServer::waitForCompilation(std::unique_lock<std::mutex>& _lock)
 {
-	// For files that are not open, we have to take changes on disk into account,
-	// so we just remove all non-open files.
+	// Nothing else is handled while waiting, so there is no point in waiting for further changes.
+	m_compilationDue = std::chrono::steady_clock::now();
+	m_compilationRequested.notify_all();
+	m_compilationFinished.wait(_lock, [&]() {
+		return m_stopping || !m_compilationThreadRunning || m_finishedGeneration == m_requestedGeneration;
+	});
+}
 
-	FileRepository oldRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
-	std::swap(oldRepository, m_fileRepository);
+void LanguageServer::compileAndUpdateDiagnostics()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		requestCompilation();
+	}
+	startCompilation();
+	std::unique_lock lock(m_mutex);
+	waitForCompilation(lock);
+}
 
-	// Load all solidity files from project.
-	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
-		for (auto const& projectFile: allSolidityFilesFromProject())
-		{
-			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
-			m_fileRepository.setSourceByUri(
-				m_fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
-				util::readFileAsString(projectFile)
+bool LanguageServer::superseded(uint64_t _generation)
+{
+	std::lock_guard lock(m_mutex);
+	return _generation != m_requestedGeneration;
+}
+
+void LanguageServer::compileRequestedSources()
+{
+	std::unique_lock lock(m_mutex);
+	while (!m_stopping && m_finishedGeneration != m_requestedGeneration)
+	{
+		while (!m_stopping && std::chrono::steady_clock::now() < m_compilationDue)
+			m_compilationRequested.wait_until(lock, m_compilationDue);
+		if (m_stopping)
+			break;
+
+		uint64_t const generation = m_requestedGeneration;
+		bool const loadProjectFiles = m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory;
+		// For files that are not open, we have to take changes on disk into account,
+		// so we start with the open files only.
+		Compilation& compilation = *m_nextCompilation;
+		compilation.files = FileRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
+		for (std::string const& fileName: m_openFiles)
+			compilation.files.setSourceByUri(
+				fileName,
+				m_fileRepository.sourceUnits().at(m_fileRepository.uriToSourceUnitName(fileName))
 			);
-		}
 
-	// Overwrite all files as opened by the client, including the ones which might potentially have changes.
-	for (std::string const& fileName: m_openFiles)
-		m_fileRepository.setSourceByUri(
-			fileName,
-			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
-		);
+		lock.unlock();
+		bool compiled = false;
+		try
+		{
+			compile(compilation, generation, loadProjectFiles);
+			compiled = true;
+		}
+		catch (...)
+		{
+			m_client.error({}, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
+		}
+		lock.lock();
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+		if (generation != m_requestedGeneration)
+			// The sources changed in the meantime, a newer compilation will report the results.
+			continue;
 
-	m_compilerStack.reset(false);
-	m_compilerStack.setSources(m_fileRepository.sourceUnits());
-	m_compilerStack.compile(CompilerStack::State::AnalysisSuccessful);
+		m_finishedGeneration = generation;
+		m_latestAnalysisSuccessful = compiled && compilation.compilerStack.state() >= CompilerStack::AnalysisSuccessful;
+		if (compiled)
+		{
+			m_fileRepository = compilation.files;
+			updateDiagnostics(compilation);
+			// Keep answering requests from the previous compilation if only that one passed analysis.
+			if (m_latestAnalysisSuccessful || m_analyzed->compilerStack.state() < CompilerStack::AnalysisSuccessful)
+				std::swap(m_analyzed, m_nextCompilation);
+		}
+		m_compilationFinished.notify_all();
+	}
+	m_compilationThreadRunning = false;
+	m_compilationFinished.notify_all();
 }
 
-void LanguageServer::compileAndUpdateDiagnostics()
+void LanguageServer::compile(Compilation& _compilation, uint64_t _generation, bool _loadProjectFiles)
 {
-	compile();
+	FileRepository& files = _compilation.files;
 
+	// Load all solidity files from project, unless they are open in the client.
+	if (_loadProjectFiles)
+		for (auto const& projectFile: allSolidityFilesFromProject(files.basePath()))
+		{
+			std::string const uri = files.sourceUnitNameToUri(projectFile.generic_string());
+			if (files.sourceUnits().count(files.uriToSourceUnitName(uri)))
+				continue;
+			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
+			files.setSourceByUri(uri, util::readFileAsString(projectFile));
+		}
+
+	CompilerStack& compilerStack = _compilation.compilerStack;
+	_compilation.astIndex.reset();
+	_compilation.semanticTokens.clear();
+	compilerStack.reset(false);
+	compilerStack.setSources(files.sourceUnits());
+	// Analysis takes much longer than parsing, so it is skipped if the sources changed in the meantime.
+	if (compilerStack.parse() && !superseded(_generation) && compilerStack.analyze())
+		_compilation.astIndex = std::make_unique<ASTIndex>(compilerStack);
+}
+
+void LanguageServer::updateDiagnostics(Compilation const& _compilation)
+{
 	// These are the source units we will sent diagnostics to the client for sure,
 	// even if it is just to clear previous diagnostics.
 	std::map<std::string, Json> diagnosticsBySourceUnit;
-	for (std::string const& sourceUnitName: m_fileRepository.sourceUnits() | ranges::views::keys)
+	for (std::string const& sourceUnitName: _compilation.files.sourceUnits() | ranges::views::keys)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
 	for (std::string const& sourceUnitName: m_nonemptyDiagnostics)
 		diagnosticsBySourceUnit[sourceUnitName] = Json::array();
 
-	for (std::shared_ptr<Error const> const& error: m_compilerStack.errors())
+	for (std::shared_ptr<Error const> const& error: _compilation.compilerStack.errors())
 	{
 		SourceLocation const* location = error->sourceLocation();
 		if (!location || !location->sourceName)
@@ -296,14 +498,14 @@ void LanguageServer::compileAndUpdateDiagnostics()
 		if (std::string const* comment = error->comment())
 			message += " " + *comment;
 		jsonDiag["message"] = std::move(message);
-		jsonDiag["range"] = toRange(*location);
+		jsonDiag["range"] = toRange(_compilation, *location);
 
 		if (auto const* secondary = error->secondarySourceLocation())
 			for (auto&& [secondaryMessage, secondaryLocation]: secondary->infos)
 			{
 				Json jsonRelated;
 				jsonRelated["message"] = secondaryMessage;
-				jsonRelated["location"] = toJson(secondaryLocation);
+				jsonRelated["location"] = toJson(_compilation, secondaryLocation);
 				jsonDiag["relatedInformation"].emplace_back(jsonRelated);
 			}
 
@@ -321,7 +523,7 @@ void LanguageServer::compileAndUpdateDiagnostics()
 	for (auto&& [sourceUnitName, diagnostics]: diagnosticsBySourceUnit)
 	{
 		Json params;
-		params["uri"] = m_fileRepository.sourceUnitNameToUri(sourceUnitName);
+		params["uri"] = _compilation.files.sourceUnitNameToUri(sourceUnitName);
 		if (!diagnostics.empty())
 			m_nonemptyDiagnostics.insert(sourceUnitName);
 		params["diagnostics"] = std::move(diagnostics);
@@ -348,7 +550,17 @@ bool LanguageServer::run()
 				lspDebug(fmt::format("received method call: {}", methodName));
 
 				if (auto handler = util::valueOrDefault(m_handlers, methodName))
+				{
+					std::unique_lock lock(m_mutex);
+					// Renaming edits the sources, so it cannot work on outdated analysis results.
+					if (methodName == "textDocument/rename")
+					{
+						waitForCompilation(lock);
+						lspRequire(m_latestAnalysisSuccessful, ErrorCode::RequestFailed, "Sources could not be analyzed.");
+					}
+					TypeProvider::ScopedInstance typeProviderScope{compilerStack().typeProvider()};
 					handler(id, (*jsonMessage)["params"]);
+				}
 				else
 					m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
 			}
@@ -367,6 +579,7 @@ bool LanguageServer::run()
 		{
 			m_client.error(id, ErrorCode::InternalError, "Unhandled exception: "s + boost::current_exception_diagnostic_information());
 		}
+		startCompilation();
 	}
 	return m_state == State::ExitRequested;
 }
@@ -421,8 +634,8 @@ void LanguageServer::handleInitialize(MessageID _id, Json const& _args)
 	replyArgs["capabilities"]["textDocumentSync"]["change"] = 2; // 0=none, 1=full, 2=incremental
 	replyArgs["capabilities"]["textDocumentSync"]["openClose"] = true;
 	replyArgs["capabilities"]["semanticTokensProvider"]["legend"] = semanticTokensLegend();
-	replyArgs["capabilities"]["semanticTokensProvider"]["range"] = false;
-	replyArgs["capabilities"]["semanticTokensProvider"]["full"] = true; // XOR requests.full.delta = true
+	replyArgs["capabilities"]["semanticTokensProvider"]["range"] = true;
+	replyArgs["capabilities"]["semanticTokensProvider"]["full"]["delta"] = true;
 	replyArgs["capabilities"]["renameProvider"] = true;
 	replyArgs["capabilities"]["hoverProvider"] = true;
 
@@ -432,29 +645,90 @@ void LanguageServer::handleInitialize(MessageID _id, Json const& _args)
 void LanguageServer::handleInitialized(MessageID, Json const&)
 {
 	if (m_fileLoadStrategy == FileLoadStrategy::ProjectDirectory)
-		compileAndUpdateDiagnostics();
+		requestCompilation();
+}
+
+std::vector<int> const& LanguageServer::semanticTokens(Json const& _args)
+{
+	lspRequire(
+		_args.contains("textDocument") && _args["textDocument"].contains("uri"),
+		ErrorCode::InvalidParams,
+		"Invalid parameter: textDocument.uri expected."
+	);
+	std::string const uri = _args["textDocument"]["uri"].get<std::string>();
+	std::string const sourceName = m_fileRepository.uriToSourceUnitName(uri);
+	lspRequire(
+		compilerStack().state() >= CompilerStack::AnalysisSuccessful &&
+		m_analyzed->files.sourceUnits().count(sourceName),
+		ErrorCode::RequestFailed,
+		"No analysis results available for " + uri
+	);
+
+	auto [tokens, inserted] = m_analyzed->semanticTokens.try_emplace(sourceName);
+	if (inserted)
+		tokens->second = SemanticTokensBuilder().build(
+			compilerStack().ast(sourceName),
+			compilerStack().charStream(sourceName)
+		).get<std::vector<int>>();
+	return tokens->second;
+}
+
+std::string LanguageServer::storeSemanticTokens(std::string const& _uri, std::vector<int> _tokens)
+{
+	std::string resultId = std::to_string(++m_semanticTokensResultCount);
+	m_sentSemanticTokens[_uri] = {resultId, std::move(_tokens)};
+	return resultId;
 }
 
 void LanguageServer::semanticTokensFull(MessageID _id, Json const& _args)
 {
-	if (_args.contains("textDocument") && _args["textDocument"].contains("uri"))
-	{
-		auto uri = _args["textDocument"]["uri"];
+	std::vector<int> const& tokens = semanticTokens(_args);
 
-		compile();
+	Json reply;
+	reply["data"] = tokens;
+	reply["resultId"] = storeSemanticTokens(_args["textDocument"]["uri"].get<std::string>(), tokens);
 
-		auto const sourceName = m_fileRepository.uriToSourceUnitName(uri.get<std::string>());
-		SourceUnit const& ast = m_compilerStack.ast(sourceName);
-		m_compilerStack.charStream(sourceName);
-		Json data = SemanticTokensBuilder().build(ast, m_compilerStack.charStream(sourceName));
+	m_client.reply(_id, std::move(reply));
+}
+
+void LanguageServer::semanticTokensFullDelta(MessageID _id, Json const& _args)
+{
+	std::vector<int> const& tokens = semanticTokens(_args);
+	std::string const uri = _args["textDocument"]["uri"].get<std::string>();
+
+	Json reply;
+	auto previous = m_sentSemanticTokens.find(uri);
+	if (
+		previous != m_sentSemanticTokens.end() &&
+		_args.contains("previousResultId") &&
+		_args["previousResultId"] == previous->second.first
+	)
+		reply["edits"] = semanticTokensEdits(previous->second.second, tokens);
+	else
+		// The client refers to a result we no longer know of, so it gets the full result instead.
+		reply["data"] = tokens;
+	reply["resultId"] = storeSemanticTokens(uri, tokens);
 
-		Json reply;
-		reply["data"] = data;
+	m_client.reply(_id, std::move(reply));
+}
 
-		m_client.reply(_id, std::move(reply));
+void LanguageServer::semanticTokensRange(MessageID _id, Json const& _args)
+{
+	std::vector<int> const& tokens = semanticTokens(_args);
+
+	std::optional<LineColumn> start;
+	std::optional<LineColumn> end;
+	if (_args.contains("range") && _args["range"].is_object())
+	{
+		start = parseLineColumn(_args["range"]["start"]);
+		end = parseLineColumn(_args["range"]["end"]);
 	}
-	else
-		m_client.error(_id, ErrorCode::InvalidParams, "Invalid parameter: textDocument.uri expected.");
+	lspRequire(start && end, ErrorCode::InvalidParams, "Invalid parameter: range expected.");
+
+	Json reply;
+	reply["data"] = semanticTokensInRange(tokens, *start, *end);
+
+	m_client.reply(_id, std::move(reply));
 }
 
 void LanguageServer::handleWorkspaceDidChangeConfiguration(Json const& _args)
@@ -496,7 +770,7 @@ void LanguageServer::handleTextDocumentDidOpen(Json const& _args)
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.insert(uri);
 		m_fileRepository.setSourceByUri(uri, std::move(text));
-		compileAndUpdateDiagnostics();
+		requestCompilation();
 	}
 }
 
@@ -543,7 +817,7 @@ void LanguageServer::handleTextDocumentDidChange(Json const& _args)
 				}
 			}
 
-		compileAndUpdateDiagnostics();
+		requestCompilation(compilationDelayAfterChange);
 	}
 }
 
@@ -561,8 +835,9 @@ void LanguageServer::handleTextDocumentDidClose(Json const& _args)
 	{
 		std::string uri = _args["textDocument"]["uri"].get<std::string>();
 		m_openFiles.erase(uri);
+		m_sentSemanticTokens.erase(uri);
 
-		compileAndUpdateDiagnostics();
+		requestCompilation();
 	}
 }
 
@@ -573,14 +848,14 @@ ASTNode const* LanguageServer::astNodeAtSourceLocation(std::string const& _sourc
 
 std::tuple<ASTNode const*, int> LanguageServer::astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, LineColumn const& _filePos)
 {
-	if (m_compilerStack.state() < CompilerStack::AnalysisSuccessful)
+	if (compilerStack().state() < CompilerStack::AnalysisSuccessful)
 		return {nullptr, -1};
-	if (!m_fileRepository.sourceUnits().count(_sourceUnitName))
+	if (!m_analyzed->files.sourceUnits().count(_sourceUnitName))
 		return {nullptr, -1};
 
-	std::optional<int> sourcePos = m_compilerStack.charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
+	std::optional<int> sourcePos = compilerStack().charStream(_sourceUnitName).translateLineColumnToPosition(_filePos);
 	if (!sourcePos)
 		return {nullptr, -1};
 
-	return {locateInnermostASTNode(*sourcePos, m_compilerStack.ast(_sourceUnitName)), *sourcePos};
+	return {astIndex().innermostNode(compilerStack().ast(_sourceUnitName), *sourcePos), *sourcePos};
 }
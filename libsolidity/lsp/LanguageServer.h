@@ -17,15 +17,22 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <libsolidity/lsp/ASTIndex.h>
 #include <libsolidity/lsp/Transport.h>
 #include <libsolidity/lsp/FileRepository.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/FileReader.h>
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/ThreadPool.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -57,14 +64,21 @@ enum class FileLoadStrategy
  * Solidity Language Server, managing one LSP client.
  * This implements a subset of LSP version 3.16 that can be found at:
  * https://microsoft.github.io/language-server-protocol/specifications/specification-3-16/
+ *
+ * Messages are handled one after the other, but the project is compiled on a background
+ * thread against a snapshot of the sources. Requests that only read the analysis results are
+ * answered right away from the most recent compilation that passed analysis. A compilation
+ * that is superseded by further changes is abandoned and its results are never published.
  */
 class LanguageServer
 {
 public:
 	/// @param _transport Customizable transport layer.
 	explicit LanguageServer(Transport& _transport);
+	~LanguageServer();
 
-	/// Re-compiles the project and updates the diagnostics pushed to the client.
+	/// Re-compiles the project, waits for the compilation to finish and updates the diagnostics
+	/// pushed to the client.
 	void compileAndUpdateDiagnostics();
 
 	/// Loops over incoming messages via the transport layer until shutdown condition is met.
@@ -79,9 +93,33 @@ public:
 	Transport& client() noexcept { return m_client; }
 	std::tuple<frontend::ASTNode const*, int> astNodeAndOffsetAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
 	frontend::ASTNode const* astNodeAtSourceLocation(std::string const& _sourceUnitName, langutil::LineColumn const& _filePos);
-	frontend::CompilerStack const& compilerStack() const noexcept { return m_compilerStack; }
+	/// @returns the compiler of the most recent compilation that passed analysis or of the most
+	/// recent one if none did.
+	frontend::CompilerStack const& compilerStack() const noexcept { return m_analyzed->compilerStack; }
+	/// @returns the index over the ASTs of compilerStack(). Only available if it passed analysis.
+	ASTIndex const& astIndex() const
+	{
+		solAssert(m_analyzed->astIndex);
+		return *m_analyzed->astIndex;
+	}
 
 private:
+	/// Sources and compiler of a compilation. The compiler loads imported files into @a files.
+	struct Compilation
+	{
+		explicit Compilation(FileRepository _files):
+			files(std::move(_files)),
+			compilerStack(files.reader())
+		{}
+
+		FileRepository files;
+		frontend::CompilerStack compilerStack;
+		/// Set if the compilation passed analysis.
+		std::unique_ptr<ASTIndex> astIndex;
+		/// Encoded semantic tokens per source unit name, computed on first request.
+		std::map<std::string, std::vector<int>> semanticTokens;
+	};
+
 	/// Checks if the server is initialized (to be used by messages that need it to be initialized).
 	/// Reports an error and returns false if not.
 	void requireServerInitialized();
@@ -95,19 +133,44 @@ private:
 	void handleRename(Json const& _args);
 	void handleGotoDefinition(MessageID _id, Json const& _args);
 	void semanticTokensFull(MessageID _id, Json const& _args);
+	void semanticTokensFullDelta(MessageID _id, Json const& _args);
+	void semanticTokensRange(MessageID _id, Json const& _args);
+	/// @returns the encoded semantic tokens of the document referenced by @a _args
+	/// in compilerStack(). They are computed at most once per compilation.
+	std::vector<int> const& semanticTokens(Json const& _args);
+	/// Remembers @a _tokens as the most recent full result sent for @a _uri.
+	/// @returns the result ID the client can refer to in delta requests.
+	std::string storeSemanticTokens(std::string const& _uri, std::vector<int> _tokens);
 
 	/// Invoked when the server user-supplied configuration changes (initiated by the client).
 	void changeConfiguration(Json const&);
 
-	/// Compile everything until after analysis phase.
-	void compile();
-
-	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
+	/// Requests the project to be compiled again, after @a _delay unless there are further changes
+	/// in the meantime. Supersedes any compilation that is still in progress.
+	/// Has to be called with m_mutex locked.
+	void requestCompilation(std::chrono::milliseconds _delay = std::chrono::milliseconds(0));
+	/// Starts the compilation thread if there is a compilation request it does not know of yet.
+	/// Has to be called with m_mutex unlocked.
+	void startCompilation();
+	/// Waits until the compilation of the most recent state of the sources is finished.
+	void waitForCompilation(std::unique_lock<std::mutex>& _lock);
+	/// Runs on the compilation thread until all requested compilations are done.
+	void compileRequestedSources();
+	/// Compile everything until after analysis phase. Gives up after parsing if the
+	/// compilation of @a _generation is superseded in the meantime.
+	/// Runs without m_mutex locked and only accesses @a _compilation.
+	void compile(Compilation& _compilation, uint64_t _generation, bool _loadProjectFiles);
+	/// Publishes the diagnostics of @a _compilation to the client.
+	void updateDiagnostics(Compilation const& _compilation);
+	/// @returns true if @a _generation is not the most recently requested compilation.
+	bool superseded(uint64_t _generation);
+
+	static std::vector<boost::filesystem::path> allSolidityFilesFromProject(boost::filesystem::path const& _basePath);
 
 	using MessageHandler = std::function<void(MessageID, Json const&)>;
 
-	Json toRange(langutil::SourceLocation const& _location);
-	Json toJson(langutil::SourceLocation const& _location);
+	static Json toRange(Compilation const& _compilation, langutil::SourceLocation const& _location);
+	static Json toJson(Compilation const& _compilation, langutil::SourceLocation const& _location);
 
 	// LSP related member fields
 
@@ -121,13 +184,37 @@ private:
 	std::set<std::string> m_openFiles;
 	/// Set of source unit names for which we sent diagnostics to the client in the last iteration.
 	std::set<std::string> m_nonemptyDiagnostics;
+	/// Result ID and data of the semantic tokens last sent in full per document (URI form).
+	std::map<std::string, std::pair<std::string, std::vector<int>>> m_sentSemanticTokens;
+	uint64_t m_semanticTokensResultCount = 0;
 	FileRepository m_fileRepository;
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
 
-	frontend::CompilerStack m_compilerStack;
-
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json m_settingsObject;
+
+	/// Guards all state shared with the compilation thread, which is everything except for
+	/// the compilation the compilation thread is currently working on.
+	/// Messages are handled with the mutex locked.
+	std::mutex m_mutex;
+	/// The compilation read requests are answered from, see compilerStack().
+	std::unique_ptr<Compilation> m_analyzed;
+	/// Compilation that is reused for the next compilation request. Only the compilation thread
+	/// accesses it while a compilation is in progress.
+	std::unique_ptr<Compilation> m_nextCompilation;
+	/// Whether the most recent finished compilation passed analysis.
+	bool m_latestAnalysisSuccessful = false;
+	/// Number of the most recently requested and of the most recently finished compilation.
+	uint64_t m_requestedGeneration = 0;
+	uint64_t m_finishedGeneration = 0;
+	/// Point in time at which the most recently requested compilation can start.
+	std::chrono::steady_clock::time_point m_compilationDue;
+	bool m_compilationThreadRunning = false;
+	bool m_stopping = false;
+	std::condition_variable m_compilationRequested;
+	std::condition_variable m_compilationFinished;
+	/// Runs the compilations, declared last so that it is destroyed first.
+	util::ThreadPool m_compilationThread{1};
 };
 
 }
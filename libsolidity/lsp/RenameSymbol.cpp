@@ -82,10 +82,12 @@ void RenameSymbol::operator()(MessageID _id, Json const& _args)
 	// Origin source unit should always be checked
 	m_sourceUnits.insert(&m_declarationToRename->sourceUnit());
 
+	// Only the declaration itself and the nodes referring to it can contain the symbol.
 	Visitor visitor(*this);
-
-	for (auto const* sourceUnit: m_sourceUnits)
-		sourceUnit->accept(visitor);
+	m_declarationToRename->accept(visitor);
+	for (ASTIndex::Reference const& reference: m_server.astIndex().references(*m_declarationToRename))
+		if (m_sourceUnits.count(reference.sourceUnit))
+			reference.node->accept(visitor);
 
 	// Apply changes in reverse order (will iterate in reverse)
 	sort(m_locations.begin(), m_locations.end());
@@ -35,6 +35,8 @@ protected:
 	struct Visitor: public frontend::ASTConstVisitor
 	{
 		explicit Visitor(RenameSymbol& _outer): m_outer(_outer) {}
+		/// Only the visited node itself is of interest, not the nodes it contains.
+		bool visitNode(frontend::ASTNode const&) override { return false; }
 		void endVisit(frontend::ImportDirective const& _node) override;
 		void endVisit(frontend::MemberAccess const& _node) override;
 		void endVisit(frontend::Identifier const& _node) override;
@@ -23,6 +23,7 @@
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -134,7 +135,11 @@ protected:
 	/// Sends an arbitrary raw message to the client.
 	///
 	/// Used by the notify/reply/error function family.
+	/// Messages can be sent from multiple threads, they are written one after the other.
 	virtual void send(Json _message, MessageID _id = Json{});
+
+private:
+	std::mutex m_sendMutex;
 };
 
 /**
@@ -76,7 +76,9 @@ public:
 		solAssert(m_location.sourceName, "");
 		if (m_location.end < 0)
 			markEndPosition();
-		return std::make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...);
+		return m_parser.registerNode(
+			std::make_shared<NodeType>(m_parser.nextID(), m_location, std::forward<Args>(_args)...)
+		);
 	}
 
 	SourceLocation const& location() const noexcept { return m_location; }
@@ -92,6 +94,8 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	try
 	{
 		m_recursionDepth = 0;
+		m_createdNodes.clear();
+		m_identifiers.clear();
 		m_scanner = std::make_shared<Scanner>(_charStream);
 		ASTNodeFactory nodeFactory(*this);
 		m_experimentalSolidityEnabledInCurrentSourceUnit = false;
@@ -183,6 +187,15 @@ ASTPointer<SourceUnit> Parser::parse(CharStream& _charStream)
 	}
 }
 
+std::vector<ASTNode*> Parser::parsedNodes() const
+{
+	std::vector<ASTNode*> nodes;
+	for (std::weak_ptr<ASTNode> const& createdNode: m_createdNodes)
+		if (std::shared_ptr<ASTNode> node = createdNode.lock())
+			nodes.push_back(node.get());
+	return nodes;
+}
+
 void Parser::parsePragmaVersion(SourceLocation const& _location, std::vector<Token> const& _tokens, std::vector<std::string> const& _literals)
 {
 	SemVerMatchExpressionParser parser(_tokens, _literals);
@@ -1478,7 +1491,7 @@ ASTPointer<InlineAssembly> Parser::parseInlineAssembly(ASTPointer<ASTString> con
 		BOOST_THROW_EXCEPTION(FatalError());
 
 	location.end = nativeLocationOf(ast->root()).end;
-	return std::make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), ast);
+	return registerNode(std::make_shared<InlineAssembly>(nextID(), location, _docString, dialect, std::move(flags), ast));
 }
 
 ASTPointer<IfStatement> Parser::parseIfStatement(ASTPointer<ASTString> const& _docString)
@@ -2756,7 +2769,21 @@ ASTPointer<ASTString> Parser::expectIdentifierTokenOrAddress()
 
 ASTPointer<ASTString> Parser::getLiteralAndAdvance()
 {
-	ASTPointer<ASTString> identifier = std::make_shared<ASTString>(m_scanner->currentLiteral());
+	if (m_scanner->currentToken() != Token::Identifier)
+	{
+		ASTPointer<ASTString> literal = std::make_shared<ASTString>(m_scanner->currentLiteral());
+		advance();
+		return literal;
+	}
+
+	auto it = m_identifiers.find(m_scanner->currentLiteral());
+	if (it == m_identifiers.end())
+	{
+		ASTPointer<ASTString> name = std::make_shared<ASTString>(m_scanner->currentLiteral());
+		// The key refers to the shared string, which outlives the entry.
+		it = m_identifiers.emplace(*name, name).first;
+	}
+	ASTPointer<ASTString> identifier = it->second;
 	advance();
 	return identifier;
 }
@@ -27,6 +27,9 @@
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <string_view>
+#include <unordered_map>
+
 namespace solidity::langutil
 {
 class CharStream;
@@ -52,6 +55,9 @@ public:
 
 	/// Returns the maximal AST node ID assigned so far
 	int64_t maxID() const { return m_currentNodeID; }
+	/// @returns all nodes of the source unit returned by the last call to parse(), in the order
+	/// they were created. Used to renumber sources that were parsed independently of each other.
+	std::vector<ASTNode*> parsedNodes() const;
 private:
 	class ASTNodeFactory;
 
@@ -215,6 +221,13 @@ private:
 
 	/// Returns the next AST node ID
 	int64_t nextID() { return ++m_currentNodeID; }
+	/// Keeps track of a newly created node for parsedNodes().
+	template <class NodeType>
+	ASTPointer<NodeType> registerNode(ASTPointer<NodeType> _node)
+	{
+		m_createdNodes.emplace_back(_node);
+		return _node;
+	}
 
 	std::pair<LookAheadInfo, IndexAccessedPath> tryParseIndexAccessedPath();
 	/// Performs limited look-ahead to distinguish between variable declaration and expression statement.
@@ -252,6 +265,12 @@ private:
 	std::optional<uint8_t> m_eofVersion;
 	/// Counter for the next AST node ID
 	int64_t m_currentNodeID = 0;
+	/// All nodes created while parsing the current source unit, including those that were
+	/// discarded again, e.g. during look-ahead.
+	std::vector<std::weak_ptr<ASTNode>> m_createdNodes;
+	/// Identifier strings of the current source unit, so that every occurrence of an
+	/// identifier shares the same string.
+	std::unordered_map<std::string_view, ASTPointer<ASTString>> m_identifiers;
 	/// Flag that indicates whether experimental mode is enabled in the current source unit
 	bool m_experimentalSolidityEnabledInCurrentSourceUnit = false;
 };
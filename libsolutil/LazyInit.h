@@ -21,7 +21,9 @@
 #include <libsolutil/Assertions.h>
 #include <libsolutil/Exceptions.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -35,6 +37,10 @@ DEV_SIMPLE_EXCEPTION(BadLazyInitAccess);
  * A value that is initialized at some point after construction of the LazyInit. The stored value can only be accessed
  * while calling "init", which initializes the stored value (if it has not already been initialized).
  *
+ * "init" can be called from several threads at the same time. The initializer runs without holding a lock, since it
+ * may itself initialize other values, so it can run more than once. Only the first value computed is stored.
+ * Moving and "reset" are not thread-safe.
+ *
  * @tparam T the type of the stored value; may not be a function, reference, array, or void type; may be const-qualified.
  */
 template<typename T>
@@ -53,30 +59,40 @@ public:
 	LazyInit& operator=(LazyInit const&) = delete;
 
 	// Move constructor must be overridden to ensure that moved-from object is left empty.
-	constexpr LazyInit(LazyInit&& _other) noexcept:
-		m_value(std::move(_other.m_value))
+	LazyInit(LazyInit&& _other) noexcept:
+		m_value(std::move(_other.m_value)),
+		m_initialized(m_value != nullptr)
 	{
-		_other.m_value.reset();
+		_other.reset();
 	}
 
 	LazyInit& operator=(LazyInit&& _other) noexcept
 	{
 		this->m_value.swap(_other.m_value);
-		_other.m_value.reset();
+		m_initialized = m_value != nullptr;
+		_other.reset();
+		return *this;
+	}
+
+	/// Discards the stored value, so that the next call to "init" computes it again.
+	void reset() noexcept
+	{
+		m_value.reset();
+		m_initialized = false;
 	}
 
 	template<typename F>
 	value_type& init(F&& _fun)
 	{
 		doInit(std::forward<F>(_fun));
-		return m_value.value();
+		return *m_value;
 	}
 
 	template<typename F>
 	value_type const& init(F&& _fun) const
 	{
 		doInit(std::forward<F>(_fun));
-		return m_value.value();
+		return *m_value;
 	}
 
 private:
@@ -85,11 +101,23 @@ private:
 	template<typename F>
 	void doInit(F&& _fun) const
 	{
-		if (!m_value.has_value())
-			m_value.emplace(std::forward<F>(_fun)());
+		if (m_initialized.load(std::memory_order_acquire))
+			return;
+
+		auto value = std::make_unique<value_type>(std::forward<F>(_fun)());
+		std::lock_guard lock(s_mutex);
+		if (!m_value)
+		{
+			m_value = std::move(value);
+			m_initialized.store(true, std::memory_order_release);
+		}
 	}
 
-	mutable std::optional<value_type> m_value;
+	/// Guards storing the value. It is shared by all instances, since values are only stored once.
+	static inline std::mutex s_mutex;
+
+	mutable std::unique_ptr<value_type> m_value;
+	mutable std::atomic<bool> m_initialized = false;
 };
 
 }
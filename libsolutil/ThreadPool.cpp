@@ -0,0 +1,87 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/ThreadPool.h>
+
+#include <system_error>
+
+using namespace solidity::util;
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_stopping = true;
+	}
+	m_jobAvailable.notify_all();
+	for (std::thread& thread: m_threads)
+		thread.join();
+}
+
+size_t ThreadPool::defaultConcurrency()
+{
+#ifdef EMSCRIPTEN_BUILD
+	return 0;
+#else
+	return std::thread::hardware_concurrency();
+#endif
+}
+
+void ThreadPool::enqueue(std::function<void()> _job)
+{
+	{
+		std::lock_guard lock(m_mutex);
+		if (m_idleThreads == 0 && m_threads.size() < m_maxThreads)
+			try
+			{
+				m_threads.emplace_back([this]() { work(); });
+			}
+			catch (std::system_error const&)
+			{
+				// Do not try again, just continue with the threads we already have.
+				m_maxThreads = m_threads.size();
+			}
+		if (!m_threads.empty())
+		{
+			m_jobs.emplace_back(std::move(_job));
+			m_jobAvailable.notify_one();
+			return;
+		}
+	}
+	_job();
+}
+
+void ThreadPool::work()
+{
+	while (true)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock lock(m_mutex);
+			++m_idleThreads;
+			m_jobAvailable.wait(lock, [&]() { return m_stopping || !m_jobs.empty(); });
+			--m_idleThreads;
+			// Remaining jobs are still processed when stopping.
+			if (m_jobs.empty())
+				return;
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+		job();
+	}
+}
@@ -0,0 +1,83 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Simple pool of worker threads.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// Pool of worker threads processing submitted tasks in the order of submission.
+///
+/// Workers are only started once there is work for them, up to the given maximum.
+/// If the maximum is zero or no thread can be started at all, tasks are run on the submitting
+/// thread right away, so callers do not need a separate code path for single-threaded platforms.
+///
+/// The destructor waits for all submitted tasks to finish.
+class ThreadPool
+{
+public:
+	explicit ThreadPool(size_t _maxThreads = defaultConcurrency()): m_maxThreads(_maxThreads) {}
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// Schedules @a _task for execution.
+	/// @returns a future for the result of the task, which also receives any exception thrown by it.
+	template<typename Task>
+	std::future<std::invoke_result_t<std::decay_t<Task>>> submit(Task&& _task)
+	{
+		using Result = std::invoke_result_t<std::decay_t<Task>>;
+		// std::function requires copyable targets, so the task is kept behind a shared pointer.
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(_task));
+		std::future<Result> result = task->get_future();
+		enqueue([task]() { (*task)(); });
+		return result;
+	}
+
+	/// @returns the number of hardware threads, or zero if threads are not supported.
+	static size_t defaultConcurrency();
+
+private:
+	void enqueue(std::function<void()> _job);
+	void work();
+
+	size_t m_maxThreads = 0;
+	std::mutex m_mutex;
+	std::condition_variable m_jobAvailable;
+	std::deque<std::function<void()>> m_jobs;
+	std::vector<std::thread> m_threads;
+	size_t m_idleThreads = 0;
+	bool m_stopping = false;
+};
+
+}
@@ -0,0 +1,759 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/ObjectBinaryFormat.h>
+
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Object.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/Visitor.h>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace
+{
+
+uint8_t constexpr formatVersion = 1;
+std::array<uint8_t, 4> constexpr magic{0x00, 'y', 'u', 'l'};
+
+enum class ObjectNodeTag: uint8_t { Object, Data };
+enum class FunctionNameTag: uint8_t { Identifier, Builtin };
+enum class LiteralValueTag: uint8_t { Number, NumberWithHint, BuiltinString };
+
+// Statements and expressions are tagged by their index in the Statement and Expression variants.
+static_assert(std::variant_size_v<Statement> == 11, "Update the binary format when adding statements.");
+static_assert(std::variant_size_v<Expression> == 3, "Update the binary format when adding expressions.");
+
+}
+
+bytes ObjectBinaryWriter::write(Object const& _object)
+{
+	ObjectBinaryWriter writer;
+	writer.writeObject(_object);
+
+	// Debug data refers to source names, so its table has to be encoded before the string table.
+	bytes debugDataTable;
+	appendUnsigned(writer.m_debugData.size(), debugDataTable);
+	for (DebugData const* debugData: writer.m_debugData)
+	{
+		for (SourceLocation const* location: {&debugData->nativeLocation, &debugData->originLocation})
+		{
+			appendUnsigned(location->sourceName ? writer.stringIndex(*location->sourceName) + 1 : 0, debugDataTable);
+			appendSigned(location->start, debugDataTable);
+			appendSigned(location->end, debugDataTable);
+		}
+		debugDataTable.push_back(debugData->astID.has_value());
+		if (debugData->astID)
+			appendSigned(*debugData->astID, debugDataTable);
+	}
+
+	bytes result(magic.begin(), magic.end());
+	result.push_back(formatVersion);
+	appendUnsigned(writer.m_strings.size(), result);
+	for (std::string const* string: writer.m_strings)
+	{
+		appendUnsigned(string->size(), result);
+		result.insert(result.end(), string->begin(), string->end());
+	}
+	result += debugDataTable;
+	result += writer.m_body;
+	return result;
+}
+
+void ObjectBinaryWriter::writeObjectNode(ObjectNode const& _node)
+{
+	if (auto const* object = dynamic_cast<Object const*>(&_node))
+	{
+		m_body.push_back(static_cast<uint8_t>(ObjectNodeTag::Object));
+		writeObject(*object);
+	}
+	else
+	{
+		auto const* data = dynamic_cast<Data const*>(&_node);
+		yulAssert(data);
+		m_body.push_back(static_cast<uint8_t>(ObjectNodeTag::Data));
+		writeString(data->name);
+		writeUnsigned(data->data.size());
+		m_body += data->data;
+	}
+}
+
+void ObjectBinaryWriter::writeObject(Object const& _object)
+{
+	writeString(_object.name);
+
+	if (_object.debugData && _object.debugData->sourceNames)
+	{
+		writeUnsigned(_object.debugData->sourceNames->size() + 1);
+		for (auto const& [index, sourceName]: *_object.debugData->sourceNames)
+		{
+			yulAssert(sourceName);
+			writeUnsigned(index);
+			writeString(*sourceName);
+		}
+	}
+	else
+		writeUnsigned(0);
+
+	m_body.push_back(_object.hasCode());
+	if (_object.hasCode())
+	{
+		if (m_dialect != _object.dialect())
+		{
+			m_dialect = _object.dialect();
+			m_builtinNameIndices.clear();
+		}
+		writeBlock(_object.code()->root());
+	}
+
+	writeUnsigned(_object.subObjects.size());
+	for (std::shared_ptr<ObjectNode> const& subObject: _object.subObjects)
+	{
+		yulAssert(subObject);
+		writeObjectNode(*subObject);
+	}
+}
+
+void ObjectBinaryWriter::writeBlock(Block const& _block)
+{
+	writeDebugData(_block.debugData);
+	writeUnsigned(_block.statements.size());
+	for (Statement const& statement: _block.statements)
+		writeStatement(statement);
+}
+
+void ObjectBinaryWriter::writeStatement(Statement const& _statement)
+{
+	m_body.push_back(static_cast<uint8_t>(_statement.index()));
+	std::visit(GenericVisitor{
+		[&](ExpressionStatement const& _expressionStatement) {
+			writeDebugData(_expressionStatement.debugData);
+			writeExpression(_expressionStatement.expression);
+		},
+		[&](Assignment const& _assignment) {
+			writeDebugData(_assignment.debugData);
+			writeUnsigned(_assignment.variableNames.size());
+			for (Identifier const& variable: _assignment.variableNames)
+				writeIdentifier(variable);
+			yulAssert(_assignment.value);
+			writeExpression(*_assignment.value);
+		},
+		[&](VariableDeclaration const& _declaration) {
+			writeDebugData(_declaration.debugData);
+			writeNames(_declaration.variables);
+			m_body.push_back(_declaration.value != nullptr);
+			if (_declaration.value)
+				writeExpression(*_declaration.value);
+		},
+		[&](FunctionDefinition const& _function) {
+			writeDebugData(_function.debugData);
+			writeString(_function.name.str());
+			writeNames(_function.parameters);
+			writeNames(_function.returnVariables);
+			writeBlock(_function.body);
+		},
+		[&](If const& _if) {
+			writeDebugData(_if.debugData);
+			yulAssert(_if.condition);
+			writeExpression(*_if.condition);
+			writeBlock(_if.body);
+		},
+		[&](Switch const& _switch) {
+			writeDebugData(_switch.debugData);
+			yulAssert(_switch.expression);
+			writeExpression(*_switch.expression);
+			writeUnsigned(_switch.cases.size());
+			for (Case const& switchCase: _switch.cases)
+			{
+				writeDebugData(switchCase.debugData);
+				m_body.push_back(switchCase.value != nullptr);
+				if (switchCase.value)
+					writeLiteral(*switchCase.value);
+				writeBlock(switchCase.body);
+			}
+		},
+		[&](ForLoop const& _forLoop) {
+			writeDebugData(_forLoop.debugData);
+			writeBlock(_forLoop.pre);
+			yulAssert(_forLoop.condition);
+			writeExpression(*_forLoop.condition);
+			writeBlock(_forLoop.post);
+			writeBlock(_forLoop.body);
+		},
+		[&](Break const& _break) { writeDebugData(_break.debugData); },
+		[&](Continue const& _continue) { writeDebugData(_continue.debugData); },
+		[&](Leave const& _leave) { writeDebugData(_leave.debugData); },
+		[&](Block const& _block) { writeBlock(_block); },
+	}, _statement);
+}
+
+void ObjectBinaryWriter::writeExpression(Expression const& _expression)
+{
+	m_body.push_back(static_cast<uint8_t>(_expression.index()));
+	std::visit(GenericVisitor{
+		[&](FunctionCall const& _call) {
+			writeDebugData(_call.debugData);
+			std::visit(GenericVisitor{
+				[&](Identifier const& _identifier) {
+					m_body.push_back(static_cast<uint8_t>(FunctionNameTag::Identifier));
+					writeIdentifier(_identifier);
+				},
+				[&](BuiltinName const& _builtin) {
+					m_body.push_back(static_cast<uint8_t>(FunctionNameTag::Builtin));
+					writeDebugData(_builtin.debugData);
+					auto [it, inserted] = m_builtinNameIndices.try_emplace(_builtin.handle);
+					if (inserted)
+					{
+						yulAssert(m_dialect);
+						it->second = stringIndex(m_dialect->builtin(_builtin.handle).name);
+					}
+					writeUnsigned(it->second);
+				},
+			}, _call.functionName);
+			writeUnsigned(_call.arguments.size());
+			for (Expression const& argument: _call.arguments)
+				writeExpression(argument);
+		},
+		[&](Identifier const& _identifier) { writeIdentifier(_identifier); },
+		[&](Literal const& _literal) { writeLiteral(_literal); },
+	}, _expression);
+}
+
+void ObjectBinaryWriter::writeLiteral(Literal const& _literal)
+{
+	writeDebugData(_literal.debugData);
+	m_body.push_back(static_cast<uint8_t>(_literal.kind));
+	if (_literal.value.unlimited())
+	{
+		m_body.push_back(static_cast<uint8_t>(LiteralValueTag::BuiltinString));
+		writeString(_literal.value.builtinStringLiteralValue());
+	}
+	else if (_literal.value.hint())
+	{
+		m_body.push_back(static_cast<uint8_t>(LiteralValueTag::NumberWithHint));
+		writeNumber(_literal.value.value());
+		writeString(*_literal.value.hint());
+	}
+	else
+	{
+		m_body.push_back(static_cast<uint8_t>(LiteralValueTag::Number));
+		writeNumber(_literal.value.value());
+	}
+}
+
+void ObjectBinaryWriter::writeIdentifier(Identifier const& _identifier)
+{
+	writeDebugData(_identifier.debugData);
+	writeString(_identifier.name.str());
+}
+
+void ObjectBinaryWriter::writeNames(std::vector<NameWithDebugData> const& _names)
+{
+	writeUnsigned(_names.size());
+	for (NameWithDebugData const& name: _names)
+	{
+		writeDebugData(name.debugData);
+		writeString(name.name.str());
+	}
+}
+
+void ObjectBinaryWriter::writeDebugData(DebugData::ConstPtr const& _debugData)
+{
+	if (!_debugData)
+	{
+		writeUnsigned(0);
+		return;
+	}
+	auto [it, inserted] = m_debugDataIndices.try_emplace(_debugData.get(), m_debugData.size());
+	if (inserted)
+		m_debugData.emplace_back(_debugData.get());
+	writeUnsigned(it->second + 1);
+}
+
+void ObjectBinaryWriter::writeNumber(u256 const& _value)
+{
+	u256 value = _value;
+	do
+	{
+		uint8_t byte = static_cast<uint8_t>(value & 0x7f);
+		value >>= 7;
+		if (value != 0)
+			byte |= 0x80;
+		m_body.push_back(byte);
+	}
+	while (value != 0);
+}
+
+size_t ObjectBinaryWriter::stringIndex(std::string const& _string)
+{
+	auto [it, inserted] = m_stringIndices.try_emplace(_string, m_strings.size());
+	if (inserted)
+		m_strings.emplace_back(&it->first);
+	return it->second;
+}
+
+void ObjectBinaryWriter::appendUnsigned(uint64_t _value, bytes& _target)
+{
+	do
+	{
+		uint8_t byte = static_cast<uint8_t>(_value & 0x7f);
+		_value >>= 7;
+		if (_value != 0)
+			byte |= 0x80;
+		_target.push_back(byte);
+	}
+	while (_value != 0);
+}
+
+void ObjectBinaryWriter::appendSigned(int64_t _value, bytes& _target)
+{
+	// Zigzag encoding keeps small negative values, like the -1 of unknown locations, short.
+	appendUnsigned((static_cast<uint64_t>(_value) << 1) ^ static_cast<uint64_t>(_value >> 63), _target);
+}
+
+bool ObjectBinaryReader::isObjectBinary(bytesConstRef _data)
+{
+	return _data.size() >= magic.size() && std::equal(magic.begin(), magic.end(), _data.begin());
+}
+
+std::shared_ptr<Object> ObjectBinaryReader::read(bytesConstRef _data, Dialect const& _dialect, bool _nativeLocations)
+{
+	if (!isObjectBinary(_data))
+		solThrow(ObjectBinaryFormatError, "Not a binary Yul object.");
+
+	ObjectBinaryReader reader(_data, _dialect);
+	reader.m_position = magic.size();
+	uint8_t version = reader.readByte();
+	reader.failIf(version != formatVersion, fmt::format("Unsupported format version {}.", version));
+
+	size_t stringCount = reader.readCount();
+	reader.m_strings.reserve(stringCount);
+	for (size_t i = 0; i < stringCount; ++i)
+	{
+		size_t length = reader.readCount();
+		auto begin = reader.m_data.begin() + static_cast<std::ptrdiff_t>(reader.m_position);
+		reader.m_strings.emplace_back(begin, begin + static_cast<std::ptrdiff_t>(length));
+		reader.m_position += length;
+	}
+	reader.m_names.resize(stringCount);
+	reader.m_sourceNames.resize(stringCount);
+	reader.m_builtins.resize(stringCount);
+
+	size_t debugDataCount = reader.readCount();
+	reader.m_debugData.reserve(debugDataCount);
+	for (size_t i = 0; i < debugDataCount; ++i)
+	{
+		SourceLocation nativeLocation = reader.readSourceLocation();
+		SourceLocation originLocation = reader.readSourceLocation();
+		std::optional<int64_t> astID;
+		if (reader.readByte())
+			astID = reader.readSigned();
+		reader.m_debugData.emplace_back(DebugData::create(
+			_nativeLocations ? std::move(nativeLocation) : SourceLocation{},
+			std::move(originLocation),
+			astID
+		));
+	}
+
+	std::shared_ptr<Object> object = reader.readObject();
+	reader.failIf(reader.m_position != reader.m_data.size(), "Unexpected data after the object.");
+	return object;
+}
+
+std::shared_ptr<ObjectNode> ObjectBinaryReader::readObjectNode()
+{
+	uint8_t tag = readByte();
+	if (tag == static_cast<uint8_t>(ObjectNodeTag::Object))
+		return readObject();
+
+	failIf(tag != static_cast<uint8_t>(ObjectNodeTag::Data), "Invalid object node.");
+	std::string name = readString();
+	size_t size = readCount();
+	auto begin = m_data.begin() + static_cast<std::ptrdiff_t>(m_position);
+	m_position += size;
+	return std::make_shared<Data>(std::move(name), bytes(begin, begin + static_cast<std::ptrdiff_t>(size)));
+}
+
+std::shared_ptr<Object> ObjectBinaryReader::readObject()
+{
+	auto object = std::make_shared<Object>();
+	object->name = readString();
+
+	std::optional<SourceNameMap> sourceNames;
+	if (size_t sourceNameCount = readCount())
+	{
+		sourceNames.emplace();
+		for (size_t i = 0; i < sourceNameCount - 1; ++i)
+		{
+			uint64_t index = readUnsigned();
+			failIf(index > std::numeric_limits<unsigned>::max(), "Invalid source index.");
+			(*sourceNames)[static_cast<unsigned>(index)] = sourceName(readStringIndex());
+		}
+	}
+	object->debugData = std::make_shared<ObjectDebugData>(ObjectDebugData{std::move(sourceNames)});
+
+	if (readByte())
+		object->setCode(std::make_shared<AST>(m_dialect, readBlock()));
+
+	size_t subObjectCount = readCount();
+	for (size_t i = 0; i < subObjectCount; ++i)
+	{
+		std::shared_ptr<ObjectNode> subObject = readObjectNode();
+		failIf(
+			subObject->name.empty() || !object->subIndexByName.try_emplace(subObject->name, i).second,
+			"Invalid sub-object name."
+		);
+		object->subObjects.emplace_back(std::move(subObject));
+	}
+	return object;
+}
+
+Block ObjectBinaryReader::readBlock()
+{
+	ScopeGuard nestingGuard = enterNested();
+	Block block{readDebugData(), {}};
+	size_t statementCount = readCount();
+	block.statements.reserve(statementCount);
+	for (size_t i = 0; i < statementCount; ++i)
+		block.statements.emplace_back(readStatement());
+	return block;
+}
+
+Statement ObjectBinaryReader::readStatement()
+{
+	ScopeGuard nestingGuard = enterNested();
+	uint8_t tag = readByte();
+	switch (tag)
+	{
+	case 0:
+	{
+		DebugData::ConstPtr debugData = readDebugData();
+		return ExpressionStatement{std::move(debugData), readExpression()};
+	}
+	case 1:
+	{
+		Assignment assignment{readDebugData(), {}, {}};
+		size_t variableCount = readCount();
+		failIf(variableCount == 0, "Assignment without variables.");
+		assignment.variableNames.reserve(variableCount);
+		for (size_t i = 0; i < variableCount; ++i)
+			assignment.variableNames.emplace_back(readIdentifier());
+		assignment.value = std::make_unique<Expression>(readExpression());
+		return assignment;
+	}
+	case 2:
+	{
+		VariableDeclaration declaration{readDebugData(), {}, {}};
+		declaration.variables = readNames();
+		failIf(declaration.variables.empty(), "Variable declaration without variables.");
+		if (readByte())
+			declaration.value = std::make_unique<Expression>(readExpression());
+		return declaration;
+	}
+	case 3:
+	{
+		failIf(m_currentForLoopComponent == ForLoopComponent::ForLoopPre, "Function definition in for-loop init block.");
+		FunctionDefinition function{readDebugData(), {}, {}, {}, {}};
+		function.name = readName();
+		function.parameters = readNames();
+		function.returnVariables = readNames();
+
+		ForLoopComponent outerForLoopComponent = m_currentForLoopComponent;
+		bool wasInsideFunction = m_insideFunction;
+		m_currentForLoopComponent = ForLoopComponent::None;
+		m_insideFunction = true;
+		function.body = readBlock();
+		m_currentForLoopComponent = outerForLoopComponent;
+		m_insideFunction = wasInsideFunction;
+		return function;
+	}
+	case 4:
+	{
+		If ifStatement{readDebugData(), {}, {}};
+		ifStatement.condition = std::make_unique<Expression>(readExpression());
+		ifStatement.body = readBlock();
+		return ifStatement;
+	}
+	case 5:
+	{
+		Switch switchStatement{readDebugData(), {}, {}};
+		switchStatement.expression = std::make_unique<Expression>(readExpression());
+		size_t caseCount = readCount();
+		failIf(caseCount == 0, "Switch without cases.");
+		switchStatement.cases.reserve(caseCount);
+		for (size_t i = 0; i < caseCount; ++i)
+		{
+			Case& switchCase = switchStatement.cases.emplace_back(Case{readDebugData(), {}, {}});
+			if (readByte())
+				switchCase.value = std::make_unique<Literal>(readLiteral());
+			else
+				failIf(i + 1 != caseCount, "Default case is not the last case.");
+			switchCase.body = readBlock();
+		}
+		return switchStatement;
+	}
+	case 6:
+	{
+		ForLoopComponent outerForLoopComponent = m_currentForLoopComponent;
+		ForLoop forLoop{readDebugData(), {}, {}, {}, {}};
+		m_currentForLoopComponent = ForLoopComponent::ForLoopPre;
+		forLoop.pre = readBlock();
+		forLoop.condition = std::make_unique<Expression>(readExpression());
+		m_currentForLoopComponent = ForLoopComponent::ForLoopPost;
+		forLoop.post = readBlock();
+		m_currentForLoopComponent = ForLoopComponent::ForLoopBody;
+		forLoop.body = readBlock();
+		m_currentForLoopComponent = outerForLoopComponent;
+		return forLoop;
+	}
+	case 7:
+		failIf(m_currentForLoopComponent != ForLoopComponent::ForLoopBody, "Break outside of a for-loop body.");
+		return Break{readDebugData()};
+	case 8:
+		failIf(m_currentForLoopComponent != ForLoopComponent::ForLoopBody, "Continue outside of a for-loop body.");
+		return Continue{readDebugData()};
+	case 9:
+		failIf(!m_insideFunction, "Leave outside of a function.");
+		return Leave{readDebugData()};
+	case 10:
+		return readBlock();
+	}
+	failIf(true, fmt::format("Invalid statement tag {}.", tag));
+	util::unreachable();
+}
+
+Expression ObjectBinaryReader::readExpression(bool _literalArgument)
+{
+	ScopeGuard nestingGuard = enterNested();
+	uint8_t tag = readByte();
+	switch (tag)
+	{
+	case 0:
+	{
+		FunctionCall call{readDebugData(), {}, {}};
+		BuiltinFunction const* builtin = nullptr;
+		uint8_t functionNameTag = readByte();
+		if (functionNameTag == static_cast<uint8_t>(FunctionNameTag::Identifier))
+			call.functionName = readIdentifier();
+		else
+		{
+			failIf(functionNameTag != static_cast<uint8_t>(FunctionNameTag::Builtin), "Invalid function name.");
+			DebugData::ConstPtr debugData = readDebugData();
+			BuiltinHandle handle = readBuiltin();
+			builtin = &m_dialect.builtin(handle);
+			call.functionName = BuiltinName{std::move(debugData), handle};
+		}
+		size_t argumentCount = readCount();
+		call.arguments.reserve(argumentCount);
+		for (size_t i = 0; i < argumentCount; ++i)
+			call.arguments.emplace_back(readExpression(
+				builtin && i < builtin->literalArguments.size() && builtin->literalArgument(i).has_value()
+			));
+		return call;
+	}
+	case 1:
+		return readIdentifier();
+	case 2:
+		return readLiteral(_literalArgument);
+	}
+	failIf(true, fmt::format("Invalid expression tag {}.", tag));
+	util::unreachable();
+}
+
+Literal ObjectBinaryReader::readLiteral(bool _literalArgument)
+{
+	DebugData::ConstPtr debugData = readDebugData();
+	uint8_t kind = readByte();
+	failIf(kind > static_cast<uint8_t>(LiteralKind::String), "Invalid literal kind.");
+
+	LiteralValue value;
+	switch (uint8_t valueTag = readByte())
+	{
+	case static_cast<uint8_t>(LiteralValueTag::Number):
+		value = LiteralValue(readNumber());
+		break;
+	case static_cast<uint8_t>(LiteralValueTag::NumberWithHint):
+	{
+		u256 number = readNumber();
+		value = LiteralValue(number, readString());
+		break;
+	}
+	case static_cast<uint8_t>(LiteralValueTag::BuiltinString):
+		value = LiteralValue(readString());
+		break;
+	default:
+		failIf(true, fmt::format("Invalid literal value tag {}.", valueTag));
+	}
+	Literal literal{std::move(debugData), static_cast<LiteralKind>(kind), std::move(value)};
+	failIf(
+		literal.value.unlimited() != (_literalArgument && literal.kind == LiteralKind::String) ||
+		!validLiteral(literal),
+		"Invalid literal."
+	);
+	return literal;
+}
+
+Identifier ObjectBinaryReader::readIdentifier()
+{
+	DebugData::ConstPtr debugData = readDebugData();
+	return Identifier{std::move(debugData), readName()};
+}
+
+std::vector<NameWithDebugData> ObjectBinaryReader::readNames()
+{
+	std::vector<NameWithDebugData> names(readCount());
+	for (NameWithDebugData& name: names)
+	{
+		name.debugData = readDebugData();
+		name.name = readName();
+	}
+	return names;
+}
+
+DebugData::ConstPtr ObjectBinaryReader::readDebugData()
+{
+	uint64_t index = readUnsigned();
+	if (index == 0)
+		return nullptr;
+	failIf(index > m_debugData.size(), "Invalid debug data index.");
+	return m_debugData[index - 1];
+}
+
+SourceLocation ObjectBinaryReader::readSourceLocation()
+{
+	SourceLocation location;
+	if (uint64_t sourceNameIndex = readUnsigned())
+	{
+		failIf(sourceNameIndex > m_strings.size(), "Invalid source name index.");
+		location.sourceName = sourceName(sourceNameIndex - 1);
+	}
+	int64_t start = readSigned();
+	int64_t end = readSigned();
+	failIf(
+		start < std::numeric_limits<int>::min() || start > std::numeric_limits<int>::max() ||
+		end < std::numeric_limits<int>::min() || end > std::numeric_limits<int>::max(),
+		"Invalid source location."
+	);
+	location.start = static_cast<int>(start);
+	location.end = static_cast<int>(end);
+	return location;
+}
+
+size_t ObjectBinaryReader::readStringIndex()
+{
+	uint64_t index = readUnsigned();
+	failIf(index >= m_strings.size(), "Invalid string index.");
+	return static_cast<size_t>(index);
+}
+
+YulName ObjectBinaryReader::readName()
+{
+	size_t index = readStringIndex();
+	failIf(m_strings[index].empty(), "Empty name.");
+	if (!m_names[index])
+		m_names[index] = YulName{m_strings[index]};
+	return *m_names[index];
+}
+
+BuiltinHandle ObjectBinaryReader::readBuiltin()
+{
+	size_t index = readStringIndex();
+	if (!m_builtins[index])
+	{
+		m_builtins[index] = m_dialect.findBuiltin(m_strings[index]);
+		failIf(!m_builtins[index], fmt::format("Builtin \"{}\" is not available in the dialect.", m_strings[index]));
+	}
+	return *m_builtins[index];
+}
+
+std::shared_ptr<std::string const> const& ObjectBinaryReader::sourceName(size_t _stringIndex)
+{
+	if (!m_sourceNames[_stringIndex])
+		m_sourceNames[_stringIndex] = std::make_shared<std::string const>(m_strings[_stringIndex]);
+	return m_sourceNames[_stringIndex];
+}
+
+uint64_t ObjectBinaryReader::readUnsigned()
+{
+	uint64_t value = 0;
+	for (unsigned shift = 0;; shift += 7)
+	{
+		uint8_t byte = readByte();
+		failIf(shift == 63 && byte > 1, "Integer too large.");
+		value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return value;
+	}
+}
+
+int64_t ObjectBinaryReader::readSigned()
+{
+	uint64_t value = readUnsigned();
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+u256 ObjectBinaryReader::readNumber()
+{
+	u256 value = 0;
+	for (unsigned shift = 0;; shift += 7)
+	{
+		uint8_t byte = readByte();
+		failIf(shift == 252 && byte > 0x0f, "Number too large.");
+		value |= u256(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return value;
+	}
+}
+
+size_t ObjectBinaryReader::readCount()
+{
+	uint64_t count = readUnsigned();
+	failIf(count > m_data.size() - m_position, "Unexpected end of data.");
+	return static_cast<size_t>(count);
+}
+
+uint8_t ObjectBinaryReader::readByte()
+{
+	failIf(m_position >= m_data.size(), "Unexpected end of data.");
+	return m_data[m_position++];
+}
+
+void ObjectBinaryReader::failIf(bool _condition, std::string const& _message) const
+{
+	if (_condition)
+		solThrow(ObjectBinaryFormatError, "Invalid binary Yul object: " + _message);
+}
+
+ScopeGuard ObjectBinaryReader::enterNested()
+{
+	failIf(++m_nestingDepth > maxNestingDepth, "Nesting too deep.");
+	return ScopeGuard([this] { --m_nestingDepth; });
+}
@@ -0,0 +1,169 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Compact binary format for Yul objects.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+#include <libyul/Builtins.h>
+#include <libyul/Exceptions.h>
+#include <libyul/YulName.h>
+
+#include <liblangutil/DebugData.h>
+
+#include <libsolutil/Common.h>
+#include <libsolutil/Numeric.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace solidity::yul
+{
+
+class Dialect;
+class Object;
+struct ObjectNode;
+
+struct ObjectBinaryFormatError: virtual YulException {};
+
+/**
+ * Serializes Yul objects, including their sub-objects, data and debug data, into a compact binary format.
+ *
+ * The format starts with the magic bytes "\0yul" and a format version, followed by a table of all
+ * strings (names, literal representations and source names) and a table of all distinct debug data.
+ * The object tree follows, where every node is a tag followed by its fields. Names, strings and
+ * debug data are stored as indices into the tables and all integers are LEB128-encoded.
+ * Builtins are stored by name, so that they can be resolved against the dialect of the reader.
+ */
+class ObjectBinaryWriter
+{
+public:
+	static bytes write(Object const& _object);
+
+private:
+	ObjectBinaryWriter() = default;
+
+	void writeObjectNode(ObjectNode const& _node);
+	void writeObject(Object const& _object);
+
+	void writeBlock(Block const& _block);
+	void writeStatement(Statement const& _statement);
+	void writeExpression(Expression const& _expression);
+	void writeLiteral(Literal const& _literal);
+	void writeIdentifier(Identifier const& _identifier);
+	void writeNames(std::vector<NameWithDebugData> const& _names);
+
+	void writeDebugData(langutil::DebugData::ConstPtr const& _debugData);
+	void writeString(std::string const& _string) { writeUnsigned(stringIndex(_string)); }
+	void writeUnsigned(uint64_t _value) { appendUnsigned(_value, m_body); }
+	void writeNumber(u256 const& _value);
+
+	/// @returns the index of @a _string in the string table, adding it if necessary.
+	size_t stringIndex(std::string const& _string);
+	static void appendUnsigned(uint64_t _value, bytes& _target);
+	static void appendSigned(int64_t _value, bytes& _target);
+
+	/// Dialect of the code currently being written.
+	Dialect const* m_dialect = nullptr;
+	std::unordered_map<std::string, size_t> m_stringIndices;
+	std::vector<std::string const*> m_strings;
+	/// Builtins are written by name, cached by handle.
+	std::map<BuiltinHandle, size_t> m_builtinNameIndices;
+	std::map<langutil::DebugData const*, size_t> m_debugDataIndices;
+	std::vector<langutil::DebugData const*> m_debugData;
+	bytes m_body;
+};
+
+/**
+ * Reads Yul objects written by ObjectBinaryWriter.
+ *
+ * The resulting objects are not analyzed, i.e. the caller has to run the analysis before using them.
+ */
+class ObjectBinaryReader
+{
+public:
+	/// @returns true if @a _data starts with the magic bytes of the format.
+	static bool isObjectBinary(bytesConstRef _data);
+	/// @param _nativeLocations if false, locations in the Yul source are dropped, which is useful if
+	/// that source is not available to report errors.
+	/// @throws ObjectBinaryFormatError if @a _data is malformed or refers to builtins not available in @a _dialect.
+	static std::shared_ptr<Object> read(bytesConstRef _data, Dialect const& _dialect, bool _nativeLocations = true);
+
+private:
+	ObjectBinaryReader(bytesConstRef _data, Dialect const& _dialect): m_data(_data), m_dialect(_dialect) {}
+
+	std::shared_ptr<ObjectNode> readObjectNode();
+	std::shared_ptr<Object> readObject();
+
+	Block readBlock();
+	Statement readStatement();
+	/// @param _literalArgument if true, the expression is a literal argument of a builtin, in which case
+	/// string literals have to be unlimited, as created by the parser.
+	Expression readExpression(bool _literalArgument = false);
+	Literal readLiteral(bool _literalArgument = false);
+	Identifier readIdentifier();
+	std::vector<NameWithDebugData> readNames();
+
+	langutil::DebugData::ConstPtr readDebugData();
+	langutil::SourceLocation readSourceLocation();
+	size_t readStringIndex();
+	std::string const& readString() { return m_strings[readStringIndex()]; }
+	YulName readName();
+	BuiltinHandle readBuiltin();
+	std::shared_ptr<std::string const> const& sourceName(size_t _stringIndex);
+	uint64_t readUnsigned();
+	int64_t readSigned();
+	u256 readNumber();
+	/// Reads the number of elements that follow, each of which takes at least one byte.
+	size_t readCount();
+	uint8_t readByte();
+	void failIf(bool _condition, std::string const& _message) const;
+	/// Increases the nesting depth until the returned guard is destroyed.
+	ScopeGuard enterNested();
+
+	/// Same limit as the parser, so that everything it accepts can be read back.
+	static size_t constexpr maxNestingDepth = 1200;
+
+	/// Where break, continue and leave are allowed, tracked as in the parser since the
+	/// analysis relies on the parser having rejected them elsewhere.
+	enum class ForLoopComponent
+	{
+		None, ForLoopPre, ForLoopPost, ForLoopBody
+	};
+
+	bytesConstRef m_data;
+	size_t m_position = 0;
+	Dialect const& m_dialect;
+	std::vector<std::string> m_strings;
+	/// Names and source names are created once per string table entry and then shared.
+	std::vector<std::optional<YulName>> m_names;
+	std::vector<std::shared_ptr<std::string const>> m_sourceNames;
+	std::vector<std::optional<BuiltinHandle>> m_builtins;
+	std::vector<langutil::DebugData::ConstPtr> m_debugData;
+	size_t m_nestingDepth = 0;
+	ForLoopComponent m_currentForLoopComponent = ForLoopComponent::None;
+	bool m_insideFunction = false;
+};
+
+}
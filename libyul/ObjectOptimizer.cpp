@@ -26,14 +26,17 @@
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
 #include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <libsolutil/CommonData.h>
 #include <libsolutil/Keccak256.h>
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <numeric>
 
@@ -103,12 +106,28 @@ void ObjectOptimizer::optimize(Object& _object, Settings const& _settings, bool
 		storeOptimizedObject(*cacheKey, _object, dialect);
 }
 
+void ObjectOptimizer::clear()
+{
+	m_cachedObjects.clear();
+	m_approximateMemoryUsage = 0;
+}
+
 void ObjectOptimizer::storeOptimizedObject(util::h256 _cacheKey, Object const& _optimizedObject, Dialect const& _dialect)
 {
+	// The default code size weights approximate the number of AST nodes. Assume that each of them
+	// occupies about as much memory as the variant holding it.
+	Block const& ast = _optimizedObject.code()->root();
+	size_t const approximateMemoryUsage =
+		CodeSize::codeSizeIncludingFunctions(ast) * std::max(sizeof(Statement), sizeof(Expression));
+
+	if (CachedObject const* previous = util::valueOrNullptr(m_cachedObjects, _cacheKey))
+		m_approximateMemoryUsage -= previous->approximateMemoryUsage;
 	m_cachedObjects[_cacheKey] = CachedObject{
-		std::make_shared<Block>(ASTCopier{}.translate(_optimizedObject.code()->root())),
+		std::make_shared<Block>(ASTCopier{}.translate(ast)),
 		&_dialect,
+		approximateMemoryUsage,
 	};
+	m_approximateMemoryUsage += approximateMemoryUsage;
 }
 
 void ObjectOptimizer::overwriteWithOptimizedObject(util::h256 _cacheKey, Object& _object) const
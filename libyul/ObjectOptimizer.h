@@ -72,12 +72,17 @@ public:
 	void optimize(Object& _object, Settings const& _settings);
 
 	size_t size() const { return m_cachedObjects.size(); }
+	/// @returns a rough estimate of the memory (in bytes) occupied by the cached ASTs.
+	size_t approximateMemoryUsage() const { return m_approximateMemoryUsage; }
+	/// Removes all entries from the cache.
+	void clear();
 
 private:
 	struct CachedObject
 	{
 		std::shared_ptr<Block const> optimizedAST;
 		Dialect const* dialect;
+		size_t approximateMemoryUsage;
 	};
 
 	void optimize(Object& _object, Settings const& _settings, bool _isCreation);
@@ -93,6 +98,7 @@ private:
 	);
 
 	std::map<util::h256, CachedObject> m_cachedObjects;
+	size_t m_approximateMemoryUsage = 0;
 };
 
 }
@@ -25,6 +25,7 @@
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMObjectCompiler.h>
+#include <libyul/ObjectBinaryFormat.h>
 #include <libyul/ObjectParser.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/Suite.h>
@@ -86,6 +87,36 @@ bool YulStack::parseAndAnalyze(std::string const& _sourceName, std::string const
 	return analyzeParsed();
 }
 
+bool YulStack::importBinaryAndAnalyze(std::string const& _sourceName, std::string const& _binary)
+{
+	m_errors.clear();
+	yulAssert(m_stackState == Empty);
+
+	try
+	{
+		m_parserResult = ObjectBinaryReader::read(
+			bytesConstRef(reinterpret_cast<uint8_t const*>(_binary.data()), _binary.size()),
+			languageToDialect(m_language, m_evmVersion, m_eofVersion),
+			false /* _nativeLocations */
+		);
+	}
+	catch (ObjectBinaryFormatError const& _error)
+	{
+		m_errorReporter.parserError(6391_error, SourceLocation{}, _error.what());
+		return false;
+	}
+	if (!m_parserResult->hasCode())
+	{
+		m_errorReporter.parserError(6391_error, SourceLocation{}, "Binary Yul object without code.");
+		return false;
+	}
+
+	// Errors refer to the printed object, like after optimization.
+	m_stackState = Parsed;
+	m_charStream = std::make_unique<CharStream>(print(), _sourceName);
+	return analyzeParsed();
+}
+
 void YulStack::optimize()
 {
 	yulAssert(m_stackState >= AnalysisSuccessful, "Analysis was not successful.");
@@ -193,7 +224,12 @@ bool YulStack::analyzeParsed(Object& _object)
 
 void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 {
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, _optimize);
+	EVMObjectCompiler::compile(
+		*m_parserResult,
+		_assembly,
+		_optimize,
+		m_optimiserSettings.expectedExecutionsPerDeployment
+	);
 }
 
 void YulStack::reparse()
@@ -375,6 +411,14 @@ std::string YulStack::print() const
 	) + "\n";
 }
 
+bytes YulStack::binary() const
+{
+	yulAssert(m_stackState >= Parsed);
+	yulAssert(m_parserResult, "");
+	yulAssert(m_parserResult->hasCode(), "");
+	return ObjectBinaryWriter::write(*m_parserResult);
+}
+
 Json YulStack::astJson() const
 {
 	yulAssert(m_stackState >= Parsed);
@@ -405,7 +449,10 @@ Json YulStack::cfgJson() const
 		std::unique_ptr<ControlFlow> controlFlow = SSAControlFlowGraphBuilder::build(
 			*_object.analysisInfo.get(),
 			languageToDialect(m_language, m_evmVersion, m_eofVersion),
-			_object.code()->root()
+			_object.code()->root(),
+			boost::ends_with(_object.name, "_deployed") ?
+				std::make_optional(m_optimiserSettings.expectedExecutionsPerDeployment) :
+				std::nullopt
 		);
 		std::unique_ptr<ControlFlowLiveness> liveness = std::make_unique<ControlFlowLiveness>(*controlFlow);
 		YulControlFlowGraphExporter exporter(*controlFlow, liveness.get());
@@ -113,6 +113,11 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Runs the analysis step on an object in the binary format of ObjectBinaryWriter instead of parsing it,
+	/// returns false if the input cannot be assembled. Multiple calls overwrite the previous state.
+	/// Since the source of the object is not available, errors are reported without locations in it.
+	bool importBinaryAndAnalyze(std::string const& _sourceName, std::string const& _binary);
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
@@ -145,6 +150,8 @@ public:
 	/// Pretty-print the input after having parsed it.
 	std::string print() const;
 	Json astJson() const;
+	/// @returns the object in the binary format of ObjectBinaryWriter.
+	bytes binary() const;
 
 	// return the JSON representation of the YuL CFG (experimental)
 	Json cfgJson() const;
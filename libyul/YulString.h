@@ -23,8 +23,10 @@
 
 #include <fmt/format.h>
 
+#include <atomic>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <string_view>
@@ -37,6 +39,9 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// The repository is not thread-safe by default. While a ConcurrentAccess object exists,
+/// YulStrings can be created and accessed from multiple threads at the same time.
 class YulStringRepository
 {
 public:
@@ -52,11 +57,23 @@ public:
 		return inst;
 	}
 
+	/// While an instance of this class exists, accesses to the repository are synchronized.
+	/// Must not be created or destroyed while other threads are accessing the repository.
+	class ConcurrentAccess
+	{
+	public:
+		ConcurrentAccess() { ++concurrentAccessors(); }
+		~ConcurrentAccess() { --concurrentAccessors(); }
+		ConcurrentAccess(ConcurrentAccess const&) = delete;
+		ConcurrentAccess& operator=(ConcurrentAccess const&) = delete;
+	};
+
 	Handle stringToHandle(std::string_view const _string)
 	{
 		if (_string.empty())
 			return { 0, emptyHash() };
 		std::uint64_t h = hash(_string);
+		auto lock = lockIfConcurrent();
 		auto range = m_hashToID.equal_range(h);
 		for (auto it = range.first; it != range.second; ++it)
 			if (*m_strings[it->second] == _string)
@@ -67,7 +84,20 @@ public:
 
 		return Handle{id, h};
 	}
-	std::string const& idToString(size_t _id) const { return *m_strings.at(_id); }
+	std::string const& idToString(size_t _id) const
+	{
+		auto lock = lockIfConcurrent();
+		// The strings themselves never move, so the reference stays valid after unlocking.
+		return *m_strings.at(_id);
+	}
+	/// @returns a rough estimate of the memory (in bytes) occupied by the repository.
+	size_t approximateMemoryUsage() const
+	{
+		size_t result = m_hashToID.size() * (sizeof(std::uint64_t) + sizeof(size_t));
+		for (auto const& string: m_strings)
+			result += sizeof(std::string) + string->capacity();
+		return result;
+	}
 
 	static std::uint64_t hash(std::string_view const v)
 	{
@@ -115,6 +145,24 @@ private:
 		return callbacks;
 	}
 
+	static std::atomic<size_t>& concurrentAccessors()
+	{
+		static std::atomic<size_t> accessors{0};
+		return accessors;
+	}
+	/// Static, because the repository itself is replaced on reset.
+	static std::mutex& mutex()
+	{
+		static std::mutex repositoryMutex;
+		return repositoryMutex;
+	}
+	static std::unique_lock<std::mutex> lockIfConcurrent()
+	{
+		if (concurrentAccessors().load(std::memory_order_relaxed) > 0)
+			return std::unique_lock<std::mutex>(mutex());
+		return {};
+	}
+
 	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
 	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
 };
@@ -195,6 +195,8 @@ struct CFG
 		};
 		struct Terminated {};
 		langutil::DebugData::ConstPtr debugData;
+		/// Position of the block in ``CFG::blocks``. Used to store per-block data in dense arrays.
+		size_t index = 0;
 		std::vector<BasicBlock*> entries;
 		std::vector<Operation> operations;
 		/// True, if the block is the beginning of a disconnected subgraph. That is, if no block that is reachable
@@ -240,7 +242,7 @@ struct CFG
 
 	BasicBlock& makeBlock(langutil::DebugData::ConstPtr _debugData)
 	{
-		return blocks.emplace_back(BasicBlock{std::move(_debugData), {}, {}});
+		return blocks.emplace_back(BasicBlock{std::move(_debugData), blocks.size(), {}, {}});
 	}
 };
 
@@ -25,6 +25,7 @@
 #include <libyul/Utilities.h>
 #include <libyul/ControlFlowSideEffectsCollector.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/SwitchLowering.h>
 
 #include <libsolutil/Visitor.h>
 #include <libsolutil/Algorithms.h>
@@ -43,6 +44,9 @@
 #include <range/v3/view/take_last.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <algorithm>
+#include <functional>
+
 using namespace solidity;
 using namespace solidity::yul;
 
@@ -229,7 +233,8 @@ void markNeedsCleanStack(CFG& _cfg)
 std::unique_ptr<CFG> ControlFlowGraphBuilder::build(
 	AsmAnalysisInfo const& _analysisInfo,
 	Dialect const& _dialect,
-	Block const& _block
+	Block const& _block,
+	std::optional<size_t> _expectedExecutionsPerDeployment
 )
 {
 	std::optional<uint8_t> eofVersion;
@@ -240,7 +245,13 @@ std::unique_ptr<CFG> ControlFlowGraphBuilder::build(
 	result->entry = &result->makeBlock(debugDataOf(_block));
 
 	ControlFlowSideEffectsCollector sideEffects(_dialect, _block);
-	ControlFlowGraphBuilder builder(*result, _analysisInfo, sideEffects.functionSideEffects(), _dialect);
+	ControlFlowGraphBuilder builder(
+		*result,
+		_analysisInfo,
+		sideEffects.functionSideEffects(),
+		_dialect,
+		_expectedExecutionsPerDeployment
+	);
 	builder.m_currentBlock = result->entry;
 	builder(_block);
 
@@ -259,12 +270,14 @@ ControlFlowGraphBuilder::ControlFlowGraphBuilder(
 	CFG& _graph,
 	AsmAnalysisInfo const& _analysisInfo,
 	std::map<FunctionDefinition const*, ControlFlowSideEffects> const& _functionSideEffects,
-	Dialect const& _dialect
+	Dialect const& _dialect,
+	std::optional<size_t> _expectedExecutionsPerDeployment
 ):
 	m_graph(_graph),
 	m_info(_analysisInfo),
 	m_functionSideEffects(_functionSideEffects),
-	m_dialect(_dialect)
+	m_dialect(_dialect),
+	m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment)
 {
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&m_dialect))
 		m_simulateFunctionsWithJumps = !evmDialect->eofVersion().has_value();
@@ -397,6 +410,84 @@ void ControlFlowGraphBuilder::operator()(Switch const& _switch)
 	};
 	CFG::BasicBlock& afterSwitch = m_graph.makeBlock(preSwitchDebugData);
 	yulAssert(!_switch.cases.empty(), "");
+	std::vector<Case const*> valueCases;
+	for (Case const& switchCase: _switch.cases)
+		if (switchCase.value)
+			valueCases.emplace_back(&switchCase);
+	if (splitSwitchCases(valueCases.size(), m_expectedExecutionsPerDeployment))
+	{
+		std::optional<BuiltinHandle> const lessThanBuiltinHandle = m_dialect.findBuiltin("lt");
+		yulAssert(lessThanBuiltinHandle);
+
+		// Artificially generate:
+		// lt(<ghostVariable>, <literal>)
+		auto makeLessThanCompare = [&](Case const& _case) {
+			yul::FunctionCall const& ghostCall = m_graph.ghostCalls.emplace_back(yul::FunctionCall{
+				debugDataOf(_case),
+				BuiltinName{{}, *lessThanBuiltinHandle},
+				{Identifier{{}, ghostVariableName}, *_case.value}
+			});
+			BuiltinFunction const& lessThanBuiltin = m_dialect.builtin(*lessThanBuiltinHandle);
+			CFG::Operation& operation = m_currentBlock->operations.emplace_back(CFG::Operation{
+				Stack{LiteralSlot{_case.value->value.value(), debugDataOf(*_case.value)}, ghostVarSlot},
+				Stack{TemporarySlot{ghostCall, 0}},
+				CFG::BuiltinCall{debugDataOf(_case), lessThanBuiltin, ghostCall, 2},
+			});
+			return operation.output.front();
+		};
+
+		std::map<Case const*, CFG::BasicBlock*> caseBranches;
+		for (Case const& switchCase: _switch.cases)
+			caseBranches[&switchCase] = &m_graph.makeBlock(debugDataOf(switchCase.body));
+		CFG::BasicBlock& defaultBranch = _switch.cases.back().value ? afterSwitch : *caseBranches.at(&_switch.cases.back());
+
+		// Binary search for the case among the sorted case values, which compares against the
+		// remaining values one after the other once splitting them further does not pay off.
+		std::sort(valueCases.begin(), valueCases.end(), [](Case const* _lhs, Case const* _rhs) {
+			return _lhs->value->value.value() < _rhs->value->value.value();
+		});
+		std::function<void(size_t, size_t)> selectCase = [&](size_t _begin, size_t _end) {
+			if (splitSwitchCases(_end - _begin, m_expectedExecutionsPerDeployment))
+			{
+				size_t const pivot = (_begin + _end) / 2;
+				CFG::BasicBlock& lowerCases = m_graph.makeBlock(debugDataOf(_switch));
+				CFG::BasicBlock& upperCases = m_graph.makeBlock(debugDataOf(_switch));
+				makeConditionalJump(
+					debugDataOf(*valueCases[pivot]),
+					makeLessThanCompare(*valueCases[pivot]),
+					lowerCases,
+					upperCases
+				);
+				m_currentBlock = &lowerCases;
+				selectCase(_begin, pivot);
+				m_currentBlock = &upperCases;
+				selectCase(pivot, _end);
+			}
+			else
+				for (size_t index = _begin; index < _end; ++index)
+				{
+					Case const& switchCase = *valueCases[index];
+					CFG::BasicBlock& elseBranch = index + 1 < _end ? m_graph.makeBlock(debugDataOf(_switch)) : defaultBranch;
+					makeConditionalJump(
+						debugDataOf(switchCase),
+						makeValueCompare(switchCase),
+						*caseBranches.at(&switchCase),
+						elseBranch
+					);
+					m_currentBlock = &elseBranch;
+				}
+		};
+		selectCase(0, valueCases.size());
+
+		for (Case const& switchCase: _switch.cases)
+		{
+			m_currentBlock = caseBranches.at(&switchCase);
+			(*this)(switchCase.body);
+			jump(debugDataOf(switchCase.body), afterSwitch);
+		}
+		return;
+	}
+
 	for (auto const& switchCase: _switch.cases | ranges::views::drop_last(1))
 	{
 		yulAssert(switchCase.value, "");
@@ -496,7 +587,7 @@ void ControlFlowGraphBuilder::operator()(FunctionDefinition const& _function)
 
 	CFG::FunctionInfo& functionInfo = m_graph.functionInfo.at(&function);
 
-	ControlFlowGraphBuilder builder{m_graph, m_info, m_functionSideEffects, m_dialect};
+	ControlFlowGraphBuilder builder{m_graph, m_info, m_functionSideEffects, m_dialect, m_expectedExecutionsPerDeployment};
 	builder.m_currentFunction = &functionInfo;
 	builder.m_currentBlock = functionInfo.entry;
 	builder(_function.body);
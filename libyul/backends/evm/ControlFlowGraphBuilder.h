@@ -31,7 +31,14 @@ class ControlFlowGraphBuilder
 public:
 	ControlFlowGraphBuilder(ControlFlowGraphBuilder const&) = delete;
 	ControlFlowGraphBuilder& operator=(ControlFlowGraphBuilder const&) = delete;
-	static std::unique_ptr<CFG> build(AsmAnalysisInfo const& _analysisInfo, Dialect const& _dialect, Block const& _block);
+	/// @param _expectedExecutionsPerDeployment used to decide how switches are lowered, nullopt
+	/// for creation code.
+	static std::unique_ptr<CFG> build(
+		AsmAnalysisInfo const& _analysisInfo,
+		Dialect const& _dialect,
+		Block const& _block,
+		std::optional<size_t> _expectedExecutionsPerDeployment = std::nullopt
+	);
 
 	StackSlot operator()(Expression const& _literal);
 	StackSlot operator()(Literal const& _literal);
@@ -57,7 +64,8 @@ private:
 		CFG& _graph,
 		AsmAnalysisInfo const& _analysisInfo,
 		std::map<FunctionDefinition const*, ControlFlowSideEffects> const& _functionSideEffects,
-		Dialect const& _dialect
+		Dialect const& _dialect,
+		std::optional<size_t> _expectedExecutionsPerDeployment
 	);
 	void registerFunction(FunctionDefinition const& _function);
 	Stack const& visitFunctionCall(FunctionCall const&);
@@ -81,6 +89,7 @@ private:
 	AsmAnalysisInfo const& m_info;
 	std::map<FunctionDefinition const*, ControlFlowSideEffects> const& m_functionSideEffects;
 	Dialect const& m_dialect;
+	std::optional<size_t> m_expectedExecutionsPerDeployment;
 	CFG::BasicBlock* m_currentBlock = nullptr;
 	Scope* m_scope = nullptr;
 	struct ForLoopInfo
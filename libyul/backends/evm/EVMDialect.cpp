@@ -547,9 +547,14 @@ EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _evmVers
 {
 	static std::map<std::pair<langutil::EVMVersion, std::optional<uint8_t>>, std::unique_ptr<EVMDialect const>> dialects;
 	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[{_evmVersion, _eofVersion}])
-		dialects[{_evmVersion, _eofVersion}] = std::make_unique<EVMDialect>(_evmVersion, _eofVersion, false);
-	return *dialects[{_evmVersion, _eofVersion}];
+	// Only look up the dialect once it exists, since it may be requested by multiple threads concurrently.
+	auto it = dialects.find({_evmVersion, _eofVersion});
+	if (it == dialects.end())
+		it = dialects.emplace(
+			std::make_pair(_evmVersion, _eofVersion),
+			std::make_unique<EVMDialect>(_evmVersion, _eofVersion, false)
+		).first;
+	return *it->second;
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _evmVersion, std::optional<uint8_t> _eofVersion)
@@ -37,14 +37,15 @@ using namespace solidity::yul;
 void EVMObjectCompiler::compile(
 	Object const& _object,
 	AbstractAssembly& _assembly,
-	bool _optimize
+	bool _optimize,
+	size_t _expectedExecutionsPerDeployment
 )
 {
 	EVMObjectCompiler compiler(_assembly);
-	compiler.run(_object, _optimize);
+	compiler.run(_object, _optimize, _expectedExecutionsPerDeployment);
 }
 
-void EVMObjectCompiler::run(Object const& _object, bool _optimize)
+void EVMObjectCompiler::run(Object const& _object, bool _optimize, size_t _expectedExecutionsPerDeployment)
 {
 	yulAssert(_object.dialect());
 	auto const* evmDialect = dynamic_cast<EVMDialect const*>(_object.dialect());
@@ -61,7 +62,7 @@ void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 			auto subAssemblyAndID = m_assembly.createSubAssembly(isCreation, subObject->name);
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
 			subObject->subId = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, _optimize);
+			compile(*subObject, *subAssemblyAndID.first, _optimize, _expectedExecutionsPerDeployment);
 		}
 		else
 		{
@@ -88,7 +89,8 @@ void EVMObjectCompiler::run(Object const& _object, bool _optimize)
 			_object.code()->root(),
 			*evmDialect,
 			context,
-			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName
+			OptimizedEVMCodeTransform::UseNamedLabels::ForFirstFunctionOfEachName,
+			boost::ends_with(_object.name, "_deployed") ? std::make_optional(_expectedExecutionsPerDeployment) : std::nullopt
 		);
 		if (!stackErrors.empty())
 		{
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <optional>
+#include <cstddef>
 #include <cstdint>
 
 namespace solidity::yul
@@ -33,15 +34,17 @@ class EVMDialect;
 class EVMObjectCompiler
 {
 public:
+	/// @param _expectedExecutionsPerDeployment expected number of executions of the deployed code.
 	static void compile(
 		Object const& _object,
 		AbstractAssembly& _assembly,
-		bool _optimize
+		bool _optimize,
+		size_t _expectedExecutionsPerDeployment
 	);
 private:
 	EVMObjectCompiler(AbstractAssembly& _assembly): m_assembly(_assembly) {}
 
-	void run(Object const& _object, bool _optimize);
+	void run(Object const& _object, bool _optimize, size_t _expectedExecutionsPerDeployment);
 
 	AbstractAssembly& m_assembly;
 };
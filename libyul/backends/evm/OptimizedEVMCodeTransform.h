@@ -53,7 +53,8 @@ public:
 		Block const& _block,
 		EVMDialect const& _dialect,
 		BuiltinContext& _builtinContext,
-		UseNamedLabels _useNamedLabelsForFunctions
+		UseNamedLabels _useNamedLabelsForFunctions,
+		std::optional<size_t> _expectedExecutionsPerDeployment = std::nullopt
 	);
 
 	/// Generate code for the function call @a _call. Only public for using with std::visit.
@@ -23,6 +23,7 @@
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
 #include <libyul/backends/evm/ControlFlow.h>
+#include <libyul/backends/evm/SwitchLowering.h>
 #include <libyul/ControlFlowSideEffectsCollector.h>
 #include <libyul/Utilities.h>
 
@@ -38,6 +39,9 @@
 #include <range/v3/view/transform.hpp>
 #include <range/v3/view/zip.hpp>
 
+#include <algorithm>
+#include <functional>
+
 using namespace solidity;
 using namespace solidity::yul;
 
@@ -49,26 +53,36 @@ SSAControlFlowGraphBuilder::SSAControlFlowGraphBuilder(
 	SSACFG& _graph,
 	AsmAnalysisInfo const& _analysisInfo,
 	ControlFlowSideEffectsCollector const& _sideEffects,
-	Dialect const& _dialect
+	Dialect const& _dialect,
+	std::optional<size_t> _expectedExecutionsPerDeployment
 ):
 	m_controlFlow(_controlFlow),
 	m_graph(_graph),
 	m_info(_analysisInfo),
 	m_sideEffects(_sideEffects),
-	m_dialect(_dialect)
+	m_dialect(_dialect),
+	m_expectedExecutionsPerDeployment(_expectedExecutionsPerDeployment)
 {
 }
 
 std::unique_ptr<ControlFlow> SSAControlFlowGraphBuilder::build(
 	AsmAnalysisInfo const& _analysisInfo,
 	Dialect const& _dialect,
-	Block const& _block
+	Block const& _block,
+	std::optional<size_t> _expectedExecutionsPerDeployment
 )
 {
 	ControlFlowSideEffectsCollector sideEffects(_dialect, _block);
 
 	auto controlFlow = std::make_unique<ControlFlow>();
-	SSAControlFlowGraphBuilder builder(*controlFlow, *controlFlow->mainGraph, _analysisInfo, sideEffects, _dialect);
+	SSAControlFlowGraphBuilder builder(
+		*controlFlow,
+		*controlFlow->mainGraph,
+		_analysisInfo,
+		sideEffects,
+		_dialect,
+		_expectedExecutionsPerDeployment
+	);
 	builder.m_currentBlock = controlFlow->mainGraph->makeBlock(debugDataOf(_block));
 	builder.sealBlock(builder.m_currentBlock);
 	builder(_block);
@@ -240,7 +254,7 @@ void SSAControlFlowGraphBuilder::buildFunctionGraph(
 	cfg.arguments = arguments;
 	cfg.returns = returns;
 
-	SSAControlFlowGraphBuilder builder(m_controlFlow, cfg, m_info, m_sideEffects, m_dialect);
+	SSAControlFlowGraphBuilder builder(m_controlFlow, cfg, m_info, m_sideEffects, m_dialect, m_expectedExecutionsPerDeployment);
 	builder.m_currentBlock = cfg.entry;
 	builder.m_functionDefinitions = m_functionDefinitions;
 	for (auto&& [var, varId]: cfg.arguments)
@@ -366,6 +380,92 @@ void SSAControlFlowGraphBuilder::operator()(Switch const& _switch)
 
 		auto afterSwitch = m_graph.makeBlock(debugDataOf(currentBlock()));
 		yulAssert(!_switch.cases.empty(), "");
+		std::vector<Case const*> valueCases;
+		for (Case const& switchCase: _switch.cases)
+			if (switchCase.value)
+				valueCases.emplace_back(&switchCase);
+		if (splitSwitchCases(valueCases.size(), m_expectedExecutionsPerDeployment))
+		{
+			std::optional<BuiltinHandle> lessThanBuiltinHandle = m_dialect.findBuiltin("lt");
+			yulAssert(lessThanBuiltinHandle);
+
+			auto makeLessThanCompare = [&](Case const& _case) {
+				FunctionCall const& ghostCall = m_graph.ghostCalls.emplace_back(FunctionCall{
+					debugDataOf(_case),
+					BuiltinName{{}, *lessThanBuiltinHandle},
+					{*_case.value /* skip first argument */ }
+				});
+				auto outputValue = m_graph.newVariable(m_currentBlock);
+				currentBlock().operations.emplace_back(SSACFG::Operation{
+					{outputValue},
+					SSACFG::BuiltinCall{
+						debugDataOf(_case),
+						m_dialect.builtin(*lessThanBuiltinHandle),
+						ghostCall
+					},
+					// Inputs are in reverse order of the arguments, i.e. this is lt(expression, value).
+					{m_graph.newLiteral(debugDataOf(_case), _case.value->value.value()), expression}
+				});
+				return outputValue;
+			};
+
+			std::map<Case const*, SSACFG::BlockId> caseBranches;
+			for (Case const& switchCase: _switch.cases)
+				caseBranches[&switchCase] = m_graph.makeBlock(debugDataOf(switchCase.body));
+			SSACFG::BlockId defaultBranch = _switch.cases.back().value ? afterSwitch : caseBranches.at(&_switch.cases.back());
+
+			// Binary search for the case among the sorted case values, which compares against the
+			// remaining values one after the other once splitting them further does not pay off.
+			std::sort(valueCases.begin(), valueCases.end(), [](Case const* _lhs, Case const* _rhs) {
+				return _lhs->value->value.value() < _rhs->value->value.value();
+			});
+			std::function<void(size_t, size_t)> selectCase = [&](size_t _begin, size_t _end) {
+				if (splitSwitchCases(_end - _begin, m_expectedExecutionsPerDeployment))
+				{
+					size_t const pivot = (_begin + _end) / 2;
+					auto lowerCases = m_graph.makeBlock(debugDataOf(_switch));
+					auto upperCases = m_graph.makeBlock(debugDataOf(_switch));
+					conditionalJump(
+						debugDataOf(*valueCases[pivot]),
+						makeLessThanCompare(*valueCases[pivot]),
+						lowerCases,
+						upperCases
+					);
+					sealBlock(lowerCases);
+					sealBlock(upperCases);
+					m_currentBlock = lowerCases;
+					selectCase(_begin, pivot);
+					m_currentBlock = upperCases;
+					selectCase(pivot, _end);
+				}
+				else
+					for (size_t index = _begin; index < _end; ++index)
+					{
+						Case const& switchCase = *valueCases[index];
+						bool const lastCase = index + 1 == _end;
+						auto caseBranch = caseBranches.at(&switchCase);
+						auto elseBranch = lastCase ? defaultBranch : m_graph.makeBlock(debugDataOf(_switch));
+						conditionalJump(debugDataOf(switchCase), makeValueCompare(switchCase), caseBranch, elseBranch);
+						sealBlock(caseBranch);
+						if (!lastCase)
+							sealBlock(elseBranch);
+						m_currentBlock = elseBranch;
+					}
+			};
+			selectCase(0, valueCases.size());
+			if (defaultBranch != afterSwitch)
+				sealBlock(defaultBranch);
+
+			for (Case const& switchCase: _switch.cases)
+			{
+				m_currentBlock = caseBranches.at(&switchCase);
+				(*this)(switchCase.body);
+				jump(debugDataOf(switchCase.body), afterSwitch);
+			}
+			sealBlock(afterSwitch);
+			return;
+		}
+
 		for (auto const& switchCase: _switch.cases | ranges::views::drop_last(1))
 		{
 			yulAssert(switchCase.value, "");
@@ -44,15 +44,19 @@ class SSAControlFlowGraphBuilder
 		SSACFG& _graph,
 		AsmAnalysisInfo const& _analysisInfo,
 		ControlFlowSideEffectsCollector const& _sideEffects,
-		Dialect const& _dialect
+		Dialect const& _dialect,
+		std::optional<size_t> _expectedExecutionsPerDeployment
 	);
 public:
 	SSAControlFlowGraphBuilder(SSAControlFlowGraphBuilder const&) = delete;
 	SSAControlFlowGraphBuilder& operator=(SSAControlFlowGraphBuilder const&) = delete;
+	/// @param _expectedExecutionsPerDeployment used to decide how switches are lowered, nullopt
+	/// for creation code.
 	static std::unique_ptr<ControlFlow> build(
 		AsmAnalysisInfo const& _analysisInfo,
 		Dialect const& _dialect,
-		Block const& _block
+		Block const& _block,
+		std::optional<size_t> _expectedExecutionsPerDeployment = std::nullopt
 	);
 
 	void operator()(ExpressionStatement const& _statement);
@@ -92,6 +96,7 @@ private:
 	AsmAnalysisInfo const& m_info;
 	ControlFlowSideEffectsCollector const& m_sideEffects;
 	Dialect const& m_dialect;
+	std::optional<size_t> m_expectedExecutionsPerDeployment;
 	std::vector<std::tuple<Scope::Function const*, FunctionDefinition const*>> m_functionDefinitions;
 	SSACFG::BlockId m_currentBlock;
 	SSACFG::BasicBlock& currentBlock() { return m_graph.block(m_currentBlock); }
@@ -47,7 +47,7 @@ using namespace solidity::yul;
 
 StackLayout StackLayoutGenerator::run(CFG const& _cfg, bool _simulateFunctionsWithJumps)
 {
-	StackLayout stackLayout{{}, {}};
+	StackLayout stackLayout{std::vector<std::optional<StackLayout::BlockInfo>>(_cfg.blocks.size())};
 	StackLayoutGenerator{stackLayout, nullptr, _simulateFunctionsWithJumps}.processEntryPoint(*_cfg.entry);
 
 	for (auto& functionInfo: _cfg.functionInfo | ranges::views::values)
@@ -68,7 +68,7 @@ std::map<YulName, std::vector<StackLayoutGenerator::StackTooDeep>> StackLayoutGe
 
 std::vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStackTooDeep(CFG const& _cfg, YulName _functionName, bool _simulateFunctionsWithJumps)
 {
-	StackLayout stackLayout{{}, {}};
+	StackLayout stackLayout{std::vector<std::optional<StackLayout::BlockInfo>>(_cfg.blocks.size())};
 	CFG::FunctionInfo const* functionInfo = nullptr;
 	if (!_functionName.empty())
 	{
@@ -266,7 +266,12 @@ Stack createIdealLayout(Stack const& _operationOutput, Stack const& _post, Calla
 }
 }
 
-Stack StackLayoutGenerator::propagateStackThroughOperation(Stack _exitStack, CFG::Operation const& _operation, bool _aggressiveStackCompression)
+Stack StackLayoutGenerator::propagateStackThroughOperation(
+	Stack _exitStack,
+	CFG::Operation const& _operation,
+	Stack& _operationEntryLayout,
+	bool _aggressiveStackCompression
+)
 {
 	// Enable aggressive stack compression for recursive calls.
 	if (auto const* functionCall = std::get_if<CFG::FunctionCall>(&_operation.operation))
@@ -295,7 +300,7 @@ Stack StackLayoutGenerator::propagateStackThroughOperation(Stack _exitStack, CFG
 	// Store the exact desired operation entry layout. The stored layout will be recreated by the code transform
 	// before executing the operation. However, this recreation can produce slots that can be freely generated or
 	// are duplicated, i.e. we can compress the stack afterwards without causing problems for code generation later.
-	m_layout.operationEntryLayout[&_operation] = stack;
+	_operationEntryLayout = stack;
 
 	// Remove anything from the stack top that can be freely generated or dupped from deeper on the stack.
 	while (!stack.empty())
@@ -316,15 +321,21 @@ Stack StackLayoutGenerator::propagateStackThroughOperation(Stack _exitStack, CFG
 	return stack;
 }
 
-Stack StackLayoutGenerator::propagateStackThroughBlock(Stack _exitStack, CFG::BasicBlock const& _block, bool _aggressiveStackCompression)
+Stack StackLayoutGenerator::propagateStackThroughBlock(
+	Stack _exitStack,
+	CFG::BasicBlock const& _block,
+	StackLayout::BlockInfo& _info,
+	bool _aggressiveStackCompression
+)
 {
 	Stack stack = _exitStack;
+	_info.operationEntryLayouts.resize(_block.operations.size());
 	for (auto&& [idx, operation]: _block.operations | ranges::views::enumerate | ranges::views::reverse)
 	{
-		Stack newStack = propagateStackThroughOperation(stack, operation, _aggressiveStackCompression);
+		Stack newStack = propagateStackThroughOperation(stack, operation, _info.operationEntryLayouts[idx], _aggressiveStackCompression);
 		if (!_aggressiveStackCompression && !findStackTooDeep(newStack, stack).empty())
 			// If we had stack errors, run again with aggressive stack compression.
-			return propagateStackThroughBlock(std::move(_exitStack), _block, true);
+			return propagateStackThroughBlock(std::move(_exitStack), _block, _info, true);
 		stack = std::move(newStack);
 	}
 
@@ -334,7 +345,7 @@ Stack StackLayoutGenerator::propagateStackThroughBlock(Stack _exitStack, CFG::Ba
 void StackLayoutGenerator::processEntryPoint(CFG::BasicBlock const& _entry, CFG::FunctionInfo const* _functionInfo)
 {
 	std::list<CFG::BasicBlock const*> toVisit{&_entry};
-	std::set<CFG::BasicBlock const*> visited;
+	std::vector<bool> visited(m_layout.blockInfos.size(), false);
 
 	// TODO: check whether visiting only a subset of these in the outer iteration below is enough.
 	std::list<std::pair<CFG::BasicBlock const*, CFG::BasicBlock const*>> backwardsJumps = collectBackwardsJumps(_entry);
@@ -348,15 +359,17 @@ void StackLayoutGenerator::processEntryPoint(CFG::BasicBlock const& _entry, CFG:
 			CFG::BasicBlock const *block = *toVisit.begin();
 			toVisit.pop_front();
 
-			if (visited.count(block))
+			if (visited[block->index])
 				continue;
 
 			if (std::optional<Stack> exitLayout = getExitLayoutOrStageDependencies(*block, visited, toVisit))
 			{
-				visited.emplace(block);
-				auto& info = m_layout.blockInfos[block];
-				info.exitLayout = *exitLayout;
-				info.entryLayout = propagateStackThroughBlock(info.exitLayout, *block);
+				visited[block->index] = true;
+				std::optional<StackLayout::BlockInfo>& info = m_layout.blockInfos[block->index];
+				if (!info)
+					info.emplace();
+				info->exitLayout = *exitLayout;
+				info->entryLayout = propagateStackThroughBlock(info->exitLayout, *block, *info);
 
 				for (auto entry: block->entries)
 					toVisit.emplace_back(entry);
@@ -370,8 +383,8 @@ void StackLayoutGenerator::processEntryPoint(CFG::BasicBlock const& _entry, CFG:
 			// This block jumps backwards, but does not provide all slots required by the jump target on exit.
 			// Therefore we need to visit the subgraph between ``target`` and ``jumpingBlock`` again.
 			if (ranges::any_of(
-				m_layout.blockInfos[target].entryLayout,
-				[exitLayout = m_layout.blockInfos[jumpingBlock].exitLayout](StackSlot const& _slot) {
+				m_layout.blockInfo(*target).entryLayout,
+				[&exitLayout = m_layout.blockInfo(*jumpingBlock).exitLayout](StackSlot const& _slot) {
 					return !util::contains(exitLayout, _slot);
 				}
 			))
@@ -383,10 +396,10 @@ void StackLayoutGenerator::processEntryPoint(CFG::BasicBlock const& _entry, CFG:
 				// This is not required for correctness, since the set of stack slots will match, but it may move some
 				// required stack shuffling from the loop condition to outside the loop.
 				for (CFG::BasicBlock const* entry: target->entries)
-					visited.erase(entry);
+					visited[entry->index] = false;
 				util::BreadthFirstSearch<CFG::BasicBlock const*>{{jumpingBlock}}.run(
 					[&visited, target = target](CFG::BasicBlock const* _block, auto _addChild) {
-						visited.erase(_block);
+						visited[_block->index] = false;
 						if (_block == target)
 							return;
 						for (auto const* entry: _block->entries)
@@ -407,7 +420,7 @@ void StackLayoutGenerator::processEntryPoint(CFG::BasicBlock const& _entry, CFG:
 
 std::optional<Stack> StackLayoutGenerator::getExitLayoutOrStageDependencies(
 	CFG::BasicBlock const& _block,
-	std::set<CFG::BasicBlock const*> const& _visited,
+	std::vector<bool> const& _visited,
 	std::list<CFG::BasicBlock const*>& _toVisit
 ) const
 {
@@ -423,27 +436,27 @@ std::optional<Stack> StackLayoutGenerator::getExitLayoutOrStageDependencies(
 			{
 				// Choose the best currently known entry layout of the jump target as initial exit.
 				// Note that this may not yet be the final layout.
-				if (auto* info = util::valueOrNullptr(m_layout.blockInfos, _jump.target))
+				if (std::optional<StackLayout::BlockInfo> const& info = m_layout.blockInfos[_jump.target->index])
 					return info->entryLayout;
 				return Stack{};
 			}
 			// If the current iteration has already visited the jump target, start from its entry layout.
-			if (_visited.count(_jump.target))
-				return m_layout.blockInfos.at(_jump.target).entryLayout;
+			if (_visited[_jump.target->index])
+				return m_layout.blockInfo(*_jump.target).entryLayout;
 			// Otherwise stage the jump target for visit and defer the current block.
 			_toVisit.emplace_front(_jump.target);
 			return std::nullopt;
 		},
 		[&](CFG::BasicBlock::ConditionalJump const& _conditionalJump) -> std::optional<Stack>
 		{
-			bool zeroVisited = _visited.count(_conditionalJump.zero);
-			bool nonZeroVisited = _visited.count(_conditionalJump.nonZero);
+			bool zeroVisited = _visited[_conditionalJump.zero->index];
+			bool nonZeroVisited = _visited[_conditionalJump.nonZero->index];
 			if (zeroVisited && nonZeroVisited)
 			{
 				// If the current iteration has already visited both jump targets, start from its entry layout.
 				Stack stack = combineStack(
-					m_layout.blockInfos.at(_conditionalJump.zero).entryLayout,
-					m_layout.blockInfos.at(_conditionalJump.nonZero).entryLayout
+					m_layout.blockInfo(*_conditionalJump.zero).entryLayout,
+					m_layout.blockInfo(*_conditionalJump.nonZero).entryLayout
 				);
 				// Additionally, the jump condition has to be at the stack top at exit.
 				stack.emplace_back(_conditionalJump.condition);
@@ -504,7 +517,7 @@ void StackLayoutGenerator::stitchConditionalJumps(CFG::BasicBlock const& _block)
 {
 	util::BreadthFirstSearch<CFG::BasicBlock const*> breadthFirstSearch{{&_block}};
 	breadthFirstSearch.run([&](CFG::BasicBlock const* _block, auto _addChild) {
-		auto& info = m_layout.blockInfos.at(_block);
+		auto& info = m_layout.blockInfo(*_block);
 		std::visit(util::GenericVisitor{
 			[&](CFG::BasicBlock::MainExit const&) {},
 			[&](CFG::BasicBlock::Jump const& _jump)
@@ -514,8 +527,8 @@ void StackLayoutGenerator::stitchConditionalJumps(CFG::BasicBlock const& _block)
 			},
 			[&](CFG::BasicBlock::ConditionalJump const& _conditionalJump)
 			{
-				auto& zeroTargetInfo = m_layout.blockInfos.at(_conditionalJump.zero);
-				auto& nonZeroTargetInfo = m_layout.blockInfos.at(_conditionalJump.nonZero);
+				auto& zeroTargetInfo = m_layout.blockInfo(*_conditionalJump.zero);
+				auto& nonZeroTargetInfo = m_layout.blockInfo(*_conditionalJump.nonZero);
 				Stack exitLayout = info.exitLayout;
 
 				// The last block must have produced the condition at the stack top.
@@ -638,26 +651,26 @@ std::vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStac
 	std::vector<StackTooDeep> stackTooDeepErrors;
 	util::BreadthFirstSearch<CFG::BasicBlock const*> breadthFirstSearch{{&_entry}};
 	breadthFirstSearch.run([&](CFG::BasicBlock const* _block, auto _addChild) {
-		Stack currentStack = m_layout.blockInfos.at(_block).entryLayout;
+		StackLayout::BlockInfo const& blockInfo = m_layout.blockInfo(*_block);
+		Stack currentStack = blockInfo.entryLayout;
 
-		for (auto const& operation: _block->operations)
+		yulAssert(_block->operations.size() == blockInfo.operationEntryLayouts.size());
+		for (auto&& [operation, operationEntry]: ranges::zip_view(_block->operations, blockInfo.operationEntryLayouts))
 		{
-			Stack& operationEntry = m_layout.operationEntryLayout.at(&operation);
-
 			stackTooDeepErrors += findStackTooDeep(currentStack, operationEntry);
 			currentStack = operationEntry;
 			for (size_t i = 0; i < operation.input.size(); i++)
 				currentStack.pop_back();
 			currentStack += operation.output;
 		}
-		// Do not attempt to create the exit layout m_layout.blockInfos.at(_block).exitLayout here,
+		// Do not attempt to create the exit layout m_layout.blockInfo(*_block).exitLayout here,
 		// since the code generator will directly move to the target entry layout.
 
 		std::visit(util::GenericVisitor{
 			[&](CFG::BasicBlock::MainExit const&) {},
 			[&](CFG::BasicBlock::Jump const& _jump)
 			{
-				Stack const& targetLayout = m_layout.blockInfos.at(_jump.target).entryLayout;
+				Stack const& targetLayout = m_layout.blockInfo(*_jump.target).entryLayout;
 				stackTooDeepErrors += findStackTooDeep(currentStack, targetLayout);
 
 				if (!_jump.backwards)
@@ -666,8 +679,8 @@ std::vector<StackLayoutGenerator::StackTooDeep> StackLayoutGenerator::reportStac
 			[&](CFG::BasicBlock::ConditionalJump const& _conditionalJump)
 			{
 				for (Stack const& targetLayout: {
-					m_layout.blockInfos.at(_conditionalJump.zero).entryLayout,
-					m_layout.blockInfos.at(_conditionalJump.nonZero).entryLayout
+					m_layout.blockInfo(*_conditionalJump.zero).entryLayout,
+					m_layout.blockInfo(*_conditionalJump.nonZero).entryLayout
 				})
 					stackTooDeepErrors += findStackTooDeep(currentStack, targetLayout);
 
@@ -716,13 +729,10 @@ void StackLayoutGenerator::fillInJunk(CFG::BasicBlock const& _block, CFG::Functi
 	auto addJunkRecursive = [&](CFG::BasicBlock const* _entry, size_t _numJunk) {
 		util::BreadthFirstSearch<CFG::BasicBlock const*> breadthFirstSearch{{_entry}};
 		breadthFirstSearch.run([&](CFG::BasicBlock const* _block, auto _addChild) {
-			auto& blockInfo = m_layout.blockInfos.at(_block);
+			auto& blockInfo = m_layout.blockInfo(*_block);
 			blockInfo.entryLayout = Stack{_numJunk, JunkSlot{}} + std::move(blockInfo.entryLayout);
-			for (auto const& operation: _block->operations)
-			{
-				auto& operationEntryLayout = m_layout.operationEntryLayout.at(&operation);
+			for (auto& operationEntryLayout: blockInfo.operationEntryLayouts)
 				operationEntryLayout = Stack{_numJunk, JunkSlot{}} + std::move(operationEntryLayout);
-			}
 			blockInfo.exitLayout = Stack{_numJunk, JunkSlot{}} + std::move(blockInfo.exitLayout);
 
 			std::visit(util::GenericVisitor{
@@ -802,7 +812,7 @@ void StackLayoutGenerator::fillInJunk(CFG::BasicBlock const& _block, CFG::Functi
 	{
 		size_t bestNumJunk = getBestNumJunk(
 			_functionInfo->parameters | ranges::views::reverse | ranges::to<Stack>,
-			m_layout.blockInfos.at(&_block).entryLayout
+			m_layout.blockInfo(_block).entryLayout
 		);
 		if (bestNumJunk > 0)
 			addJunkRecursive(&_block, bestNumJunk);
@@ -814,9 +824,9 @@ void StackLayoutGenerator::fillInJunk(CFG::BasicBlock const& _block, CFG::Functi
 	util::BreadthFirstSearch<CFG::BasicBlock const*>{{&_block}}.run([&](CFG::BasicBlock const* _block, auto _addChild) {
 		if (_block->allowsJunk())
 		{
-			auto& blockInfo = m_layout.blockInfos.at(_block);
+			auto& blockInfo = m_layout.blockInfo(*_block);
 			Stack entryLayout = blockInfo.entryLayout;
-			Stack const& nextLayout = _block->operations.empty() ? blockInfo.exitLayout : m_layout.operationEntryLayout.at(&_block->operations.front());
+			Stack const& nextLayout = _block->operations.empty() ? blockInfo.exitLayout : blockInfo.operationEntryLayouts.front();
 			if (entryLayout != nextLayout)
 			{
 				size_t bestNumJunk = getBestNumJunk(
@@ -24,6 +24,8 @@
 #include <libyul/backends/evm/ControlFlowGraph.h>
 
 #include <map>
+#include <optional>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -36,12 +38,25 @@ struct StackLayout
 		Stack entryLayout;
 		/// The resulting stack layout after executing the block.
 		Stack exitLayout;
+		/// For each operation of the block in order the complete stack layout that:
+		/// - has the slots required for the operation at the stack top.
+		/// - will have the operation result in a layout that makes it easy to achieve the next desired layout.
+		std::vector<Stack> operationEntryLayouts;
 	};
-	std::map<CFG::BasicBlock const*, BlockInfo> blockInfos;
-	/// For each operation the complete stack layout that:
-	/// - has the slots required for the operation at the stack top.
-	/// - will have the operation result in a layout that makes it easy to achieve the next desired layout.
-	std::map<CFG::Operation const*, Stack> operationEntryLayout;
+	/// Layouts of all blocks indexed by ``CFG::BasicBlock::index``.
+	/// Blocks that have not been visited by the generator have no layout.
+	std::vector<std::optional<BlockInfo>> blockInfos;
+
+	BlockInfo const& blockInfo(CFG::BasicBlock const& _block) const
+	{
+		yulAssert(_block.index < blockInfos.size() && blockInfos[_block.index], "No stack layout for block.");
+		return *blockInfos[_block.index];
+	}
+	BlockInfo& blockInfo(CFG::BasicBlock const& _block)
+	{
+		yulAssert(_block.index < blockInfos.size() && blockInfos[_block.index], "No stack layout for block.");
+		return *blockInfos[_block.index];
+	}
 };
 
 class StackLayoutGenerator
@@ -70,22 +85,34 @@ private:
 
 	/// @returns the optimal entry stack layout, s.t. @a _operation can be applied to it and
 	/// the result can be transformed to @a _exitStack with minimal stack shuffling.
-	/// Simultaneously stores the entry layout required for executing the operation in m_layout.
-	Stack propagateStackThroughOperation(Stack _exitStack, CFG::Operation const& _operation, bool _aggressiveStackCompression = false);
+	/// Simultaneously stores the entry layout required for executing the operation in @a _operationEntryLayout.
+	Stack propagateStackThroughOperation(
+		Stack _exitStack,
+		CFG::Operation const& _operation,
+		Stack& _operationEntryLayout,
+		bool _aggressiveStackCompression = false
+	);
 
 	/// @returns the desired stack layout at the entry of @a _block, assuming the layout after
 	/// executing the block should be @a _exitStack.
-	Stack propagateStackThroughBlock(Stack _exitStack, CFG::BasicBlock const& _block, bool _aggressiveStackCompression = false);
+	/// Simultaneously stores the entry layouts of all operations of the block in @a _info.
+	Stack propagateStackThroughBlock(
+		Stack _exitStack,
+		CFG::BasicBlock const& _block,
+		StackLayout::BlockInfo& _info,
+		bool _aggressiveStackCompression = false
+	);
 
 	/// Main algorithm walking the graph from entry to exit and propagating back the stack layouts to the entries.
 	/// Iteratively reruns itself along backwards jumps until the layout is stabilized.
 	void processEntryPoint(CFG::BasicBlock const& _entry, CFG::FunctionInfo const* _functionInfo = nullptr);
 
-	/// @returns the best known exit layout of @a _block, if all dependencies are already @a _visited.
+	/// @returns the best known exit layout of @a _block, if all dependencies are already @a _visited,
+	/// which is indexed by ``CFG::BasicBlock::index``.
 	/// If not, adds the dependencies to @a _dependencyList and @returns std::nullopt.
 	std::optional<Stack> getExitLayoutOrStageDependencies(
 		CFG::BasicBlock const& _block,
-		std::set<CFG::BasicBlock const*> const& _visited,
+		std::vector<bool> const& _visited,
 		std::list<CFG::BasicBlock const*>& _dependencyList
 	) const;
 
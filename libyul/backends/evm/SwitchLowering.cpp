@@ -0,0 +1,43 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/backends/evm/SwitchLowering.h>
+
+#include <libevmasm/GasMeter.h>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+bool solidity::yul::splitSwitchCases(size_t _caseCount, std::optional<size_t> _expectedExecutionsPerDeployment)
+{
+	// This follows the selection of external functions in the legacy code generator.
+	// Comparing against each of n values costs (3 + 3 + 3 + 3 + 10) * n/2 = 12 * n gas on average,
+	// while comparing against the median first costs 24 * (n/4 + 1) = 6 * n + 24 gas on average,
+	// but adds about 17 bytes of code.
+	// Thus, we should split if
+	//     _runs * 12 * n > _runs * (6 * n + 24) + 17 * createDataGas
+	// <=> _runs * 6 * (n - 4) > 17 * createDataGas
+	size_t const runs = _expectedExecutionsPerDeployment.value_or(1);
+	// Start with some comparisons to avoid overflow, then do the actual comparison.
+	if (_caseCount <= 4)
+		return false;
+	else if (runs > (17 * evmasm::GasCosts::createDataGas) / 6)
+		return true;
+	else
+		return runs * 6 * (_caseCount - 4) > 17 * evmasm::GasCosts::createDataGas;
+}
@@ -0,0 +1,36 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cost model for lowering Yul switches to conditional jumps.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+namespace solidity::yul
+{
+
+/// @returns true if selecting among the values of @a _caseCount cases of a switch (excluding the
+/// default case) should start with comparing against the median value to halve the remaining
+/// cases, instead of comparing against each value one after the other.
+/// @param _expectedExecutionsPerDeployment nullopt for creation code, which is executed once.
+bool splitSwitchCases(size_t _caseCount, std::optional<size_t> _expectedExecutionsPerDeployment);
+
+}
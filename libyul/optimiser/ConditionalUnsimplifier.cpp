@@ -20,7 +20,6 @@
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 #include <libyul/optimiser/NameCollector.h>
-#include <libyul/ControlFlowSideEffectsCollector.h>
 #include <libsolutil/CommonData.h>
 
 using namespace solidity;
@@ -31,7 +30,7 @@ void ConditionalUnsimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
 	ConditionalUnsimplifier{
 		_context.dialect,
-		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
+		_context.analyses.controlFlowSideEffects(_context.dialect, _ast)
 	}(_ast);
 }
 
@@ -22,7 +22,6 @@
 
 #include <libyul/optimiser/EqualStoreEliminator.h>
 
-#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/AST.h>
@@ -33,11 +32,11 @@ using namespace solidity::util;
 using namespace solidity::evmasm;
 using namespace solidity::yul;
 
-void EqualStoreEliminator::run(OptimiserStepContext const& _context, Block& _ast)
+void EqualStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
 	EqualStoreEliminator eliminator{
 		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
+		_context.analyses.functionSideEffects(_context.dialect, _ast)
 	};
 	eliminator(_ast);
 
@@ -40,7 +40,7 @@ class EqualStoreEliminator: public DataFlowAnalyzer
 {
 public:
 	static constexpr char const* name{"EqualStoreEliminator"};
-	static void run(OptimiserStepContext const&, Block& _ast);
+	static void run(OptimiserStepContext&, Block& _ast);
 
 private:
 	EqualStoreEliminator(
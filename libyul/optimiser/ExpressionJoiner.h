@@ -21,6 +21,7 @@
  */
 #pragma once
 
+#include <libyul/optimiser/OptimiserAnalyses.h>
 #include <libyul/ASTForward.h>
 #include <libyul/optimiser/ASTWalker.h>
 
@@ -72,6 +73,7 @@ class ExpressionJoiner: public ASTModifier
 {
 public:
 	static constexpr char const* name{"ExpressionJoiner"};
+	static constexpr PreservedAnalyses preservedAnalyses = PreservedAnalyses::all();
 	static void run(OptimiserStepContext&, Block& _ast);
 
 private:
@@ -24,6 +24,7 @@
 #include <libyul/ASTForward.h>
 
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserAnalyses.h>
 #include <libyul/optimiser/NameDispenser.h>
 
 #include <vector>
@@ -59,6 +60,7 @@ class ExpressionSplitter: public ASTModifier
 {
 public:
 	static constexpr char const* name{"ExpressionSplitter"};
+	static constexpr PreservedAnalyses preservedAnalyses = PreservedAnalyses::all();
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	void operator()(FunctionCall&) override;
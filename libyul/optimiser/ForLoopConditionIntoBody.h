@@ -17,6 +17,7 @@
 // SPDX-License-Identifier: GPL-3.0
 #pragma once
 
+#include <libyul/optimiser/OptimiserAnalyses.h>
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/Dialect.h>
 
@@ -44,6 +45,13 @@ class ForLoopConditionIntoBody: public ASTModifier
 {
 public:
 	static constexpr char const* name{"ForLoopConditionIntoBody"};
+	/// Only adds or removes calls to side-effect-free builtins.
+	static constexpr PreservedAnalyses preservedAnalyses{
+		.callGraph = false,
+		.functionSideEffects = true,
+		.controlFlowSideEffects = true,
+		.containsMSize = true
+	};
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
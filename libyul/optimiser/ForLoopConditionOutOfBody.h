@@ -59,6 +59,13 @@ class ForLoopConditionOutOfBody: public ASTModifier
 {
 public:
 	static constexpr char const* name{"ForLoopConditionOutOfBody"};
+	/// Only adds or removes calls to side-effect-free builtins.
+	static constexpr PreservedAnalyses preservedAnalyses{
+		.callGraph = false,
+		.functionSideEffects = true,
+		.controlFlowSideEffects = true,
+		.containsMSize = true
+	};
 	static void run(OptimiserStepContext&, Block& _ast);
 
 	using ASTModifier::operator();
@@ -37,7 +37,8 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Visitor.h>
 
-#include <range/v3/action/remove.hpp>
+#include <functional>
+
 #include <range/v3/view/reverse.hpp>
 #include <range/v3/view/zip.hpp>
 
@@ -46,14 +47,15 @@ using namespace solidity::yul;
 
 void FullInliner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	FullInliner inliner{_ast, _context.dispenser, _context.dialect};
+	FullInliner inliner{_ast, _context.dispenser, _context.dialect, _context.analyses.callGraph(_ast)};
 	inliner.run(Pass::InlineTiny);
 	inliner.run(Pass::InlineRest);
 }
 
-FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect):
+FullInliner::FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect, CallGraph const& _callGraph):
 	m_ast(_ast),
-	m_recursiveFunctions(CallGraphGenerator::callGraph(_ast).recursiveFunctions()),
+	m_recursiveFunctions(_callGraph.recursiveFunctions()),
+	m_callGraph(_callGraph),
 	m_nameDispenser(_dispenser),
 	m_dialect(_dialect)
 {
@@ -101,7 +103,9 @@ void FullInliner::run(Pass _pass)
 	// function name) order.
 	// We use stable_sort below to keep the inlining order of two functions
 	// with the same depth.
-	std::map<FunctionHandle, size_t> depths = callDepths();
+	if (!m_callGraph)
+		m_callGraph = CallGraphGenerator::callGraph(m_ast);
+	std::map<FunctionHandle, size_t> depths = callDepths(*m_callGraph);
 	std::vector<FunctionDefinition*> functions;
 	for (auto& statement: m_ast.statements)
 		if (std::holds_alternative<FunctionDefinition>(statement))
@@ -113,63 +117,63 @@ void FullInliner::run(Pass _pass)
 		return depths.at(_a->name) < depths.at(_b->name);
 	});
 	for (FunctionDefinition* fun: functions)
-	{
-		handleBlock(fun->name, fun->body);
-		updateCodeSize(*fun);
-	}
+		if (handleBlock(fun->name, fun->body))
+		{
+			updateCodeSize(*fun);
+			m_callGraph.reset();
+		}
 
 	for (auto& statement: m_ast.statements)
 		if (std::holds_alternative<Block>(statement))
-			handleBlock({}, std::get<Block>(statement));
+			if (handleBlock({}, std::get<Block>(statement)))
+				m_callGraph.reset();
 }
 
-std::map<FunctionHandle, size_t> FullInliner::callDepths() const
+std::map<FunctionHandle, size_t> FullInliner::callDepths(CallGraph const& _callGraph)
 {
-	CallGraph cg = CallGraphGenerator::callGraph(m_ast);
-	cg.functionCalls.erase(""_yulname);
-
-	// Remove calls to builtin functions.
-	for (auto& call: cg.functionCalls)
-		for (auto it = call.second.begin(); it != call.second.end();)
-			if (std::holds_alternative<BuiltinHandle>(*it))
-				it = call.second.erase(it);
-			else
-				++it;
-
-	std::map<FunctionHandle, size_t> depths;
-	size_t currentDepth = 0;
-
-	while (true)
+	// The depth of a function that does not call other functions is zero, otherwise it
+	// is one larger than the maximum depth of its callees. Functions that are part of
+	// a cycle or call a function that is, do not have a depth (nullopt).
+	std::map<FunctionHandle, std::optional<size_t>> depths;
+	std::set<FunctionHandle> inProgress;
+	std::function<std::optional<size_t>(FunctionHandle const&)> depth = [&](FunctionHandle const& _function) -> std::optional<size_t>
 	{
-		std::vector<FunctionHandle> removed;
-		for (auto it = cg.functionCalls.begin(); it != cg.functionCalls.end();)
+		if (auto it = depths.find(_function); it != depths.end())
+			return it->second;
+		auto callees = _callGraph.functionCalls.find(_function);
+		if (inProgress.count(_function) || callees == _callGraph.functionCalls.end())
+			return std::nullopt;
+
+		inProgress.insert(_function);
+		std::optional<size_t> result = 0;
+		for (FunctionHandle const& callee: callees->second)
 		{
-			auto const& [fun, callees] = *it;
-			if (callees.empty())
-			{
-				removed.emplace_back(fun);
-				depths[fun] = currentDepth;
-				it = cg.functionCalls.erase(it);
-			}
-			else
-				++it;
+			// Builtins do not contribute to the depth.
+			if (std::holds_alternative<BuiltinHandle>(callee))
+				continue;
+			std::optional<size_t> calleeDepth = depth(callee);
+			if (!calleeDepth)
+				result = std::nullopt;
+			else if (result)
+				result = std::max(*result, *calleeDepth + 1);
 		}
+		inProgress.erase(_function);
+		return depths[_function] = result;
+	};
 
-		for (auto& call: cg.functionCalls)
-			for (FunctionHandle toBeRemoved: removed)
-				ranges::actions::remove(call.second, toBeRemoved);
-
-		currentDepth++;
-
-		if (removed.empty())
-			break;
-	}
-
-	// Only recursive functions left here.
-	for (auto const& fun: cg.functionCalls)
-		depths[fun.first] = currentDepth;
-
-	return depths;
+	std::optional<size_t> maxDepth;
+	for (auto const& [function, callees]: _callGraph.functionCalls)
+		if (function != FunctionHandle{YulName{}})
+			if (std::optional<size_t> functionDepth = depth(function))
+				maxDepth = std::max(maxDepth.value_or(0), *functionDepth);
+
+	// Recursive functions are handled last, with a gap to all others.
+	size_t const recursiveDepth = maxDepth ? *maxDepth + 2 : 1;
+	std::map<FunctionHandle, size_t> result;
+	for (auto const& [function, callees]: _callGraph.functionCalls)
+		if (function != FunctionHandle{YulName{}})
+			result[function] = depths.at(function).value_or(recursiveDepth);
+	return result;
 }
 
 bool FullInliner::shallInline(FunctionCall const& _funCall, YulName _callSite)
@@ -246,17 +250,17 @@ void FullInliner::tentativelyUpdateCodeSize(YulName _function, YulName _callSite
 void FullInliner::updateCodeSize(FunctionDefinition const& _fun)
 {
 	m_functionSizes[_fun.name] = CodeSize::codeSize(_fun.body);
+	if (ReferencesCounter::countReferences(_fun)[_fun.name] > 0)
+		m_selfRecursiveFunctions.insert(_fun.name);
+	else
+		m_selfRecursiveFunctions.erase(_fun.name);
 }
 
-void FullInliner::handleBlock(YulName _currentFunctionName, Block& _block)
+bool FullInliner::handleBlock(YulName _currentFunctionName, Block& _block)
 {
-	InlineModifier{*this, m_nameDispenser, _currentFunctionName, m_dialect}(_block);
-}
-
-bool FullInliner::recursive(FunctionDefinition const& _fun) const
-{
-	std::map<FunctionHandle, size_t> references = ReferencesCounter::countReferences(_fun);
-	return references[_fun.name] > 0;
+	InlineModifier modifier{*this, m_nameDispenser, _currentFunctionName, m_dialect};
+	modifier(_block);
+	return modifier.inlined();
 }
 
 void InlineModifier::operator()(Block& _block)
@@ -285,7 +289,10 @@ std::optional<std::vector<Statement>> InlineModifier::tryInlineStatement(Stateme
 			[](FunctionCall& _e) { return &_e; }
 		}, *e);
 		if (funCall && m_driver.shallInline(*funCall, m_currentFunction))
+		{
+			m_inlined = true;
 			return performInline(_statement, *funCall);
+		}
 	}
 	return {};
 }
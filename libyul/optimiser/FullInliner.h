@@ -24,6 +24,7 @@
 
 #include <libyul/optimiser/ASTCopier.h>
 #include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/Exceptions.h>
@@ -73,7 +74,8 @@ public:
 	static constexpr char const* name{"FullInliner"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
 
-	/// Inlining heuristic.
+	/// Inlining heuristic. It is based on the code size of the called function and of the
+	/// call site before inlining and on whether arguments are constant.
 	/// @param _callSite the name of the function in which the function call is located.
 	bool shallInline(FunctionCall const& _funCall, YulName _callSite);
 
@@ -93,16 +95,19 @@ public:
 private:
 	enum Pass { InlineTiny, InlineRest };
 
-	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect);
+	FullInliner(Block& _ast, NameDispenser& _dispenser, Dialect const& _dialect, CallGraph const& _callGraph);
 	void run(Pass _pass);
 
 	/// @returns a map containing the maximum depths of a call chain starting at each
-	/// function. For recursive functions, the value is one larger than for all others.
-	std::map<FunctionHandle, size_t> callDepths() const;
+	/// function. Functions that are recursive or call recursive functions get a value
+	/// one larger than all others.
+	static std::map<FunctionHandle, size_t> callDepths(CallGraph const& _callGraph);
 
+	/// Updates the size of @a _fun and whether it calls itself after its body changed.
 	void updateCodeSize(FunctionDefinition const& _fun);
-	void handleBlock(YulName _currentFunctionName, Block& _block);
-	bool recursive(FunctionDefinition const& _fun) const;
+	/// @returns true if any function call was inlined into @a _block.
+	bool handleBlock(YulName _currentFunctionName, Block& _block);
+	bool recursive(FunctionDefinition const& _fun) const { return m_selfRecursiveFunctions.count(_fun.name) > 0; }
 
 	Pass m_pass;
 	/// The AST to be modified. The root block itself will not be modified, because
@@ -115,6 +120,10 @@ private:
 	bool m_hasMemoryGuard = false;
 	/// Set of recursive functions.
 	std::set<FunctionHandle> m_recursiveFunctions;
+	/// Functions that call themselves directly. Unlike @a m_recursiveFunctions, this is kept up to date.
+	std::set<YulName> m_selfRecursiveFunctions;
+	/// Call graph of the AST, reset whenever a call is inlined.
+	std::optional<CallGraph> m_callGraph;
 	/// Names of functions to always inline.
 	std::set<YulName> m_singleUse;
 	/// Variables that are constants (used for inlining heuristic)
@@ -140,6 +149,9 @@ public:
 
 	void operator()(Block& _block) override;
 
+	/// @returns true if any function call was inlined.
+	bool inlined() const { return m_inlined; }
+
 private:
 	std::optional<std::vector<Statement>> tryInlineStatement(Statement& _statement);
 	std::vector<Statement> performInline(Statement& _statement, FunctionCall& _funCall);
@@ -148,6 +160,7 @@ private:
 	FullInliner& m_driver;
 	NameDispenser& m_nameDispenser;
 	Dialect const& m_dialect;
+	bool m_inlined = false;
 };
 
 /**
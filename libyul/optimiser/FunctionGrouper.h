@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <libyul/optimiser/OptimiserAnalyses.h>
 #include <libyul/ASTForward.h>
 
 namespace solidity::yul
@@ -41,6 +42,7 @@ class FunctionGrouper
 {
 public:
 	static constexpr char const* name{"FunctionGrouper"};
+	static constexpr PreservedAnalyses preservedAnalyses = PreservedAnalyses::all();
 	static void run(OptimiserStepContext&, Block& _ast) { FunctionGrouper{}(_ast); }
 
 	void operator()(Block& _block);
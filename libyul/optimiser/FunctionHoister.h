@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <libyul/optimiser/OptimiserAnalyses.h>
 #include <libyul/ASTForward.h>
 #include <libyul/optimiser/ASTWalker.h>
 
@@ -40,6 +41,7 @@ class FunctionHoister: public ASTModifier
 {
 public:
 	static constexpr char const* name{"FunctionHoister"};
+	static constexpr PreservedAnalyses preservedAnalyses = PreservedAnalyses::all();
 	static void run(OptimiserStepContext&, Block& _ast) { FunctionHoister{}(_ast); }
 
 	using ASTModifier::operator();
@@ -19,7 +19,6 @@
 #include <libyul/optimiser/FunctionSpecializer.h>
 
 #include <libyul/optimiser/ASTCopier.h>
-#include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/NameCollector.h>
 #include <libyul/optimiser/NameDispenser.h>
 
@@ -129,7 +128,7 @@ FunctionDefinition FunctionSpecializer::specialize(
 void FunctionSpecializer::run(OptimiserStepContext& _context, Block& _ast)
 {
 	FunctionSpecializer f{
-		CallGraphGenerator::callGraph(_ast).recursiveFunctions(),
+		_context.analyses.callGraph(_ast).recursiveFunctions(),
 		_context.dispenser
 	};
 	f(_ast);
@@ -75,6 +75,12 @@ std::optional<u256> KnowledgeBase::valueIfKnownConstant(YulName _a)
 	return explore(_a).absoluteValue();
 }
 
+std::pair<YulName, u256> KnowledgeBase::representativeAndOffset(YulName _a)
+{
+	VariableOffset offset = explore(_a);
+	return {offset.reference, offset.offset};
+}
+
 std::optional<u256> KnowledgeBase::valueIfKnownConstant(Expression const& _expression)
 {
 	if (Identifier const* ident = std::get_if<Identifier>(&_expression))
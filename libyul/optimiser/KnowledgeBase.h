@@ -77,6 +77,11 @@ public:
 	bool knownToBeZero(YulName _a);
 	std::optional<u256> valueIfKnownConstant(YulName _a);
 	std::optional<u256> valueIfKnownConstant(Expression const& _expression);
+	/// @returns the representative of the group of variables with mutual constant differences
+	/// @a _a belongs to and the offset of @a _a relative to it. The representative of the
+	/// constant values is the empty name.
+	/// The representative is only stable if the values are SSA.
+	std::pair<YulName, u256> representativeAndOffset(YulName _a);
 
 private:
 	/**
@@ -0,0 +1,94 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/OptimiserAnalyses.h>
+
+#include <libyul/optimiser/Semantics.h>
+#include <libyul/ControlFlowSideEffectsCollector.h>
+#include <libyul/Exceptions.h>
+
+using namespace solidity;
+using namespace solidity::yul;
+
+CallGraph const& OptimiserAnalyses::callGraph(Block const& _ast)
+{
+	if (!cached(m_callGraph, _ast))
+		m_callGraph = CallGraphGenerator::callGraph(_ast);
+	return *m_callGraph;
+}
+
+std::map<FunctionHandle, SideEffects> const& OptimiserAnalyses::functionSideEffects(
+	Dialect const& _dialect,
+	Block const& _ast
+)
+{
+	if (!cached(m_functionSideEffects, _ast))
+		m_functionSideEffects = SideEffectsPropagator::sideEffects(_dialect, callGraph(_ast));
+	return *m_functionSideEffects;
+}
+
+std::map<YulName, ControlFlowSideEffects> const& OptimiserAnalyses::controlFlowSideEffects(
+	Dialect const& _dialect,
+	Block const& _ast
+)
+{
+	if (!cached(m_controlFlowSideEffects, _ast))
+		m_controlFlowSideEffects = ControlFlowSideEffectsCollector{_dialect, _ast}.functionSideEffectsNamed();
+	return *m_controlFlowSideEffects;
+}
+
+bool OptimiserAnalyses::containsMSize(Dialect const& _dialect, Block const& _ast)
+{
+	if (!cached(m_containsMSize, _ast))
+		m_containsMSize = MSizeFinder::containsMSize(_dialect, _ast);
+	return *m_containsMSize;
+}
+
+void OptimiserAnalyses::startCaching(Block const& _ast)
+{
+	yulAssert(!m_ast);
+	invalidate();
+	m_ast = &_ast;
+}
+
+void OptimiserAnalyses::stopCaching()
+{
+	m_ast = nullptr;
+	invalidate();
+}
+
+void OptimiserAnalyses::invalidate(PreservedAnalyses const& _preserved)
+{
+	if (!_preserved.callGraph)
+		m_callGraph.reset();
+	if (!_preserved.functionSideEffects)
+		m_functionSideEffects.reset();
+	if (!_preserved.controlFlowSideEffects)
+		m_controlFlowSideEffects.reset();
+	if (!_preserved.containsMSize)
+		m_containsMSize.reset();
+}
+
+template<typename Result>
+bool OptimiserAnalyses::cached(std::optional<Result> const& _result, Block const& _ast) const
+{
+	if (!m_ast)
+		return false;
+	yulAssert(m_ast == &_ast, "Analyses requested for a block other than the root of the cached AST.");
+	return _result.has_value();
+}
@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Whole-program analyses shared between optimiser steps.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/ASTForward.h>
+#include <libyul/ControlFlowSideEffects.h>
+#include <libyul/SideEffects.h>
+#include <libyul/YulName.h>
+
+#include <map>
+#include <optional>
+
+namespace solidity::yul
+{
+
+class Dialect;
+
+/**
+ * The analyses of an OptimiserAnalyses object whose results are not changed by an optimiser step.
+ * Steps declare them through a static member `preservedAnalyses`, otherwise nothing is preserved.
+ */
+struct PreservedAnalyses
+{
+	bool callGraph = false;
+	bool functionSideEffects = false;
+	bool controlFlowSideEffects = false;
+	bool containsMSize = false;
+
+	static constexpr PreservedAnalyses all() { return {true, true, true, true}; }
+};
+
+/**
+ * Results of whole-program analyses of the AST being optimised, computed on request.
+ *
+ * While caching is active for an AST, the results are kept between requests until they are
+ * invalidated, which the optimiser suite does after each step for all analyses the step
+ * does not preserve. Otherwise, the analyses are recomputed for every request, so that
+ * steps run outside of the suite always see up-to-date results. References to results
+ * stay valid in both cases, but may observe later recomputations.
+ *
+ * The results must only be requested for the root block of the AST.
+ */
+class OptimiserAnalyses
+{
+public:
+	CallGraph const& callGraph(Block const& _ast);
+	/// @returns the side effects of all functions, see SideEffectsPropagator.
+	std::map<FunctionHandle, SideEffects> const& functionSideEffects(Dialect const& _dialect, Block const& _ast);
+	/// @returns the control flow side effects of all functions by name, see ControlFlowSideEffectsCollector.
+	std::map<YulName, ControlFlowSideEffects> const& controlFlowSideEffects(Dialect const& _dialect, Block const& _ast);
+	/// @returns true if the AST contains a call to msize, see MSizeFinder.
+	bool containsMSize(Dialect const& _dialect, Block const& _ast);
+
+	/// Starts keeping the results for @a _ast between requests.
+	void startCaching(Block const& _ast);
+	/// Stops keeping results and discards all of them.
+	void stopCaching();
+	bool caching() const { return m_ast != nullptr; }
+	/// Discards the results of all analyses that are not preserved according to @a _preserved.
+	void invalidate(PreservedAnalyses const& _preserved = {});
+
+private:
+	/// @returns true if @a _result is present and still valid for @a _ast.
+	template<typename Result>
+	bool cached(std::optional<Result> const& _result, Block const& _ast) const;
+
+	/// Root block of the AST whose results are kept, nullptr if caching is not active.
+	Block const* m_ast = nullptr;
+	std::optional<CallGraph> m_callGraph;
+	std::optional<std::map<FunctionHandle, SideEffects>> m_functionSideEffects;
+	std::optional<std::map<YulName, ControlFlowSideEffects>> m_controlFlowSideEffects;
+	std::optional<bool> m_containsMSize;
+};
+
+}
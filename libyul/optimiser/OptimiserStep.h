@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <libyul/optimiser/OptimiserAnalyses.h>
 #include <libyul/Exceptions.h>
 
 #include <optional>
@@ -38,6 +39,8 @@ struct OptimiserStepContext
 	std::set<YulName> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// Analyses of the AST shared between the steps.
+	OptimiserAnalyses analyses = {};
 };
 
 
@@ -55,6 +58,8 @@ struct OptimiserStep
 	/// an SMT solver to be loaded, but none is available. In that case, the string
 	/// contains a human-readable reason.
 	virtual std::optional<std::string> invalidInCurrentEnvironment() const = 0;
+	/// @returns the analyses whose results are not changed by running the step.
+	virtual PreservedAnalyses preservedAnalyses() const = 0;
 	std::string name;
 };
 
@@ -73,6 +78,17 @@ private:
 		static constexpr bool value = decltype(test<T>(0))::value;
 	};
 
+	template<typename T>
+	struct HasPreservedAnalysesMember
+	{
+	private:
+		template<typename U> static auto test(int) -> decltype(U::preservedAnalyses, std::true_type());
+		template<typename> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<T>(0))::value;
+	};
+
 public:
 	OptimiserStepInstance(): OptimiserStep{Step::name} {}
 	void run(OptimiserStepContext& _context, Block& _ast) const override
@@ -86,6 +102,13 @@ public:
 		else
 			return std::nullopt;
 	}
+	PreservedAnalyses preservedAnalyses() const override
+	{
+		if constexpr (HasPreservedAnalysesMember<Step>::value)
+			return Step::preservedAnalyses;
+		else
+			return {};
+	}
 };
 
 
@@ -92,6 +92,7 @@ class SSATransform: public ASTModifier
 {
 public:
 	static constexpr char const* name{"SSATransform"};
+	static constexpr PreservedAnalyses preservedAnalyses = PreservedAnalyses::all();
 	static void run(OptimiserStepContext& _context, Block& _ast);
 };
 
@@ -59,19 +59,38 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	SimplificationRules& rules = *evmRules[version];
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
-	{
-		rules.resetMatchGroups();
-		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
-	}
-	return nullptr;
+	std::vector<Expression> const& arguments = *instruction->second;
+	return rules.m_rules.findFirst(
+		instruction->first,
+		[&](size_t _argument) -> std::optional<ExpressionSummary> {
+			Expression const* argument = &arguments.at(_argument);
+			// Patterns never match direct function calls as arguments, see Pattern::matches.
+			if (std::holds_alternative<FunctionCall>(*argument))
+				return std::nullopt;
+			// Resolve variables just like Pattern::matches does for constants and operations.
+			if (Identifier const* identifier = std::get_if<Identifier>(argument))
+				if (AssignedValue const* value = _ssaValues(identifier->name))
+					if (value->value)
+						argument = value->value;
+			if (Literal const* literal = std::get_if<Literal>(argument))
+			{
+				if (literal->kind == LiteralKind::Number)
+					return ExpressionSummary{ExpressionSummary::Kind::Constant, evmasm::Instruction::STOP, &literal->value.value()};
+			}
+			else if (auto argumentInstruction = instructionAndArguments(_dialect, *argument))
+				return ExpressionSummary{ExpressionSummary::Kind::Operation, argumentInstruction->first, nullptr};
+			return ExpressionSummary{};
+		},
+		[&](Rule const& _rule) {
+			rules.resetMatchGroups();
+			return _rule.pattern.matches(_expr, _dialect, _ssaValues) && (!_rule.feasible || _rule.feasible());
+		}
+	);
 }
 
 bool SimplificationRules::isInitialized() const
 {
-	return !m_rules[uint8_t(evmasm::Instruction::ADD)].empty();
+	return m_rules.hasRules(evmasm::Instruction::ADD);
 }
 
 std::optional<std::pair<evmasm::Instruction, std::vector<Expression> const*>>
@@ -94,7 +113,7 @@ void SimplificationRules::addRules(std::vector<Rule> const& _rules)
 
 void SimplificationRules::addRule(Rule const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	m_rules.addRule(_rule);
 }
 
 SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion)
@@ -228,6 +247,24 @@ bool Pattern::matches(
 	return true;
 }
 
+PatternSummary Pattern::summary() const
+{
+	switch (m_kind)
+	{
+	case PatternKind::Operation:
+		return PatternSummary{PatternSummary::Kind::Operation, m_instruction, std::nullopt};
+	case PatternKind::Constant:
+		return PatternSummary{
+			PatternSummary::Kind::Constant,
+			evmasm::Instruction::STOP,
+			m_data ? std::make_optional(*m_data) : std::nullopt
+		};
+	case PatternKind::Any:
+		return PatternSummary{};
+	}
+	util::unreachable();
+}
+
 evmasm::Instruction Pattern::instruction() const
 {
 	assertThrow(m_kind == PatternKind::Operation, OptimizerException, "");
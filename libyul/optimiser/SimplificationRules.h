@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libevmasm/SimplificationRule.h>
+#include <libevmasm/SimplificationRuleIndex.h>
 
 #include <libyul/ASTForward.h>
 #include <libyul/Builtins.h>
@@ -83,7 +84,7 @@ private:
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
 	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
+	evmasm::SimplificationRuleIndex<Pattern> m_rules;
 };
 
 enum class PatternKind
@@ -127,6 +128,8 @@ public:
 	) const;
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
+	/// @returns the requirements of this pattern used by SimplificationRuleIndex.
+	evmasm::PatternSummary summary() const;
 
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	u256 d() const;
@@ -27,6 +27,7 @@
 #include <libyul/optimiser/UnusedPruner.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/Semantics.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 
 #include <libyul/backends/evm/ControlFlowGraphBuilder.h>
 #include <libyul/backends/evm/StackHelpers.h>
@@ -182,6 +183,120 @@ void eliminateVariables(
 	UnusedPruner::runUntilStabilised(_dialect, _ast, _allowMSizeOptimization, nullptr, allFunctions);
 }
 
+/// @returns the name under which the top-level statement at @a _index of @a _astRoot is reported
+/// by the CompilabilityChecker, i.e. the empty name for the main block and the function name for
+/// function definitions, or std::nullopt for any other statement.
+std::optional<YulName> topLevelStatementName(Block const& _astRoot, size_t _index)
+{
+	Statement const& statement = _astRoot.statements.at(_index);
+	if (_index == 0 && std::holds_alternative<Block>(statement))
+		return YulName{};
+	if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+		return function->name;
+	return std::nullopt;
+}
+
+/// @returns the indices of the top-level statements of @a _astRoot named in @a _functionNames
+/// or std::nullopt if some name does not refer to a top-level statement (e.g. a nested function).
+std::optional<std::vector<size_t>> topLevelStatementIndices(Block const& _astRoot, std::set<YulName> const& _functionNames)
+{
+	std::vector<size_t> indices;
+	for (size_t index = 0; index < _astRoot.statements.size(); ++index)
+		if (std::optional<YulName> name = topLevelStatementName(_astRoot, index); name && _functionNames.count(*name))
+			indices.emplace_back(index);
+	if (indices.size() != _functionNames.size())
+		return std::nullopt;
+	return indices;
+}
+
+/// Determines the stack deficit per function of @a _astRoot using the CompilabilityChecker.
+/// If @a _changedFunctions is given, only these functions (and the main block, if it is named by the
+/// empty name) are checked. All other functions are replaced by stubs with the same signature and an
+/// empty body, which keeps the checked code valid, while making the check proportional to the size of
+/// the changed functions. Falls back to checking the whole program if some of the changed functions are
+/// not top-level.
+std::map<YulName, int> stackDeficit(
+	Object const& _object,
+	Block const& _astRoot,
+	std::optional<std::set<YulName>> const& _changedFunctions,
+	bool _optimizeStackAllocation
+)
+{
+	std::optional<std::vector<size_t>> changedIndices;
+	if (_changedFunctions)
+		changedIndices = topLevelStatementIndices(_astRoot, *_changedFunctions);
+
+	Block checkedRoot;
+	if (changedIndices)
+	{
+		checkedRoot.debugData = _astRoot.debugData;
+		for (size_t index = 0; index < _astRoot.statements.size(); ++index)
+		{
+			Statement const& statement = _astRoot.statements[index];
+			if (util::contains(*changedIndices, index))
+				checkedRoot.statements.emplace_back(ASTCopier{}.translate(statement));
+			else if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+				checkedRoot.statements.emplace_back(FunctionDefinition{
+					function->debugData,
+					function->name,
+					function->parameters,
+					function->returnVariables,
+					Block{function->body.debugData, {}}
+				});
+			else if (auto const* block = std::get_if<Block>(&statement))
+				checkedRoot.statements.emplace_back(Block{block->debugData, {}});
+			else
+				checkedRoot.statements.emplace_back(ASTCopier{}.translate(statement));
+		}
+	}
+	else
+		checkedRoot = std::get<Block>(ASTCopier{}(_astRoot));
+
+	Object object(_object);
+	object.setCode(std::make_shared<AST>(*_object.dialect(), std::move(checkedRoot)));
+	return CompilabilityChecker(object, _optimizeStackAllocation).stackDeficit;
+}
+
+/// Runs ``eliminateVariables`` only on the top-level statements of @a _ast that belong to the
+/// functions in @a _numVariables, by temporarily moving them into a separate block.
+/// Functions are never removed by ``eliminateVariables``, but the main block may be removed if it becomes empty.
+/// @returns false without modifying the AST if some of the functions are not top-level.
+bool eliminateVariablesInAffectedFunctions(
+	Dialect const& _dialect,
+	Block& _ast,
+	std::map<YulName, int> const& _numVariables,
+	bool _allowMSizeOptimization
+)
+{
+	std::optional<std::vector<size_t>> indices = topLevelStatementIndices(_ast, util::keys(_numVariables));
+	if (!indices)
+		return false;
+
+	bool const containsMainBlock = !indices->empty() && indices->front() == 0 && std::holds_alternative<Block>(_ast.statements.front());
+	Block affected{_ast.debugData, {}};
+	for (size_t index: *indices)
+		affected.statements.emplace_back(std::move(_ast.statements[index]));
+
+	eliminateVariables(_dialect, affected, _numVariables, _allowMSizeOptimization);
+
+	auto affectedStatement = affected.statements.begin();
+	for (size_t index: *indices)
+		if (
+			index == 0 &&
+			containsMainBlock &&
+			(affectedStatement == affected.statements.end() || !std::holds_alternative<Block>(*affectedStatement))
+		)
+			_ast.statements[index] = Block{_ast.debugData, {}};
+		else
+		{
+			yulAssert(affectedStatement != affected.statements.end());
+			_ast.statements[index] = std::move(*affectedStatement++);
+		}
+	yulAssert(affectedStatement == affected.statements.end());
+	removeEmptyBlocks(_ast);
+	return true;
+}
+
 void eliminateVariablesOptimizedCodegen(
 	Dialect const& _dialect,
 	Block& _ast,
@@ -239,7 +354,9 @@ void eliminateVariablesOptimizedCodegen(
 std::tuple<bool, Block> StackCompressor::run(
 	Object const& _object,
 	bool _optimizeStackAllocation,
-	size_t _maxIterations)
+	size_t _maxIterations,
+	std::optional<size_t> _expectedExecutionsPerDeployment
+)
 {
 	yulAssert(_object.hasCode());
 	yulAssert(_object.dialect(), "No dialect");
@@ -266,7 +383,12 @@ std::tuple<bool, Block> StackCompressor::run(
 			astRoot,
 			_object.summarizeStructure()
 		);
-		std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, *_object.dialect(), astRoot);
+		std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(
+			analysisInfo,
+			*_object.dialect(),
+			astRoot,
+			_expectedExecutionsPerDeployment
+		);
 		eliminateVariablesOptimizedCodegen(
 			*_object.dialect(),
 			astRoot,
@@ -276,19 +398,32 @@ std::tuple<bool, Block> StackCompressor::run(
 	}
 	else
 	{
+		// Functions modified since their stack deficit was last determined. Only these
+		// can still have a deficit: eliminating and pruning variables in one function does not
+		// affect any other function and never increases the stack pressure of the code it prunes.
+		// Not set in the first iteration, in which the whole program is checked and pruned.
+		std::optional<std::set<YulName>> changedFunctions;
 		for (size_t iterations = 0; iterations < _maxIterations; iterations++)
 		{
-			Object object(_object);
-			object.setCode(std::make_shared<AST>(*_object.dialect(), std::get<Block>(ASTCopier{}(astRoot))));
-			std::map<YulName, int> stackSurplus = CompilabilityChecker(object, _optimizeStackAllocation).stackDeficit;
-			if (stackSurplus.empty())
-				return std::make_tuple(true, std::move(astRoot));
-			eliminateVariables(
-				*object.dialect(),
+			std::map<YulName, int> stackSurplus = stackDeficit(
+				_object,
 				astRoot,
-				stackSurplus,
-				allowMSizeOptimization
+				changedFunctions,
+				_optimizeStackAllocation
 			);
+			if (stackSurplus.empty())
+				return std::make_tuple(true, std::move(astRoot));
+			if (
+				!changedFunctions ||
+				!eliminateVariablesInAffectedFunctions(*_object.dialect(), astRoot, stackSurplus, allowMSizeOptimization)
+			)
+				eliminateVariables(
+					*_object.dialect(),
+					astRoot,
+					stackSurplus,
+					allowMSizeOptimization
+				);
+			changedFunctions = util::keys(stackSurplus);
 		}
 	}
 	return std::make_tuple(false, std::move(astRoot));
@@ -25,6 +25,7 @@
 #include <libyul/Object.h>
 
 #include <memory>
+#include <optional>
 
 namespace solidity::yul
 {
@@ -46,10 +47,13 @@ class StackCompressor
 public:
 	/// Try to remove local variables until the AST is compilable.
 	/// @returns tuple with true if it was successful as first element, second element is the modified AST.
+	/// @param _expectedExecutionsPerDeployment has to match the value used for code generation,
+	/// nullopt for creation code.
 	static std::tuple<bool, Block> run(
 		Object const& _object,
 		bool _optimizeStackAllocation,
-		size_t _maxIterations
+		size_t _maxIterations,
+		std::optional<size_t> _expectedExecutionsPerDeployment = std::nullopt
 	);
 };
 
@@ -16,6 +16,7 @@
 */
 
 #include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/StackLimitEvader.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/FunctionCallFinder.h>
@@ -37,11 +38,92 @@
 #include <range/v3/view/concat.hpp>
 #include <range/v3/view/take.hpp>
 
+#include <algorithm>
+
 using namespace solidity;
 using namespace solidity::yul;
 
 namespace
 {
+/**
+ * Determines for every declared variable the blocks enclosing its declaration, starting from the body
+ * of the function containing it, resp. the outermost block. The pre block of a for loop is considered
+ * to enclose its condition, body and post block.
+ * Variables, neither of whose declaring block encloses the declaring block of the other, are never alive
+ * at the same time.
+ */
+struct DeclarationScopes: ASTWalker
+{
+	using ASTWalker::operator();
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (NameWithDebugData const& variable: _varDecl.variables)
+			scopes[variable.name] = currentScope;
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(FunctionDefinition const& _function) override
+	{
+		std::vector<Block const*> outerScope = std::move(currentScope);
+		currentScope.clear();
+		ASTWalker::operator()(_function);
+		currentScope = std::move(outerScope);
+	}
+	void operator()(ForLoop const& _loop) override
+	{
+		currentScope.emplace_back(&_loop.pre);
+		walkVector(_loop.pre.statements);
+		visit(*_loop.condition);
+		(*this)(_loop.body);
+		(*this)(_loop.post);
+		currentScope.pop_back();
+	}
+	void operator()(Block const& _block) override
+	{
+		currentScope.emplace_back(&_block);
+		ASTWalker::operator()(_block);
+		currentScope.pop_back();
+	}
+
+	std::map<YulName, std::vector<Block const*>> scopes;
+	std::vector<Block const*> currentScope;
+};
+
+/**
+ * Counts the accesses to every variable, weighting each access by an estimate of how often it is executed.
+ * The condition, body and post block of a for loop are assumed to be executed ``loopIterationEstimate``
+ * times as often as the loop itself.
+ */
+struct WeightedAccessCounter: ASTWalker
+{
+	static uint64_t constexpr loopIterationEstimate = 10;
+	static uint64_t constexpr maxWeight = uint64_t(1) << 40;
+
+	using ASTWalker::operator();
+	void operator()(Identifier const& _identifier) override
+	{
+		weights[_identifier.name] += currentWeight;
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		for (NameWithDebugData const& variable: _varDecl.variables)
+			weights[variable.name] += currentWeight;
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(ForLoop const& _loop) override
+	{
+		(*this)(_loop.pre);
+		uint64_t outerWeight = currentWeight;
+		currentWeight = std::min(currentWeight * loopIterationEstimate, maxWeight);
+		visit(*_loop.condition);
+		(*this)(_loop.body);
+		(*this)(_loop.post);
+		currentWeight = outerWeight;
+	}
+
+	std::map<YulName, uint64_t> weights;
+	uint64_t currentWeight = 1;
+};
+
 /**
  * Walks the call graph using a Depth-First-Search assigning memory slots to variables.
  * - The leaves of the call graph will get the lowest slot, increasing towards the root.
@@ -52,7 +134,9 @@ namespace
  * - Determine the maximum value ``n`` of the values of ``slotsRequiredForFunction`` among the children.
  * - If the function itself contains variables that need memory slots, but is contained in a cycle,
  *   abort the process as failure.
- * - If not, assign each variable its slot starting from ``n`` (incrementing it).
+ * - If not, assign each variable its slot starting from ``n`` (incrementing it). A variable reuses a slot
+ *   already assigned to other variables of the function instead, if none of them is declared in a block
+ *   enclosing its own declaration or vice versa, i.e. if their lifetimes do not overlap.
  * - Assign ``n`` to ``slotsRequiredForFunction`` of the function.
  */
 struct MemoryOffsetAllocator
@@ -88,16 +172,46 @@ struct MemoryOffsetAllocator
 
 			// Assign slots for all variables that become unreachable in the function body, if the above did not
 			// assign a slot for them already.
+			// The slots assigned to function arguments and return variables above are never shared.
+			uint64_t const firstSlot = requiredSlots;
+			std::vector<std::vector<YulName>> slotOccupants;
 			for (YulName variable: *unreachables)
 				// The empty case is a function with too many arguments or return values,
 				// which was already handled above.
 				if (!variable.empty() && !slotAllocations.count(variable))
-					slotAllocations[variable] = requiredSlots++;
+				{
+					auto sharedSlot = std::find_if(slotOccupants.begin(), slotOccupants.end(), [&](auto const& _occupants) {
+						return std::all_of(_occupants.begin(), _occupants.end(), [&](YulName _occupant) {
+							return disjointLifetimes(variable, _occupant);
+						});
+					});
+					if (sharedSlot == slotOccupants.end())
+					{
+						slotAllocations[variable] = requiredSlots++;
+						slotOccupants.emplace_back(std::vector<YulName>{variable});
+					}
+					else
+					{
+						slotAllocations[variable] = firstSlot + static_cast<uint64_t>(sharedSlot - slotOccupants.begin());
+						sharedSlot->emplace_back(variable);
+					}
+				}
 		}
 
 		return slotsRequiredForFunction[_function] = requiredSlots;
 	}
 
+	bool disjointLifetimes(YulName _variable1, YulName _variable2) const
+	{
+		auto const* scope1 = util::valueOrNullptr(declarationScopes, _variable1);
+		auto const* scope2 = util::valueOrNullptr(declarationScopes, _variable2);
+		if (!scope1 || !scope2)
+			return false;
+		size_t commonLength = std::min(scope1->size(), scope2->size());
+		// The lifetimes overlap, if the declaring block of one variable encloses the one of the other.
+		return !std::equal(scope1->begin(), scope1->begin() + static_cast<ptrdiff_t>(commonLength), scope2->begin());
+	}
+
 	/// Maps function names to the set of unreachable variables in that function.
 	/// An empty variable name means that the function has too many arguments or return variables.
 	std::map<YulName, std::vector<YulName>> const& unreachableVariables;
@@ -105,6 +219,8 @@ struct MemoryOffsetAllocator
 	std::map<FunctionHandle, std::vector<FunctionHandle>> const& callGraph;
 	/// Maps the name of each user-defined function to its definition.
 	std::map<YulName, FunctionDefinition const*> const& functionDefinitions;
+	/// Maps each declared variable to the blocks enclosing its declaration.
+	std::map<YulName, std::vector<Block const*>> const& declarationScopes;
 
 	/// Maps variable names to the memory slot the respective variable is assigned.
 	std::map<YulName, uint64_t> slotAllocations{};
@@ -140,7 +256,12 @@ Block StackLimitEvader::run(
 			astRoot,
 			_object.summarizeStructure()
 		);
-		std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(analysisInfo, *evmDialect, astRoot);
+		std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(
+			analysisInfo,
+			*evmDialect,
+			astRoot,
+			_context.expectedExecutionsPerDeployment
+		);
 		run(_context, astRoot, StackLayoutGenerator::reportStackTooDeep(*cfg, !evmDialect->eofVersion().has_value()));
 	}
 	else
@@ -159,15 +280,28 @@ void StackLimitEvader::run(
 	std::map<YulName, std::vector<StackLayoutGenerator::StackTooDeep>> const& _stackTooDeepErrors
 )
 {
+	WeightedAccessCounter accessCounter;
+	accessCounter(_astRoot);
+
 	std::map<YulName, std::vector<YulName>> unreachableVariables;
 	for (auto&& [function, stackTooDeepErrors]: _stackTooDeepErrors)
 	{
 		auto& unreachables = unreachableVariables[function];
-		// TODO: choose wisely.
 		for (auto const& stackTooDeepError: stackTooDeepErrors)
-			for (auto variable: stackTooDeepError.variableChoices | ranges::views::take(stackTooDeepError.deficit))
+		{
+			// Variables that are already moved to memory reduce the deficit for free. Among the others,
+			// prefer the ones that are accessed least often, taking loops into account.
+			auto spillCost = [&](YulName _variable) {
+				return std::make_pair(!util::contains(unreachables, _variable), util::valueOrDefault(accessCounter.weights, _variable));
+			};
+			std::vector<YulName> choices = stackTooDeepError.variableChoices;
+			std::stable_sort(choices.begin(), choices.end(), [&](YulName _lhs, YulName _rhs) {
+				return spillCost(_lhs) < spillCost(_rhs);
+			});
+			for (auto variable: choices | ranges::views::take(stackTooDeepError.deficit))
 				if (!util::contains(unreachables, variable))
 					unreachables.emplace_back(variable);
+		}
 	}
 	run(_context, _astRoot, unreachableVariables);
 }
@@ -209,7 +343,15 @@ void StackLimitEvader::run(
 
 	std::map<YulName, FunctionDefinition const*> functionDefinitions = allFunctionDefinitions(_astRoot);
 
-	MemoryOffsetAllocator memoryOffsetAllocator{_unreachableVariables, callGraph.functionCalls, functionDefinitions};
+	DeclarationScopes declarationScopes;
+	declarationScopes(_astRoot);
+
+	MemoryOffsetAllocator memoryOffsetAllocator{
+		_unreachableVariables,
+		callGraph.functionCalls,
+		functionDefinitions,
+		declarationScopes.scopes
+	};
 	uint64_t requiredSlots = memoryOffsetAllocator.run();
 	yulAssert(requiredSlots < (uint64_t(1) << 32) - 1, "");
 
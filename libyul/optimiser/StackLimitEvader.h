@@ -41,6 +41,11 @@ class Object;
  *
  * Offsets are assigned to the variables, s.t. on every path through the call graph each variable gets a unique offset
  * in memory. However, distinct paths through the call graph can use the same memory offsets for their variables.
+ * Variables of the same function that are declared in disjoint blocks share an offset as well.
+ *
+ * When starting from the stack too deep errors of the StackLayoutGenerator, the variables to be moved are chosen
+ * among the candidates of each error by the number of times they are accessed, counting accesses inside
+ * for loops more often, s.t. frequently accessed variables stay on the stack.
  *
  * The current arguments to the ``memoryguard`` calls are used as base memory offset and then replaced by the offset past
  * the last memory offset used for a variable on any path through the call graph.
@@ -0,0 +1,139 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that combines consecutive updates of the same storage slot.
+ */
+
+#include <libyul/optimiser/StorageUpdateCombiner.h>
+
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/AST.h>
+#include <libyul/Utilities.h>
+
+#include <libsolutil/Visitor.h>
+
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+void StorageUpdateCombiner::run(OptimiserStepContext& _context, Block& _ast)
+{
+	StorageUpdateCombiner combiner{
+		_context.dialect,
+		_context.analyses.functionSideEffects(_context.dialect, _ast)
+	};
+	combiner(_ast);
+
+	StatementRemover remover{combiner.m_pendingRemovals};
+	remover(_ast);
+}
+
+void StorageUpdateCombiner::operator()(Block& _block)
+{
+	// Stores are only combined within the same block.
+	m_unreadStores.clear();
+	DataFlowAnalyzer::operator()(_block);
+	m_unreadStores.clear();
+}
+
+void StorageUpdateCombiner::visit(Statement& _statement)
+{
+	// No need to consider reads in the arguments since
+	// isSimpleStore only returns something if the arguments are identifiers.
+	if (ExpressionStatement const* expression = std::get_if<ExpressionStatement>(&_statement))
+		if (auto vars = isSimpleStore(StoreLoadLocation::Storage, *expression))
+		{
+			for (auto it = m_unreadStores.begin(); it != m_unreadStores.end();)
+				if (knownToBeEqual(it->first, vars->first))
+				{
+					m_pendingRemovals.insert(it->second);
+					it = m_unreadStores.erase(it);
+				}
+				else
+					++it;
+			DataFlowAnalyzer::visit(_statement);
+			m_unreadStores[vars->first] = &_statement;
+			return;
+		}
+
+	// Loads of known values are replaced while visiting the statement,
+	// so only the remaining loads count as reads below.
+	DataFlowAnalyzer::visit(_statement);
+
+	std::visit(GenericVisitor{
+		[&](ExpressionStatement const& _expressionStatement) { markReads(_expressionStatement.expression); },
+		[&](VariableDeclaration const& _varDecl) {
+			if (_varDecl.value)
+				markReads(*_varDecl.value);
+		},
+		[&](Assignment const& _assignment) {
+			markReads(*_assignment.value);
+			// Keys that are re-assigned refer to a different slot from now on.
+			for (Identifier const& variable: _assignment.variableNames)
+				m_unreadStores.erase(variable.name);
+		},
+		[&](auto const&) {
+			// Control flow might read the stored values in a different block or leave the current one.
+			m_unreadStores.clear();
+		}
+	}, _statement);
+}
+
+void StorageUpdateCombiner::visit(Expression& _expression)
+{
+	DataFlowAnalyzer::visit(_expression);
+
+	if (std::optional<YulName> key = isSimpleLoad(StoreLoadLocation::Storage, _expression))
+		if (std::optional<YulName> value = storageValue(*key))
+			if (inScope(*value))
+				_expression = Identifier{debugDataOf(_expression), *value};
+}
+
+void StorageUpdateCombiner::markReads(Expression const& _expression)
+{
+	FunctionCall const* functionCall = std::get_if<FunctionCall>(&_expression);
+	if (!functionCall)
+		return;
+
+	for (Expression const& argument: functionCall->arguments)
+		markReads(argument);
+
+	if (std::optional<YulName> key = isSimpleLoad(StoreLoadLocation::Storage, _expression))
+	{
+		for (auto it = m_unreadStores.begin(); it != m_unreadStores.end();)
+			if (m_knowledgeBase.knownToBeDifferent(it->first, *key))
+				++it;
+			else
+				it = m_unreadStores.erase(it);
+		return;
+	}
+
+	if (BuiltinName const* builtinName = std::get_if<BuiltinName>(&functionCall->functionName))
+	{
+		BuiltinFunction const& builtin = m_dialect.builtin(builtinName->handle);
+		if (builtin.sideEffects.storage == SideEffects::None && !builtin.controlFlowSideEffects.canTerminate)
+			return;
+	}
+	// User-defined functions might read storage or end execution.
+	m_unreadStores.clear();
+}
+
+bool StorageUpdateCombiner::knownToBeEqual(YulName _key1, YulName _key2)
+{
+	return _key1 == _key2 || m_knowledgeBase.differenceIfKnownConstant(_key1, _key2) == u256(0);
+}
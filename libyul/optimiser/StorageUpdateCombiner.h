@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimisation stage that combines consecutive updates of the same storage slot.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <map>
+#include <set>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimisation stage that combines consecutive updates of the same storage slot
+ * into a single ``sload`` and ``sstore``.
+ *
+ * Updates of members of packed structs and state variables read the slot, mask the member
+ * and write the slot back. For consecutive updates of the same slot, ``sload(k)`` is replaced
+ * by the value last stored at ``k``, if it is known, and an ``sstore(k, v)`` is removed if it is
+ * followed by another ``sstore`` to the same slot in the same block without anything in between
+ * that could read storage or end execution without reverting. Slots are considered the same if
+ * they are known to be equal using the KnowledgeBase.
+ *
+ * This is a local combination of LoadResolver and UnusedStoreEliminator restricted to storage,
+ * that can be run cheaply right after steps like the FullInliner made such updates adjacent.
+ *
+ * Works best if the code is in SSA form - without literal arguments.
+ *
+ * Prerequisite: Disambiguator, ForLoopInitRewriter.
+ */
+class StorageUpdateCombiner: public DataFlowAnalyzer
+{
+public:
+	static constexpr char const* name{"StorageUpdateCombiner"};
+	static void run(OptimiserStepContext&, Block& _ast);
+
+private:
+	StorageUpdateCombiner(
+		Dialect const& _dialect,
+		std::map<FunctionHandle, SideEffects> _functionSideEffects
+	):
+		DataFlowAnalyzer(_dialect, MemoryAndStorage::Analyze, std::move(_functionSideEffects))
+	{}
+
+protected:
+	using ASTModifier::visit;
+	void operator()(Block& _block) override;
+	void visit(Statement& _statement) override;
+	void visit(Expression& _expression) override;
+
+private:
+	/// Forgets all stores that might be read by @a _expression or not be overwritten because it
+	/// might end the execution.
+	void markReads(Expression const& _expression);
+	bool knownToBeEqual(YulName _key1, YulName _key2);
+
+	/// Stores in the current block that were not read since, by their key.
+	std::map<YulName, Statement const*> m_unreadStores;
+	std::set<Statement const*> m_pendingRemovals;
+};
+
+}
@@ -53,6 +53,7 @@
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/StackCompressor.h>
 #include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/optimiser/StorageUpdateCombiner.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/UnusedAssignEliminator.h>
@@ -169,7 +170,8 @@ void OptimiserSuite::run(
 				astRoot = std::get<1>(StackCompressor::run(
 					_object,
 					_optimizeStackAllocation,
-					stackCompressorMaxIterations
+					stackCompressorMaxIterations,
+					_expectedExecutionsPerDeployment
 				));
 			}
 			if (evmDialect->providesObjectAccess())
@@ -204,6 +206,29 @@ void OptimiserSuite::run(
 namespace
 {
 
+/// Keeps the results of analyses of the AST between the steps run during its lifetime,
+/// unless they are already kept by an enclosing sequence.
+class ScopedAnalysisCaching
+{
+public:
+	ScopedAnalysisCaching(OptimiserAnalyses& _analyses, Block const& _ast):
+		m_analyses(_analyses),
+		m_outermost(!_analyses.caching())
+	{
+		if (m_outermost)
+			m_analyses.startCaching(_ast);
+	}
+	~ScopedAnalysisCaching()
+	{
+		if (m_outermost)
+			m_analyses.stopCaching();
+	}
+
+private:
+	OptimiserAnalyses& m_analyses;
+	bool m_outermost = false;
+};
+
 template <class... Step>
 std::map<std::string, std::unique_ptr<OptimiserStep>> optimiserStepCollection()
 {
@@ -253,6 +278,7 @@ std::map<std::string, std::unique_ptr<OptimiserStep>> const& OptimiserSuite::all
 			Rematerialiser,
 			SSAReverser,
 			SSATransform,
+			StorageUpdateCombiner,
 			StructuralSimplifier,
 			UnusedFunctionParameterPruner,
 			UnusedPruner,
@@ -294,6 +320,7 @@ std::map<std::string, char> const& OptimiserSuite::stepNameToAbbreviationMap()
 		{Rematerialiser::name,                'm'},
 		{SSAReverser::name,                   'V'},
 		{SSATransform::name,                  'a'},
+		{StorageUpdateCombiner::name,         'R'},
 		{StructuralSimplifier::name,          't'},
 		{UnusedFunctionParameterPruner::name, 'p'},
 		{UnusedPruner::name,                  'u'},
@@ -372,6 +399,7 @@ bool OptimiserSuite::isEmptyOptimizerSequence(std::string const& _sequence)
 void OptimiserSuite::runSequence(std::string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable)
 {
 	validateSequence(_stepAbbreviations);
+	ScopedAnalysisCaching analysisCaching(m_context.analyses, _ast);
 
 	// This splits 'aaa[bbb]ccc...' into 'aaa' and '[bbb]ccc...'.
 	auto extractNonNestedPrefix = [](std::string_view _tail) -> std::tuple<std::string_view, std::string_view>
@@ -467,6 +495,7 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 	std::unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = std::make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+	ScopedAnalysisCaching analysisCaching(m_context.analyses, _ast);
 	for (std::string const& step: _steps)
 	{
 		if (m_debug == Debug::PrintStep)
@@ -474,7 +503,9 @@ void OptimiserSuite::runSequence(std::vector<std::string> const& _steps, Block&
 
 		{
 			PROFILER_PROBE(step, probe);
-			allSteps().at(step)->run(m_context, _ast);
+			OptimiserStep const& optimiserStep = *allSteps().at(step);
+			optimiserStep.run(m_context, _ast);
+			m_context.analyses.invalidate(optimiserStep.preservedAnalyses());
 		}
 
 		if (m_debug == Debug::PrintChanges)
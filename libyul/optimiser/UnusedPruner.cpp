@@ -35,7 +35,14 @@ using namespace solidity::yul;
 
 void UnusedPruner::run(OptimiserStepContext& _context, Block& _ast)
 {
-	UnusedPruner::runUntilStabilisedOnFullAST(_context.dialect, _ast, _context.reservedIdentifiers);
+	bool allowMSizeOptimization = !_context.analyses.containsMSize(_context.dialect, _ast);
+	runUntilStabilised(
+		_context.dialect,
+		_ast,
+		allowMSizeOptimization,
+		&_context.analyses.functionSideEffects(_context.dialect, _ast),
+		_context.reservedIdentifiers
+	);
 	FunctionGrouper::run(_context, _ast);
 }
 
@@ -24,8 +24,14 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/AST.h>
 
+#include <libevmasm/SemanticInformation.h>
+
+#include <libsolutil/Numeric.h>
+
 #include <range/v3/action/remove_if.hpp>
 
+#include <optional>
+#include <tuple>
 #include <variant>
 
 
@@ -99,7 +105,26 @@ protected:
 	size_t m_forLoopNestingDepth = 0;
 };
 
-enum class UnusedStoreEliminatorKey { Memory, Storage };
+/**
+ * Key of the active stores of the UnusedStoreEliminator.
+ *
+ * Stores whose start is known relative to a variable (see KnowledgeBase) and whose length is a
+ * known non-zero constant are grouped by the representative of that variable, the "region",
+ * and their offset inside the region. All other stores of a location share the key without region.
+ */
+struct UnusedStoreEliminatorKey
+{
+	evmasm::SemanticInformation::Location location;
+	/// Representative of the start of the stores, the empty name for constant addresses.
+	std::optional<YulName> region;
+	/// Start of the stores relative to the representative.
+	u256 offset;
+
+	bool operator<(UnusedStoreEliminatorKey const& _other) const
+	{
+		return std::tie(location, region, offset) < std::tie(_other.location, _other.region, _other.offset);
+	}
+};
 extern template class UnusedStoreBase<YulString>;
 extern template class UnusedStoreBase<UnusedStoreEliminatorKey>;
 }
@@ -28,7 +28,6 @@
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/optimiser/DataFlowAnalyzer.h>
 #include <libyul/optimiser/KnowledgeBase.h>
-#include <libyul/ControlFlowSideEffectsCollector.h>
 #include <libyul/AST.h>
 #include <libyul/Utilities.h>
 
@@ -46,10 +45,8 @@ using namespace solidity::yul;
 
 void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	std::map<FunctionHandle, SideEffects> functionSideEffects = SideEffectsPropagator::sideEffects(
-		_context.dialect,
-		CallGraphGenerator::callGraph(_ast)
-	);
+	std::map<FunctionHandle, SideEffects> const& functionSideEffects =
+		_context.analyses.functionSideEffects(_context.dialect, _ast);
 
 	SSAValueTracker ssaValues;
 	ssaValues(_ast);
@@ -57,11 +54,11 @@ void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	for (auto const& [name, expression]: ssaValues.values())
 		values[name] = AssignedValue{expression, {}};
 
-	bool const ignoreMemory = MSizeFinder::containsMSize(_context.dialect, _ast);
+	bool const ignoreMemory = _context.analyses.containsMSize(_context.dialect, _ast);
 	UnusedStoreEliminator rse{
 		_context.dialect,
 		functionSideEffects,
-		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed(),
+		_context.analyses.controlFlowSideEffects(_context.dialect, _ast),
 		values,
 		ignoreMemory
 	};
@@ -73,6 +70,7 @@ void UnusedStoreEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	else
 		rse.markActiveAsUsed(Location::Memory);
 	rse.markActiveAsUsed(Location::Storage);
+	rse.markActiveAsUsed(Location::TransientStorage);
 	rse.m_storesToRemove += rse.m_allStores - rse.m_usedStores;
 
 	std::set<Statement const*> toRemove{rse.m_storesToRemove.begin(), rse.m_storesToRemove.end()};
@@ -112,12 +110,18 @@ void UnusedStoreEliminator::operator()(FunctionCall const& _functionCall)
 	}
 
 	if (sideEffects.canTerminate)
+	{
 		markActiveAsUsed(Location::Storage);
+		markActiveAsUsed(Location::TransientStorage);
+	}
 	if (!sideEffects.canContinue)
 	{
 		clearActive(Location::Memory);
 		if (!sideEffects.canTerminate)
+		{
 			clearActive(Location::Storage);
+			clearActive(Location::TransientStorage);
+		}
 	}
 }
 
@@ -159,6 +163,7 @@ void UnusedStoreEliminator::visit(Statement const& _statement)
 	// This way the assert below should be triggered on any change.
 	using evmasm::SemanticInformation;
 	bool isStorageWrite = (*instruction == Instruction::SSTORE);
+	bool isTransientStorageWrite = (*instruction == Instruction::TSTORE);
 	bool isMemoryWrite =
 		*instruction == Instruction::EXTCODECOPY ||
 		*instruction == Instruction::CODECOPY ||
@@ -172,9 +177,10 @@ void UnusedStoreEliminator::visit(Statement const& _statement)
 		*instruction != Instruction::MCOPY &&
 		SemanticInformation::otherState(*instruction) != SemanticInformation::Write && (
 			SemanticInformation::storage(*instruction) == SemanticInformation::Write ||
+			SemanticInformation::transientStorage(*instruction) == SemanticInformation::Write ||
 			(!m_ignoreMemory && SemanticInformation::memory(*instruction) == SemanticInformation::Write)
 		);
-	yulAssert(isCandidateForRemoval == (isStorageWrite || (!m_ignoreMemory && isMemoryWrite)));
+	yulAssert(isCandidateForRemoval == (isStorageWrite || isTransientStorageWrite || (!m_ignoreMemory && isMemoryWrite)));
 	if (isCandidateForRemoval)
 	{
 		if (*instruction == Instruction::RETURNDATACOPY)
@@ -203,13 +209,13 @@ void UnusedStoreEliminator::visit(Statement const& _statement)
 		m_allStores.insert(&_statement);
 		std::vector<Operation> operations = operationsFromFunctionCall(*funCall);
 		yulAssert(operations.size() == 1, "");
-		if (operations.front().location == Location::Storage)
-			activeStorageStores().insert(&_statement);
-		else
-		{
-			yulAssert(operations.front().location == Location::Memory, "");
-			activeMemoryStores().insert(&_statement);
-		}
+		Key key = storeKey(operations.front());
+		if (key.region && key.location == Location::Memory)
+			m_maxMemoryStoreLength = std::max(
+				m_maxMemoryStoreLength,
+				bigint(*lengthValue(*operations.front().length))
+			);
+		m_activeStores[std::move(key)].insert(&_statement);
 		m_storeOperations[&_statement] = std::move(operations.front());
 	}
 }
@@ -238,6 +244,8 @@ std::vector<UnusedStoreEliminator::Operation> UnusedStoreEliminator::operationsF
 			result.emplace_back(Operation{Location::Memory, Effect::Read, {}, {}});
 		if (sideEffects.storage != SideEffects::Effect::None)
 			result.emplace_back(Operation{Location::Storage, Effect::Read, {}, {}});
+		if (sideEffects.transientStorage != SideEffects::Effect::None)
+			result.emplace_back(Operation{Location::TransientStorage, Effect::Read, {}, {}});
 		return result;
 	}
 
@@ -268,30 +276,167 @@ std::vector<UnusedStoreEliminator::Operation> UnusedStoreEliminator::operationsF
 
 void UnusedStoreEliminator::applyOperation(UnusedStoreEliminator::Operation const& _operation)
 {
-	std::set<Statement const*>& active =
-		_operation.location == Location::Storage ?
-		activeStorageStores() :
-		activeMemoryStores();
-
+	std::optional<u256> length = _operation.length ? lengthValue(*_operation.length) : std::nullopt;
+	std::optional<std::pair<YulName, u256>> region = regionAndOffset(_operation);
+	bigint const addressSpace = bigint(1) << 256;
 
-	for (auto it = active.begin(); it != active.end();)
+	if (_operation.effect == Effect::Read)
 	{
-		Statement const* statement = *it;
-		Operation const& storeOperation = m_storeOperations.at(statement);
-		if (_operation.effect == Effect::Read && !knownUnrelated(storeOperation, _operation))
+		if (_operation.location == Location::Memory && length == u256(0))
+			return;
+
+		auto markUsed = [&](Statement const* _store) {
+			m_usedStores.insert(_store);
+			return true;
+		};
+		// Nothing is known about the relation to stores in other regions, so they are all used.
+		// Stores without a region are checked individually.
+		for (
+			auto it = m_activeStores.lower_bound(Key{_operation.location, std::nullopt, 0});
+			it != m_activeStores.end() && it->first.location == _operation.location;
+		)
+			if (!it->first.region)
+				it = removeActiveIf(it, [&](Statement const* _store) {
+					return !knownUnrelated(m_storeOperations.at(_store), _operation) && markUsed(_store);
+				});
+			else if (region && it->first.region == region->first)
+				it = m_activeStores.upper_bound(Key{_operation.location, region->first, ~u256(0)});
+			else
+				it = removeActiveIf(it, markUsed);
+
+		if (!region)
+			return;
+		YulName const& regionName = region->first;
+		u256 const& offset = region->second;
+		// Only stores starting less than the maximum store length before the read can overlap it.
+		u256 const lookBehind = _operation.location == Location::Memory ? u256(m_maxMemoryStoreLength - 1) : u256(0);
+		if (length)
+			removeActiveInRange(
+				_operation.location,
+				regionName,
+				offset - lookBehind,
+				bigint(lookBehind) + *length,
+				[&](u256 const& _storeOffset, Statement const* _store) {
+					// Two ranges on the cyclic address space overlap if and only if
+					// one of them starts inside the other.
+					u256 storeLength = *lengthValue(*m_storeOperations.at(_store).length);
+					bool overlaps =
+						u256(offset - _storeOffset) < storeLength ||
+						u256(_storeOffset - offset) < *length;
+					return overlaps && markUsed(_store);
+				}
+			);
+		else if (regionName.empty())
 		{
-			// This store is read from, mark it as used and remove it from the active set.
-			m_usedStores.insert(statement);
-			it = active.erase(it);
+			// Reads of unknown length at constant addresses do not affect stores that end before them.
+			u256 const begin = offset > lookBehind ? u256(offset - lookBehind) : u256(0);
+			removeActiveInRange(
+				_operation.location,
+				regionName,
+				begin,
+				addressSpace - begin,
+				[&](u256 const& _storeOffset, Statement const* _store) {
+					u256 storeLength = *lengthValue(*m_storeOperations.at(_store).length);
+					return bigint(_storeOffset) + storeLength > offset && markUsed(_store);
+				}
+			);
 		}
-		else if (_operation.effect == Effect::Write && knownCovered(storeOperation, _operation))
-			// This store is overwritten before being read, remove it from the active set.
-			it = active.erase(it);
 		else
-			++it;
+			removeActiveInRange(_operation.location, regionName, 0, addressSpace, [&](u256 const&, Statement const* _store) {
+				return markUsed(_store);
+			});
+	}
+	else
+	{
+		// Stores overwritten before being read are removed from the active set.
+		auto it = m_activeStores.find(Key{_operation.location, std::nullopt, 0});
+		if (it != m_activeStores.end())
+			removeActiveIf(it, [&](Statement const* _store) {
+				return knownCovered(m_storeOperations.at(_store), _operation);
+			});
+
+		if (!region || !length)
+			return;
+		u256 const& offset = region->second;
+		removeActiveInRange(
+			_operation.location,
+			region->first,
+			offset,
+			*length,
+			[&](u256 const& _storeOffset, Statement const* _store) {
+				u256 storeLength = *lengthValue(*m_storeOperations.at(_store).length);
+				return bigint(u256(_storeOffset - offset)) + storeLength <= *length;
+			}
+		);
+	}
+}
+
+std::optional<std::pair<YulName, u256>> UnusedStoreEliminator::regionAndOffset(
+	UnusedStoreEliminator::Operation const& _operation
+) const
+{
+	if (!_operation.start)
+		return std::nullopt;
+	return m_knowledgeBase.representativeAndOffset(*_operation.start);
+}
+
+UnusedStoreEliminatorKey UnusedStoreEliminator::storeKey(UnusedStoreEliminator::Operation const& _operation) const
+{
+	std::optional<u256> length = _operation.length ? lengthValue(*_operation.length) : std::nullopt;
+	if (length && *length != 0)
+		if (auto region = regionAndOffset(_operation))
+			return Key{_operation.location, region->first, region->second};
+	return Key{_operation.location, std::nullopt, 0};
+}
+
+void UnusedStoreEliminator::removeActiveInRange(
+	Location _location,
+	YulName _region,
+	u256 const& _begin,
+	bigint const& _size,
+	std::function<bool(u256 const&, Statement const*)> const& _predicate
+)
+{
+	bigint const addressSpace = bigint(1) << 256;
+	auto removeFrom = [&](u256 const& _from, std::optional<u256> const& _to) {
+		for (
+			auto it = m_activeStores.lower_bound(Key{_location, _region, _from});
+			it != m_activeStores.end() &&
+			it->first.location == _location &&
+			it->first.region == _region &&
+			(!_to || it->first.offset < *_to);
+		)
+		{
+			u256 const& offset = it->first.offset;
+			it = removeActiveIf(it, [&](Statement const* _store) { return _predicate(offset, _store); });
+		}
+	};
+
+	if (_size <= 0)
+		return;
+	if (_size >= addressSpace)
+		removeFrom(0, std::nullopt);
+	else if (bigint end = bigint(_begin) + _size; end < addressSpace)
+		removeFrom(_begin, u256(end));
+	else
+	{
+		removeFrom(_begin, std::nullopt);
+		if (end > addressSpace)
+			removeFrom(0, u256(end - addressSpace));
 	}
 }
 
+UnusedStoreEliminator::ActiveStores::iterator UnusedStoreEliminator::removeActiveIf(
+	ActiveStores::iterator _it,
+	std::function<bool(Statement const*)> const& _predicate
+)
+{
+	std::erase_if(_it->second, _predicate);
+	if (_it->second.empty())
+		return m_activeStores.erase(_it);
+	return std::next(_it);
+}
+
 bool UnusedStoreEliminator::knownUnrelated(
 	UnusedStoreEliminator::Operation const& _op1,
 	UnusedStoreEliminator::Operation const& _op2
@@ -299,7 +444,7 @@ bool UnusedStoreEliminator::knownUnrelated(
 {
 	if (_op1.location != _op2.location)
 		return true;
-	if (_op1.location == Location::Storage)
+	if (_op1.location != Location::Memory)
 	{
 		if (_op1.start && _op2.start)
 		{
@@ -314,7 +459,6 @@ bool UnusedStoreEliminator::knownUnrelated(
 	}
 	else
 	{
-		yulAssert(_op1.location == Location::Memory, "");
 		if (
 			(_op1.length && lengthValue(*_op1.length) == 0) ||
 			(_op2.length && lengthValue(*_op2.length) == 0)
@@ -410,12 +554,9 @@ void UnusedStoreEliminator::markActiveAsUsed(
 	std::optional<UnusedStoreEliminator::Location> _onlyLocation
 )
 {
-	if (_onlyLocation == std::nullopt || _onlyLocation == Location::Memory)
-		for (Statement const* statement: activeMemoryStores())
-			m_usedStores.insert(statement);
-	if (_onlyLocation == std::nullopt || _onlyLocation == Location::Storage)
-		for (Statement const* statement: activeStorageStores())
-			m_usedStores.insert(statement);
+	for (auto const& [key, stores]: m_activeStores)
+		if (_onlyLocation == std::nullopt || key.location == *_onlyLocation)
+			m_usedStores += stores;
 	clearActive(_onlyLocation);
 }
 
@@ -423,10 +564,12 @@ void UnusedStoreEliminator::clearActive(
 	std::optional<UnusedStoreEliminator::Location> _onlyLocation
 )
 {
-	if (_onlyLocation == std::nullopt || _onlyLocation == Location::Memory)
-		activeMemoryStores() = {};
-	if (_onlyLocation == std::nullopt || _onlyLocation == Location::Storage)
-		activeStorageStores() = {};
+	if (_onlyLocation == std::nullopt)
+		m_activeStores = {};
+	else
+		std::erase_if(m_activeStores, [&](auto const& _activeStores) {
+			return _activeStores.first.location == *_onlyLocation;
+		});
 }
 
 std::optional<YulName> UnusedStoreEliminator::identifierNameIfSSA(Expression const& _expression) const
@@ -31,6 +31,7 @@
 
 #include <libevmasm/SemanticInformation.h>
 
+#include <functional>
 #include <map>
 #include <vector>
 
@@ -45,11 +46,18 @@ struct AssignedValue;
  * or infinite recursion) or lead to another ``sstore`` for which the optimizer can tell that it will overwrite the first store,
  * the statement will be removed.
  *
+ * The same applies to ``tstore``.
+ *
  * For memory store operations, things are generally simpler, at least in the outermost yul block as all such statements
  * will be removed if they are never read from in any code path. At function analysis level however, the approach is similar
  * to sstore, as we don't know whether the memory location will be read once we leave the function's scope,
  * so the statement will be removed only if all code code paths lead to a memory overwrite.
  *
+ * Stores whose start is known to be at a constant offset from some variable are kept ordered by that variable
+ * (the region) and the offset. Accesses only need to inspect the stores of their own region that can overlap
+ * them, while the stores of all other regions are either unaffected (writes) or marked as used at once (reads).
+ * This keeps the analysis close to linear also for long sequences of stores, like in ABI encoding.
+ *
  * Best run in SSA form.
  *
  * Prerequisite: Disambiguator, ForLoopInitRewriter.
@@ -91,8 +99,8 @@ public:
 	};
 
 private:
-	std::set<Statement const*>& activeMemoryStores() { return m_activeStores[UnusedStoreEliminatorKey::Memory]; }
-	std::set<Statement const*>& activeStorageStores() { return m_activeStores[UnusedStoreEliminatorKey::Storage]; }
+	using Key = UnusedStoreEliminatorKey;
+
 	std::optional<u256> lengthValue(OperationLength const& _length) const
 	{
 		if (YulName const* length = std::get_if<YulName>(&_length))
@@ -113,6 +121,25 @@ private:
 
 	std::vector<Operation> operationsFromFunctionCall(FunctionCall const& _functionCall) const;
 	void applyOperation(Operation const& _operation);
+	/// @returns the region and the offset inside the region of the start of @a _operation, if known.
+	std::optional<std::pair<YulName, u256>> regionAndOffset(Operation const& _operation) const;
+	/// @returns the key the store performing @a _operation is tracked under.
+	Key storeKey(Operation const& _operation) const;
+	/// Removes the stores of the active stores of @a _region whose offset is in the cyclic range
+	/// of size @a _size starting at @a _begin and for which @a _predicate returns true.
+	void removeActiveInRange(
+		Location _location,
+		YulName _region,
+		u256 const& _begin,
+		bigint const& _size,
+		std::function<bool(u256 const& _offset, Statement const* _store)> const& _predicate
+	);
+	/// Removes the stores of the active set @a _it points to for which @a _predicate returns true.
+	/// @returns an iterator to the next active set.
+	ActiveStores::iterator removeActiveIf(
+		ActiveStores::iterator _it,
+		std::function<bool(Statement const*)> const& _predicate
+	);
 	bool knownUnrelated(Operation const& _op1, Operation const& _op2) const;
 	bool knownCovered(Operation const& _covered, Operation const& _covering) const;
 
@@ -127,6 +154,8 @@ private:
 	std::map<YulName, AssignedValue> const& m_ssaValues;
 
 	std::map<Statement const*, Operation> m_storeOperations;
+	/// Upper bound on the length of memory stores that are tracked by region.
+	bigint m_maxMemoryStoreLength = 1;
 
 	KnowledgeBase mutable m_knowledgeBase;
 };
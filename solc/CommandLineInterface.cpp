@@ -30,6 +30,7 @@
 
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/ast/ASTJsonExporter.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/interface/CompilerStack.h>
@@ -38,6 +39,7 @@
 #include <libsolidity/interface/DebugSettings.h>
 #include <libsolidity/interface/ImportRemapper.h>
 #include <libsolidity/interface/StorageLayout.h>
+#include <libsolidity/interface/CompileServer.h>
 #include <libsolidity/lsp/LanguageServer.h>
 #include <libsolidity/lsp/Transport.h>
 
@@ -367,6 +369,27 @@ void CommandLineInterface::handleIROptimizedAst(std::string const& _contractName
 	}
 }
 
+void CommandLineInterface::handleIROptimizedBinary(std::string const& _contractName)
+{
+	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.compiler.outputs.irOptimizedBinary)
+		return;
+
+	bytes const yulIROptimizedBinary = m_compiler->yulIROptimizedBinary(_contractName).value_or(bytes{});
+	if (!m_options.output.dir.empty())
+		createFile(
+			m_compiler->filesystemFriendlyName(_contractName) + "_opt.yulb",
+			util::asString(yulIROptimizedBinary),
+			true /* _binary */
+		);
+	else
+	{
+		sout() << "Optimized IR binary:" << std::endl;
+		sout() << util::toHex(yulIROptimizedBinary) << std::endl;
+	}
+}
+
 void CommandLineInterface::handleBytecode(std::string const& _contract)
 {
 	solAssert(
@@ -692,6 +715,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		m_options.input.mode != InputMode::Server &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -728,7 +752,7 @@ std::map<std::string, Json> CommandLineInterface::parseAstFromInput()
 	return sourceJsons;
 }
 
-void CommandLineInterface::createFile(std::string const& _fileName, std::string const& _data)
+void CommandLineInterface::createFile(std::string const& _fileName, std::string const& _data, bool _binary)
 {
 	namespace fs = boost::filesystem;
 
@@ -743,7 +767,7 @@ void CommandLineInterface::createFile(std::string const& _fileName, std::string
 	if (fs::exists(pathName) && !m_options.output.overwriteFiles)
 		solThrow(CommandLineOutputError, "Refusing to overwrite existing file \"" + pathName + "\" (use --overwrite to force).");
 
-	std::ofstream outFile(pathName);
+	std::ofstream outFile(pathName, _binary ? std::ios::out | std::ios::binary : std::ios::out);
 	outFile << _data;
 	if (!outFile)
 		solThrow(CommandLineOutputError, "Could not write to file \"" + pathName + "\".");
@@ -846,6 +870,9 @@ void CommandLineInterface::processInput()
 	case InputMode::LanguageServer:
 		serveLSP();
 		break;
+	case InputMode::Server:
+		serveCompilation();
+		break;
 	case InputMode::Assembler:
 		assembleYul(m_options.assembly.inputLanguage, m_options.assembly.targetMachine);
 		break;
@@ -945,6 +972,7 @@ void CommandLineInterface::compile()
 		pipelineConfig.irOptimization =
 			m_options.compiler.outputs.irOptimized ||
 			m_options.compiler.outputs.irOptimizedAstJson ||
+			m_options.compiler.outputs.irOptimizedBinary ||
 			m_options.compiler.outputs.yulCFGJson;
 		pipelineConfig.irCodegen =
 			pipelineConfig.irOptimization ||
@@ -1113,6 +1141,8 @@ void CommandLineInterface::handleCombinedJSON()
 	if (m_options.compiler.combinedJsonRequests->ast)
 	{
 		solAssert(m_compiler);
+		// The exporter creates types (e.g. for function selectors), which have to belong to the compilation.
+		TypeProvider::ScopedInstance typeProviderScope{m_compiler->typeProvider()};
 		output[g_strSources] = Json::object();
 		for (auto const& sourceCode: m_fileReader.sourceUnits())
 		{
@@ -1139,6 +1169,8 @@ void CommandLineInterface::handleAst()
 	if (!m_options.compiler.outputs.astCompactJson)
 		return;
 
+	// The exporter creates types (e.g. for function selectors), which have to belong to the compilation.
+	TypeProvider::ScopedInstance typeProviderScope{m_compiler->typeProvider()};
 	std::vector<ASTNode const*> asts;
 	for (auto const& sourceCode: m_fileReader.sourceUnits())
 		asts.push_back(&m_compiler->ast(sourceCode.first));
@@ -1173,6 +1205,19 @@ void CommandLineInterface::serveLSP()
 		solThrow(CommandLineExecutionError, "LSP terminated abnormally.");
 }
 
+void CommandLineInterface::serveCompilation()
+{
+	lsp::StdioTransport transport;
+	CompileServer server{
+		transport,
+		m_universalCallback.callback(),
+		[&]() { m_fileReader.setSourceUnits({}); },
+		m_options.server.memoryBudget
+	};
+	if (!server.run())
+		solThrow(CommandLineExecutionError, "Compiler server terminated abnormally.");
+}
+
 void CommandLineInterface::link()
 {
 	solAssert(m_options.input.mode == InputMode::Linker);
@@ -1292,7 +1337,10 @@ void CommandLineInterface::assembleYul(yul::YulStack::Language _language, yul::Y
 				DebugInfoSelection::Default()
 		);
 
-		successful = successful && stack.parseAndAnalyze(sourceUnitName, yulSource);
+		if (m_options.assembly.binaryInput)
+			successful = successful && stack.importBinaryAndAnalyze(sourceUnitName, yulSource);
+		else
+			successful = successful && stack.parseAndAnalyze(sourceUnitName, yulSource);
 		if (!successful)
 			solAssert(stack.hasErrors(), "No error reported, but parsing/analysis failed.");
 		else
@@ -1365,6 +1413,12 @@ void CommandLineInterface::assembleYul(yul::YulStack::Language _language, yul::Y
 			sout() << stack.print() << std::endl;
 		}
 
+		if (m_options.compiler.outputs.irOptimizedBinary)
+		{
+			sout() << std::endl << "Yul object binary:" << std::endl;
+			sout() << util::toHex(stack.binary()) << std::endl;
+		}
+
 		if (m_options.compiler.outputs.binary)
 		{
 			sout() << std::endl << "Binary representation:" << std::endl;
@@ -1448,6 +1502,7 @@ void CommandLineInterface::outputCompilationResults()
 			handleIRAst(contract);
 			handleIROptimized(contract);
 			handleIROptimizedAst(contract);
+			handleIROptimizedBinary(contract);
 			handleYulCFGExport(contract);
 			handleSignatureHashes(contract);
 			handleMetadata(contract);
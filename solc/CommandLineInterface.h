@@ -88,6 +88,7 @@ private:
 	void compile();
 	void assembleFromEVMAssemblyJSON();
 	void serveLSP();
+	void serveCompilation();
 	void link();
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
@@ -109,6 +110,7 @@ private:
 	void handleIRAst(std::string const& _contract);
 	void handleIROptimized(std::string const& _contract);
 	void handleIROptimizedAst(std::string const& _contract);
+	void handleIROptimizedBinary(std::string const& _contract);
 	void handleYulCFGExport(std::string const& _contract);
 	void handleBytecode(std::string const& _contract);
 	void handleSignatureHashes(std::string const& _contract);
@@ -129,7 +131,7 @@ private:
 	/// Create a file in the given directory
 	/// @arg _fileName the name of the file
 	/// @arg _data to be written
-	void createFile(std::string const& _fileName, std::string const& _data);
+	void createFile(std::string const& _fileName, std::string const& _data, bool _binary = false);
 
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
@@ -57,6 +57,7 @@ static std::string const g_strImportEvmAssemblerJson = "import-asm-json";
 static std::string const g_strInputFile = "input-file";
 static std::string const g_strYul = "yul";
 static std::string const g_strYulDialect = "yul-dialect";
+static std::string const g_strImportYulBinary = "import-yul-binary";
 static std::string const g_strDebugInfo = "debug-info";
 static std::string const g_strIPFS = "ipfs";
 static std::string const g_strLicense = "license";
@@ -101,6 +102,8 @@ static std::set<std::string> const g_revertStringsArgs
 	revertStringsToString(RevertStrings::VerboseDebug)
 };
 
+static std::string const g_strServer = "server";
+static std::string const g_strServerMemoryBudget = "server-memory-budget";
 static std::string const g_strStandardJSON = "standard-json";
 static std::string const g_strStrictAssembly = "strict-assembly";
 static std::string const g_strSwarm = "swarm";
@@ -143,6 +146,7 @@ static std::map<InputMode, std::string> const g_inputModeName = {
 	{InputMode::Linker, "linker"},
 	{InputMode::LanguageServer, "language server (LSP)"},
 	{InputMode::EVMAssemblerJSON, "EVM assembler (JSON format)"},
+	{InputMode::Server, "compiler server"},
 };
 
 void CommandLineParser::checkMutuallyExclusive(std::vector<std::string> const& _optionNames)
@@ -254,7 +258,8 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		optimizer.expectedExecutionsPerDeployment == _other.optimizer.expectedExecutionsPerDeployment &&
 		optimizer.yulSteps == _other.optimizer.yulSteps &&
 		modelChecker.initialize == _other.modelChecker.initialize &&
-		modelChecker.settings == _other.modelChecker.settings;
+		modelChecker.settings == _other.modelChecker.settings &&
+		server.memoryBudget == _other.server.memoryBudget;
 }
 
 OptimiserSettings CommandLineOptions::optimiserSettings() const
@@ -339,7 +344,16 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				m_options.input.paths.insert(positionalArg);
 		}
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::Server)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"Input files are not accepted in --" + g_strServer + " mode.\n"
+				"Sources have to be provided as a part of the Standard JSON input of each request."
+			);
+	}
+	else if (m_options.input.mode == InputMode::StandardJson)
 	{
 		if (m_options.input.paths.size() > 1 || (m_options.input.paths.size() == 1 && m_options.input.addStdin))
 			solThrow(
@@ -471,6 +485,7 @@ void CommandLineParser::parseOutputSelection()
 			CompilerOutputs::componentName(&CompilerOutputs::asm_),
 			CompilerOutputs::componentName(&CompilerOutputs::binary),
 			CompilerOutputs::componentName(&CompilerOutputs::irOptimized),
+			CompilerOutputs::componentName(&CompilerOutputs::irOptimizedBinary),
 			CompilerOutputs::componentName(&CompilerOutputs::astCompactJson),
 			CompilerOutputs::componentName(&CompilerOutputs::asmJson),
 			CompilerOutputs::componentName(&CompilerOutputs::yulCFGJson),
@@ -499,6 +514,7 @@ void CommandLineParser::parseOutputSelection()
 			return util::contains(assemblerModeOutputs, _outputName);
 		case InputMode::StandardJson:
 		case InputMode::Linker:
+		case InputMode::Server:
 			return false;
 		}
 
@@ -700,9 +716,25 @@ General Information)").c_str(),
 			"Switch to language server mode (\"LSP\"). Allows the compiler to be used as an analysis backend "
 			"for your favourite IDE."
 		)
+		(
+			g_strServer.c_str(),
+			"Switch to compiler server mode. The compiler keeps running and answers Standard JSON "
+			"requests received as JSON-RPC messages on standard input, reusing caches between requests."
+		)
 	;
 	desc.add(alternativeInputModes);
 
+	po::options_description serverModeOptions("Server Mode Options");
+	serverModeOptions.add_options()
+		(
+			g_strServerMemoryBudget.c_str(),
+			po::value<size_t>()->value_name("MiB")->default_value(CommandLineOptions{}.server.memoryBudget / (1024 * 1024)),
+			"Approximate amount of memory the caches kept between requests may occupy. "
+			"Caches are dropped whenever they grow beyond that limit."
+		)
+	;
+	desc.add(serverModeOptions);
+
 	po::options_description assemblyModeOptions("Assembly Mode Options");
 	assemblyModeOptions.add_options()
 		(
@@ -715,6 +747,12 @@ General Information)").c_str(),
 			po::value<std::string>()->value_name(util::joinHumanReadable(g_yulDialectArgs, ",")),
 			"Input dialect to use in assembly or yul mode."
 		)
+		(
+			g_strImportYulBinary.c_str(),
+			("Read the input files as Yul objects in the compact binary format produced by --" +
+			CompilerOutputs::componentName(&CompilerOutputs::irOptimizedBinary) + " "
+			"instead of parsing them. Only valid together with --" + g_strStrictAssembly + ".").c_str()
+		)
 	;
 	desc.add(assemblyModeOptions);
 
@@ -769,6 +807,7 @@ General Information)").c_str(),
 		(CompilerOutputs::componentName(&CompilerOutputs::irAstJson).c_str(), "AST of Intermediate Representation (IR) of all contracts in a compact JSON format.")
 		(CompilerOutputs::componentName(&CompilerOutputs::irOptimized).c_str(), "Optimized Intermediate Representation (IR) of all contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::irOptimizedAstJson).c_str(), "AST of optimized Intermediate Representation (IR) of all contracts in a compact JSON format.")
+		(CompilerOutputs::componentName(&CompilerOutputs::irOptimizedBinary).c_str(), "Optimized Intermediate Representation (IR) of all contracts in a compact binary format.")
 		(CompilerOutputs::componentName(&CompilerOutputs::signatureHashes).c_str(), "Function signature hashes of the contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::natspecUser).c_str(), "Natspec user documentation of all contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::natspecDev).c_str(), "Natspec developer documentation of all contracts.")
@@ -990,6 +1029,7 @@ void CommandLineParser::processArgs()
 		g_strImportAst,
 		g_strLSP,
 		g_strImportEvmAssemblerJson,
+		g_strServer,
 	});
 
 	if (m_args.count(g_strHelp) > 0)
@@ -1002,6 +1042,8 @@ void CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::StandardJson;
 	else if (m_args.count(g_strLSP))
 		m_options.input.mode = InputMode::LanguageServer;
+	else if (m_args.count(g_strServer) > 0)
+		m_options.input.mode = InputMode::Server;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0)
 		m_options.input.mode = InputMode::Assembler;
 	else if (m_args.count(g_strLink) > 0)
@@ -1046,7 +1088,8 @@ void CommandLineParser::processArgs()
 		{g_strModelCheckerTimeout, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerBMCLoopIterations, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strModelCheckerContracts, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
-		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}}
+		{g_strModelCheckerTargets, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strServerMemoryBudget, {InputMode::Server}}
 	};
 	std::vector<std::string> invalidOptionsForCurrentInputMode;
 	for (auto const& [optionName, inputModes]: validOptionInputModeCombinations)
@@ -1224,7 +1267,10 @@ void CommandLineParser::processArgs()
 
 	parseInputPathsAndRemappings();
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::Server)
+		m_options.server.memoryBudget = m_args[g_strServerMemoryBudget].as<size_t>() * 1024 * 1024;
+
+	if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::Server)
 		return;
 
 	if (m_args.count(g_strLibraries))
@@ -1315,6 +1361,7 @@ void CommandLineParser::processArgs()
 		using Input = yul::YulStack::Language;
 		using Machine = yul::YulStack::Machine;
 		m_options.assembly.inputLanguage = m_args.count(g_strStrictAssembly) ? Input::StrictAssembly : Input::Assembly;
+		m_options.assembly.binaryInput = m_args.count(g_strImportYulBinary) > 0;
 
 		if (m_args.count(g_strMachine))
 		{
@@ -1340,6 +1387,11 @@ void CommandLineParser::processArgs()
 				CommandLineValidationError,
 				"Optimizer can only be used for strict assembly. Use --"  + g_strStrictAssembly + "."
 			);
+		if (m_options.assembly.binaryInput && m_options.assembly.inputLanguage != Input::StrictAssembly)
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strImportYulBinary + " can only be used for strict assembly. Use --" + g_strStrictAssembly + "."
+			);
 
 		if (m_options.compiler.outputs.ethdebug || m_options.compiler.outputs.ethdebugRuntime)
 			if (!m_options.output.debugInfoSelection.has_value())
@@ -1355,6 +1407,11 @@ void CommandLineParser::processArgs()
 			CommandLineValidationError,
 			"--" + g_strYulDialect + " and --" + g_strMachine + " are only valid in assembly mode."
 		);
+	else if (m_args.count(g_strImportYulBinary) > 0)
+		solThrow(
+			CommandLineValidationError,
+			"--" + g_strImportYulBinary + " is only valid in assembly mode."
+		);
 
 	if (m_args.count(g_strMetadataHash))
 	{
@@ -57,7 +57,8 @@ enum class InputMode
 	Linker,
 	Assembler,
 	LanguageServer,
-	EVMAssemblerJSON
+	EVMAssemblerJSON,
+	Server
 };
 
 struct CompilerOutputs
@@ -81,6 +82,7 @@ struct CompilerOutputs
 			{"ir-ast-json", &CompilerOutputs::irAstJson},
 			{"ir-optimized", &CompilerOutputs::irOptimized},
 			{"ir-optimized-ast-json", &CompilerOutputs::irOptimizedAstJson},
+			{"ir-optimized-binary", &CompilerOutputs::irOptimizedBinary},
 			{"hashes", &CompilerOutputs::signatureHashes},
 			{"userdoc", &CompilerOutputs::natspecUser},
 			{"devdoc", &CompilerOutputs::natspecDev},
@@ -106,6 +108,7 @@ struct CompilerOutputs
 	bool yulCFGJson = false;
 	bool irOptimized = false;
 	bool irOptimizedAstJson = false;
+	bool irOptimizedBinary = false;
 	bool signatureHashes = false;
 	bool natspecUser = false;
 	bool natspecDev = false;
@@ -204,6 +207,7 @@ struct CommandLineOptions
 	{
 		yul::YulStack::Machine targetMachine = yul::YulStack::Machine::EVM;
 		yul::YulStack::Language inputLanguage = yul::YulStack::Language::StrictAssembly;
+		bool binaryInput = false;
 	} assembly;
 
 	struct
@@ -245,6 +249,11 @@ struct CommandLineOptions
 		bool initialize = false;
 		ModelCheckerSettings settings;
 	} modelChecker;
+
+	struct
+	{
+		size_t memoryBudget = 512 * 1024 * 1024;
+	} server;
 };
 
 /// Parses the command-line arguments and produces a filled-out CommandLineOptions structure.
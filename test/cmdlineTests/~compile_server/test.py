@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+
+import json
+import os
+import subprocess
+import sys
+from textwrap import dedent
+
+STANDARD_JSON_INPUT = {
+    "language": "Solidity",
+    "sources": {
+        "C.sol": {
+            "content": dedent("""\
+                // SPDX-License-Identifier: GPL-3.0
+                pragma solidity >=0.0;
+                contract C {
+                    uint[] data;
+                    function f(uint x) public returns (uint) {
+                        data.push(x);
+                        return data.length * x;
+                    }
+                }
+            """),
+        },
+    },
+    "settings": {
+        "optimizer": {"enabled": True},
+        "viaIR": True,
+        "outputSelection": {"*": {"*": ["evm.bytecode.object"]}},
+    },
+}
+
+
+def send(process, message):
+    body = json.dumps(message).encode("utf-8")
+    process.stdin.write(f"Content-Length: {len(body)}\r\n\r\n".encode("utf-8") + body)
+    process.stdin.flush()
+
+
+def receive(process):
+    content_length = None
+    while True:
+        line = process.stdout.readline().decode("utf-8").strip()
+        if line == "":
+            break
+        name, value = line.split(":", 1)
+        if name.strip().lower() == "content-length":
+            content_length = int(value)
+    if content_length is None:
+        raise RuntimeError("Response without Content-Length header.")
+    return json.loads(process.stdout.read(content_length))
+
+
+def bytecode(standard_json_output):
+    errors = [error for error in standard_json_output.get("errors", []) if error["severity"] == "error"]
+    if len(errors) != 0:
+        raise RuntimeError(f"Compilation failed: {errors}")
+    return standard_json_output["contracts"]["C.sol"]["C"]["evm"]["bytecode"]["object"]
+
+
+def test_compile_server():
+    solc_binary = os.environ.get("SOLC")
+    if solc_binary is None:
+        raise RuntimeError(
+            dedent(
+                """\
+            `solc` compiler not found.
+            Please ensure you set the SOLC environment variable
+            with the correct path to the compiler's binary.
+        """
+            )
+        )
+
+    fresh_output = json.loads(subprocess.run(
+        [solc_binary, "--standard-json"],
+        input=json.dumps(STANDARD_JSON_INPUT),
+        capture_output=True,
+        text=True,
+        check=True,
+    ).stdout)
+
+    with subprocess.Popen([solc_binary, "--server"], stdin=subprocess.PIPE, stdout=subprocess.PIPE) as process:
+        # The second request is answered from the parsed source and optimized object caches.
+        replies = []
+        for request_id in (1, 2):
+            send(process, {"jsonrpc": "2.0", "id": request_id, "method": "compile", "params": STANDARD_JSON_INPUT})
+            replies.append(receive(process))
+        send(process, {"jsonrpc": "2.0", "method": "exit"})
+        process.stdin.close()
+        exit_code = process.wait(timeout=60)
+
+    if exit_code != 0:
+        print(f"Compiler server exited with code {exit_code}.")
+        return 1
+    for request_id, reply in zip((1, 2), replies):
+        if reply.get("id") != request_id or "result" not in reply:
+            print(f"Unexpected reply to request {request_id}: {reply}")
+            return 1
+        if bytecode(reply["result"]) != bytecode(fresh_output):
+            print(f"Bytecode of request {request_id} differs from a fresh compilation.")
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(test_compile_server())
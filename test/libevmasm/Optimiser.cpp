@@ -244,6 +244,20 @@ BOOST_AUTO_TEST_CASE(cse_unneeded_items)
 	checkCSE(input, input);
 }
 
+BOOST_AUTO_TEST_CASE(cse_expression_classes_limit)
+{
+	// Every distinct constant is a separate expression class.
+	evmasm::KnownState state;
+	for (unsigned i = 0; i < 100000; ++i)
+	{
+		state.feedItem(AssemblyItem(u256(i)), true);
+		state.feedItem(AssemblyItem(Instruction::POP), true);
+	}
+	evmasm::CommonSubexpressionEliminator cse(state);
+	AssemblyItems input{u256(100000), Instruction::POP};
+	BOOST_CHECK_THROW(cse.feedItems(input.begin(), input.end(), false), ExpressionClassesLimitException);
+}
+
 BOOST_AUTO_TEST_CASE(cse_constant_addition)
 {
 	AssemblyItems input{u256(7), u256(8), Instruction::ADD};
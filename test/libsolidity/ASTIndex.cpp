@@ -0,0 +1,178 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Tests for the AST index of the language server.
+ */
+
+#include <test/Common.h>
+#include <test/libsolidity/util/SoltestErrors.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTUtils.h>
+#include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/lsp/ASTIndex.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace solidity::lsp;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+std::string const source = R"(pragma solidity >=0.0;
+contract C {
+	struct S { uint m; }
+	S s;
+	function f(uint a, uint b) public returns (uint) {
+		uint r = a+b*s.m;
+		assembly { r := add(r, a) }
+		return g({y: r, x: a});
+	}
+	function g(uint x, uint y) internal pure returns (uint) { return x-y; }
+})";
+
+/// Collects all identifiers and member accesses of an AST.
+class ReferenceCollector: public ASTConstVisitor
+{
+public:
+	void endVisit(Identifier const& _identifier) override { references.push_back(&_identifier); }
+	void endVisit(MemberAccess const& _memberAccess) override { references.push_back(&_memberAccess); }
+
+	std::vector<Expression const*> references;
+};
+
+void analyze(CompilerStack& _compiler)
+{
+	_compiler.setSources({{"a.sol", source}});
+	_compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(_compiler.parseAndAnalyze());
+}
+
+int offsetOf(std::string const& _text)
+{
+	size_t offset = source.find(_text);
+	soltestAssert(offset != std::string::npos);
+	return static_cast<int>(offset);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ASTIndexTest)
+
+BOOST_AUTO_TEST_CASE(innermost_node_matches_ast_walk)
+{
+	CompilerStack compiler;
+	analyze(compiler);
+	ASTIndex index(compiler);
+	SourceUnit const& sourceUnit = compiler.ast("a.sol");
+
+	// Includes offsets outside of the source and the boundaries of all nodes.
+	for (int offset = -1; offset <= static_cast<int>(source.size()) + 1; ++offset)
+		BOOST_CHECK_MESSAGE(
+			index.innermostNode(sourceUnit, offset) == locateInnermostASTNode(offset, sourceUnit),
+			"Different nodes at offset " + std::to_string(offset)
+		);
+}
+
+BOOST_AUTO_TEST_CASE(adjacent_and_nested_nodes)
+{
+	CompilerStack compiler;
+	analyze(compiler);
+	ASTIndex index(compiler);
+	SourceUnit const& sourceUnit = compiler.ast("a.sol");
+
+	auto nodeAt = [&](int _offset) { return index.innermostNode(sourceUnit, _offset); };
+	int const sum = offsetOf("a+b*s.m");
+
+	// Nodes without whitespace in between: the end of a node is the start of the next one.
+	auto const* a = dynamic_cast<Identifier const*>(nodeAt(sum));
+	BOOST_REQUIRE(a);
+	BOOST_CHECK_EQUAL(a->name(), "a");
+	BOOST_CHECK(dynamic_cast<BinaryOperation const*>(nodeAt(sum + 1)));
+	auto const* b = dynamic_cast<Identifier const*>(nodeAt(sum + 2));
+	BOOST_REQUIRE(b);
+	BOOST_CHECK_EQUAL(b->name(), "b");
+
+	// Nested nodes starting at the same offset: the innermost one is found.
+	auto const* s = dynamic_cast<Identifier const*>(nodeAt(sum + 4));
+	BOOST_REQUIRE(s);
+	BOOST_CHECK_EQUAL(s->name(), "s");
+	auto const* member = dynamic_cast<MemberAccess const*>(nodeAt(sum + 5));
+	BOOST_REQUIRE(member);
+	BOOST_CHECK_EQUAL(member->memberName(), "m");
+	BOOST_CHECK(nodeAt(sum + 6) == member);
+}
+
+BOOST_AUTO_TEST_CASE(references_to_declarations)
+{
+	CompilerStack compiler;
+	analyze(compiler);
+	ASTIndex index(compiler);
+	SourceUnit const& sourceUnit = compiler.ast("a.sol");
+
+	ReferenceCollector collector;
+	sourceUnit.accept(collector);
+	BOOST_REQUIRE(!collector.references.empty());
+	for (Expression const* reference: collector.references)
+	{
+		Declaration const* declaration = nullptr;
+		if (auto const* identifier = dynamic_cast<Identifier const*>(reference))
+			declaration = identifier->annotation().referencedDeclaration;
+		else
+			declaration = dynamic_cast<MemberAccess const&>(*reference).annotation().referencedDeclaration;
+		if (!declaration)
+			continue;
+		std::vector<ASTIndex::Reference> const& references = index.references(*declaration);
+		BOOST_CHECK(std::count_if(references.begin(), references.end(), [&](ASTIndex::Reference const& _reference) {
+			return _reference.node == reference && _reference.sourceUnit == &sourceUnit;
+		}) == 1);
+	}
+
+	// Named arguments and inline assembly refer to the parameters.
+	auto const* g = dynamic_cast<FunctionDefinition const*>(
+		index.innermostNode(sourceUnit, offsetOf("function g") + 1)
+	);
+	BOOST_REQUIRE(g);
+	bool referencedByCall = false;
+	for (ASTIndex::Reference const& reference: index.references(*g->parameters().at(1)))
+		if (dynamic_cast<FunctionCall const*>(reference.node))
+			referencedByCall = true;
+	BOOST_CHECK(referencedByCall);
+
+	auto const* f = dynamic_cast<FunctionDefinition const*>(
+		index.innermostNode(sourceUnit, offsetOf("function f") + 1)
+	);
+	BOOST_REQUIRE(f);
+	bool referencedByAssembly = false;
+	for (ASTIndex::Reference const& reference: index.references(*f->parameters().at(0)))
+		if (dynamic_cast<InlineAssembly const*>(reference.node))
+			referencedByAssembly = true;
+	BOOST_CHECK(referencedByAssembly);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -196,6 +196,105 @@ BOOST_AUTO_TEST_CASE(function_calls)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(repeated_internal_calls)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint data;
+			uint data2;
+			function f(uint x) public {
+				unchecked { data = g(x) + g(x + 1); }
+			}
+			function g(uint x) internal view returns (uint) {
+				return data2 + x;
+			}
+		}
+	)";
+	compileAndRun(sourceCode);
+	// Both calls of g jump to the same tag, which must not be mistaken for a loop.
+	GasMeter::GasConsumption gas = gasForTransaction(util::selectorFromSignatureH32("f(uint256)").asBytes() + encodeArgs(2), false);
+	gas += GasEstimator(solidity::test::CommonOptions::get().evmVersion()).functionalEstimation(
+		*m_compiler.runtimeAssemblyItems(m_compiler.lastContractName()),
+		"f(uint256)"
+	);
+	BOOST_REQUIRE(!gas.isInfinite);
+	BOOST_CHECK(callContractFunction("f(uint256)", 2) == encodeArgs());
+	BOOST_CHECK_LE(m_gasUsed, gas.value);
+}
+
+BOOST_AUTO_TEST_CASE(many_branches)
+{
+	// A chain of 1000 conditional stores has 2^1000 paths, the estimate has to be computed
+	// from the block graph without enumerating them.
+	AssemblyItems branches;
+	AssemblyItems straightLine;
+	for (unsigned i = 0; i < 1000; ++i)
+	{
+		branches += AssemblyItems{
+			u256(0),
+			Instruction::CALLDATALOAD,
+			AssemblyItem(PushTag, i + 1),
+			Instruction::JUMPI,
+			u256(1),
+			u256(i),
+			Instruction::SSTORE,
+			AssemblyItem(Tag, i + 1)
+		};
+		straightLine += AssemblyItems{u256(1), u256(i), Instruction::SSTORE};
+	}
+	branches.emplace_back(Instruction::STOP);
+	straightLine.emplace_back(Instruction::STOP);
+
+	langutil::EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	GasMeter::GasConsumption gas = PathGasMeter::estimateMax(branches, evmVersion, 0, std::make_shared<KnownState>());
+	GasMeter::GasConsumption straightLineGas = PathGasMeter::estimateMax(straightLine, evmVersion, 0, std::make_shared<KnownState>());
+	BOOST_REQUIRE(!gas.isInfinite);
+	BOOST_REQUIRE(!straightLineGas.isInfinite);
+	// The path that takes none of the jumps executes all stores.
+	BOOST_CHECK_LE(straightLineGas.value, gas.value);
+}
+
+BOOST_AUTO_TEST_CASE(jump_condition_known_on_one_path)
+{
+	// Both paths reach tag 2 and then tag 4 with the same tags on the stack. Only on the path
+	// through tag 1, which is summarized first, the condition of the jump at tag 4 is known to be
+	// non-zero. The other path can reach the store after that jump.
+	AssemblyItems items{
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 1),
+		Instruction::JUMPI,
+		u256(0),
+		Instruction::CALLDATALOAD,
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		AssemblyItem(PushTag, 2),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		AssemblyItem(PushTag, 4),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 4),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMPI,
+		u256(1),
+		u256(0),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 3),
+		Instruction::STOP
+	};
+	AssemblyItems store{u256(1), u256(0), Instruction::SSTORE, Instruction::STOP};
+
+	langutil::EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	GasMeter::GasConsumption gas = PathGasMeter::estimateMax(items, evmVersion, 0, std::make_shared<KnownState>());
+	GasMeter::GasConsumption storeGas = PathGasMeter::estimateMax(store, evmVersion, 0, std::make_shared<KnownState>());
+	BOOST_REQUIRE(!gas.isInfinite);
+	BOOST_REQUIRE(!storeGas.isInfinite);
+	BOOST_CHECK_LE(storeGas.value, gas.value);
+}
+
 BOOST_AUTO_TEST_CASE(multiple_external_functions)
 {
 	char const* sourceCode = R"(
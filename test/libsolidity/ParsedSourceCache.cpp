@@ -0,0 +1,160 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Tests for reusing parsed sources across compilations.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/ASTJsonExporter.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/ParsedSourceCache.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <set>
+#include <string>
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+StringMap const librarySources{
+	{"a.sol", R"(
+		pragma solidity >=0.0;
+		library L {
+			function f(uint x) internal pure returns (uint y) {
+				assembly { y := add(x, 1) }
+			}
+		}
+	)"},
+	{"b.sol", R"(
+		pragma solidity >=0.0;
+		import "a.sol";
+		contract C {
+			function g(uint x) public pure returns (uint) { return L.f(x); }
+		}
+	)"},
+};
+
+void compile(CompilerStack& _compiler, StringMap const& _sources, std::shared_ptr<ParsedSourceCache> _cache)
+{
+	_compiler.setParsedSourceCache(std::move(_cache));
+	_compiler.setSources(_sources);
+	_compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(_compiler.compile());
+}
+
+Json astJson(CompilerStack const& _compiler, std::string const& _sourceName)
+{
+	return ASTJsonExporter(_compiler.state(), _compiler.sourceIndices()).toJson(_compiler.ast(_sourceName));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ParsedSourceCacheTest)
+
+BOOST_AUTO_TEST_CASE(unchanged_sources_are_reused)
+{
+	auto cache = std::make_shared<ParsedSourceCache>();
+
+	CompilerStack reference;
+	compile(reference, librarySources, nullptr);
+
+	CompilerStack compiler;
+	compile(compiler, librarySources, cache);
+	BOOST_CHECK_EQUAL(cache->size(), 2);
+	SourceUnit const* firstAST = &compiler.ast("a.sol");
+
+	compiler.reset();
+	compile(compiler, librarySources, cache);
+	BOOST_CHECK(&compiler.ast("a.sol") == firstAST);
+	BOOST_CHECK_EQUAL(cache->size(), 2);
+
+	for (std::string const sourceName: {"a.sol", "b.sol"})
+		BOOST_CHECK(astJson(compiler, sourceName) == astJson(reference, sourceName));
+	BOOST_CHECK(compiler.object("b.sol:C").bytecode == reference.object("b.sol:C").bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(sources_in_use_are_not_shared)
+{
+	auto cache = std::make_shared<ParsedSourceCache>();
+
+	CompilerStack first;
+	compile(first, librarySources, cache);
+	CompilerStack second;
+	compile(second, librarySources, cache);
+
+	BOOST_CHECK(&first.ast("a.sol") != &second.ast("a.sol"));
+	BOOST_CHECK(astJson(first, "a.sol") == astJson(second, "a.sol"));
+	BOOST_CHECK(first.object("b.sol:C").bytecode == second.object("b.sol:C").bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(simultaneous_compilations_reuse_their_own_sources)
+{
+	auto cache = std::make_shared<ParsedSourceCache>();
+
+	CompilerStack first;
+	compile(first, librarySources, cache);
+	CompilerStack second;
+	compile(second, librarySources, cache);
+	BOOST_CHECK_EQUAL(cache->size(), 4);
+	std::set<SourceUnit const*> const asts{&first.ast("a.sol"), &second.ast("a.sol")};
+
+	first.reset();
+	compile(first, librarySources, cache);
+	second.reset();
+	compile(second, librarySources, cache);
+	BOOST_CHECK_EQUAL(cache->size(), 4);
+	BOOST_CHECK(&first.ast("a.sol") != &second.ast("a.sol"));
+	BOOST_CHECK(asts.count(&first.ast("a.sol")));
+	BOOST_CHECK(asts.count(&second.ast("a.sol")));
+	BOOST_CHECK(first.object("b.sol:C").bytecode == second.object("b.sol:C").bytecode);
+}
+
+BOOST_AUTO_TEST_CASE(sources_with_shifted_ids_are_renumbered)
+{
+	auto cache = std::make_shared<ParsedSourceCache>();
+
+	CompilerStack compiler;
+	compile(compiler, librarySources, cache);
+	SourceUnit const* firstAST = &compiler.ast("b.sol");
+	int64_t const firstID = firstAST->id();
+	compiler.reset();
+
+	// Modifying a.sol changes the IDs of all nodes in b.sol.
+	StringMap modifiedSources = librarySources;
+	modifiedSources["a.sol"] += "contract D {}";
+	compile(compiler, modifiedSources, cache);
+	BOOST_CHECK(&compiler.ast("b.sol") == firstAST);
+	BOOST_CHECK(compiler.ast("b.sol").id() != firstID);
+
+	CompilerStack reference;
+	compile(reference, modifiedSources, nullptr);
+	BOOST_CHECK(astJson(compiler, "a.sol") == astJson(reference, "a.sol"));
+	BOOST_CHECK(astJson(compiler, "b.sol") == astJson(reference, "b.sol"));
+	BOOST_CHECK(compiler.object("b.sol:C").bytecode == reference.object("b.sol:C").bytecode);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -282,6 +282,29 @@ BOOST_AUTO_TEST_CASE(helper_string_result)
 	BOOST_REQUIRE_EQUAL(r1.message(), "Failure");
 }
 
+BOOST_AUTO_TEST_CASE(type_provider_scoped_instance)
+{
+	TypeProvider outerProvider;
+	TypeProvider innerProvider;
+
+	Type const* outerUint;
+	Type const* outerString;
+	{
+		TypeProvider::ScopedInstance outerScope{outerProvider};
+		outerUint = TypeProvider::uint256();
+		outerString = TypeProvider::stringMemory();
+		{
+			TypeProvider::ScopedInstance innerScope{innerProvider};
+			BOOST_CHECK(TypeProvider::uint256() != outerUint);
+			BOOST_CHECK(TypeProvider::stringMemory() != outerString);
+			BOOST_CHECK(*TypeProvider::uint256() == *outerUint);
+		}
+		BOOST_CHECK(TypeProvider::uint256() == outerUint);
+		BOOST_CHECK(TypeProvider::stringMemory() == outerString);
+	}
+	BOOST_CHECK(TypeProvider::uint256() != outerUint);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
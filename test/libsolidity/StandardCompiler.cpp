@@ -23,6 +23,7 @@
 #include <string>
 #include <boost/test/unit_test.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
@@ -596,6 +597,35 @@ BOOST_AUTO_TEST_CASE(basic_compilation)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(types_owned_by_compilation)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"fileA": {
+				"content": "contract A { event E(string); error Err(bytes); function f(string memory s) public returns (bytes32) { emit E(s); return keccak256(bytes(s)); } }"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": {
+					"*": [ "*" ],
+					"": [ "ast" ]
+				}
+			}
+		}
+	}
+	)";
+	// All types created during the compilation, including the AST export, have to be owned
+	// by the TypeProvider of the compilation and not leak into the default one of this thread.
+	size_t typeCount = TypeProvider::defaultInstanceTypeCount();
+	Json result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["sources"]["fileA"]["ast"].is_object());
+	BOOST_CHECK_EQUAL(TypeProvider::defaultInstanceTypeCount(), typeCount);
+}
+
 BOOST_AUTO_TEST_CASE(compilation_error)
 {
 	char const* input = R"(
@@ -0,0 +1,81 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the table of interned names.
+ */
+
+#include <libsolidity/analysis/SymbolTable.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+namespace solidity::frontend::test
+{
+
+BOOST_AUTO_TEST_SUITE(SymbolTableTest)
+
+BOOST_AUTO_TEST_CASE(intern_and_find)
+{
+	SymbolTable table;
+	BOOST_CHECK(!table.find("a"));
+
+	SymbolTable::Symbol a = table.intern("a");
+	SymbolTable::Symbol b = table.intern("b");
+	BOOST_CHECK(a != b);
+	BOOST_CHECK_EQUAL(table.intern("a"), a);
+	BOOST_CHECK_EQUAL(table.intern(std::string("b")), b);
+	BOOST_CHECK(table.find("a") == a);
+	BOOST_CHECK(table.find("b") == b);
+	BOOST_CHECK(!table.find("c"));
+	BOOST_CHECK(!table.find(""));
+	BOOST_CHECK_EQUAL(table.name(a), "a");
+	BOOST_CHECK_EQUAL(table.name(b), "b");
+}
+
+BOOST_AUTO_TEST_CASE(names_are_copied)
+{
+	SymbolTable table;
+	std::string name = "abc";
+	SymbolTable::Symbol symbol = table.intern(name);
+	name = "xyz";
+	BOOST_CHECK_EQUAL(table.name(symbol), "abc");
+	BOOST_CHECK(table.find("abc") == symbol);
+	BOOST_CHECK(!table.find("xyz"));
+}
+
+BOOST_AUTO_TEST_CASE(many_names)
+{
+	// The lookup keys refer to the stored names, which must not move when more names are added.
+	SymbolTable table;
+	std::vector<SymbolTable::Symbol> symbols;
+	for (size_t i = 0; i < 10000; ++i)
+		symbols.emplace_back(table.intern("name" + std::to_string(i)));
+	for (size_t i = 0; i < symbols.size(); ++i)
+	{
+		std::string name = "name" + std::to_string(i);
+		BOOST_CHECK(table.find(name) == symbols[i]);
+		BOOST_CHECK_EQUAL(table.name(symbols[i]), name);
+		BOOST_CHECK_EQUAL(table.intern(name), symbols[i]);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,14 @@
+contract A {
+    uint abcd;
+    function f(uint abce) public pure returns (uint) { return abce; }
+}
+contract B {
+    function g() public pure {
+        uint abcf = 1;
+        abcg;
+        abcd;
+    }
+}
+// ----
+// DeclarationError 7576: (175-179): Undeclared identifier. Did you mean "abcf" or "abi"?
+// DeclarationError 7576: (189-193): Undeclared identifier. Did you mean "abcf" or "abi"?
@@ -0,0 +1,11 @@
+contract C {
+    uint abcd;
+    function f(uint abce) public {
+        uint abcf = abce;
+        abcg = abcf;
+        uint abch = 2;
+        abch;
+    }
+}
+// ----
+// DeclarationError 7576: (97-101): Undeclared identifier. Did you mean "abcf", "abch", "abce", "abcd" or "abi"?
@@ -20,7 +20,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace solidity::util::test
 {
@@ -114,6 +116,25 @@ BOOST_AUTO_TEST_CASE(move_constructed_has_same_value_as_original)
 	BOOST_CHECK_EQUAL(valueOf(std::move(moveConstructed)), 12);
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_init_stores_one_value)
+{
+	LazyInit<std::vector<size_t> const> lazyInit;
+	std::vector<std::vector<size_t> const*> results(8, nullptr);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < results.size(); ++i)
+		threads.emplace_back([&, i]{
+			results[i] = &lazyInit.init([&]{ return std::vector<size_t>(1000, i); });
+		});
+	for (std::thread& thread: threads)
+		thread.join();
+
+	for (std::vector<size_t> const* result: results)
+		BOOST_CHECK(result == results.front());
+	size_t const value = results.front()->front();
+	BOOST_CHECK(*results.front() == std::vector<size_t>(1000, value));
+	BOOST_CHECK_EQUAL(lazyInit.init([]{ return std::vector<size_t>{}; }).size(), 1000);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for ThreadPool.
+ */
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(task_results)
+{
+	for (size_t maxThreads: {0u, 1u, 4u})
+	{
+		ThreadPool pool(maxThreads);
+		std::vector<std::future<size_t>> results;
+		for (size_t i = 0; i < 100; ++i)
+			results.emplace_back(pool.submit([i]() { return i * i; }));
+		for (size_t i = 0; i < 100; ++i)
+			BOOST_CHECK_EQUAL(results[i].get(), i * i);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(exceptions)
+{
+	ThreadPool pool(2);
+	std::future<int> result = pool.submit([]() -> int { throw std::runtime_error("failure"); });
+	BOOST_CHECK_THROW(result.get(), std::runtime_error);
+	BOOST_CHECK_EQUAL(pool.submit([]() { return 42; }).get(), 42);
+}
+
+BOOST_AUTO_TEST_CASE(destructor_waits_for_tasks)
+{
+	std::atomic<size_t> finished = 0;
+	{
+		ThreadPool pool(3);
+		for (size_t i = 0; i < 50; ++i)
+			pool.submit([&]() { ++finished; });
+	}
+	BOOST_CHECK_EQUAL(finished.load(), 50);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -72,7 +72,8 @@ TestCase::TestResult EVMCodeTransformTest::run(std::ostream& _stream, std::strin
 	EVMObjectCompiler::compile(
 		*yulStack.parserResult(),
 		adapter,
-		m_stackOpt
+		m_stackOpt,
+		settings.expectedExecutionsPerDeployment
 	);
 
 	m_obtainedResult = toString(assembly);
@@ -0,0 +1,221 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the compact binary format of Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+#include <libyul/ObjectBinaryFormat.h>
+#include <libyul/YulStack.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+YulStack emptyStack()
+{
+	return YulStack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		OptimiserSettings::none(),
+		DebugInfoSelection::AllExceptExperimental()
+	);
+}
+
+YulStack importBinary(bytes const& _binary)
+{
+	YulStack yulStack = emptyStack();
+	yulStack.importBinaryAndAnalyze("source", util::asString(_binary));
+	return yulStack;
+}
+
+/// @returns the binary encoding of an object with the given code, which is not validated.
+bytes binaryOf(Block _code)
+{
+	Object object;
+	object.name = "A";
+	object.setCode(std::make_shared<AST>(
+		EVMDialect::strictAssemblyForEVMObjects(
+			solidity::test::CommonOptions::get().evmVersion(),
+			solidity::test::CommonOptions::get().eofVersion()
+		),
+		std::move(_code)
+	));
+	return ObjectBinaryWriter::write(object);
+}
+
+Statement declaration(std::string const& _name, Literal _value)
+{
+	return VariableDeclaration{
+		{},
+		{NameWithDebugData{{}, YulName{_name}}},
+		std::make_unique<Expression>(std::move(_value))
+	};
+}
+
+Literal number(u256 const& _value)
+{
+	return Literal{{}, LiteralKind::Number, LiteralValue(_value)};
+}
+
+void checkImportFails(bytes const& _binary)
+{
+	YulStack imported = importBinary(_binary);
+	BOOST_REQUIRE(imported.hasErrors());
+	BOOST_REQUIRE_EQUAL(imported.errors().size(), 1);
+	BOOST_CHECK(imported.errors().front()->errorId() == 6391_error);
+}
+
+std::string const sourceWithSubObjects = R"(
+	/// @use-src 0:"a.sol", 1:"b.sol"
+	object "A" {
+		code {
+			/// @src 0:10:20
+			function f(a, b) -> c {
+				for { let i := 0 } lt(i, b) { i := add(i, 1) } {
+					switch a
+					case 0 { c := 0x1234 }
+					case "abc" { c := "def" }
+					default { leave }
+				}
+			}
+			/// @src 1:5:15
+			sstore(0, f(calldataload(0), 7))
+			datacopy(0, dataoffset("B"), datasize("B"))
+			if iszero(callvalue()) { return(0, datasize("data1")) }
+		}
+		object "B" {
+			code {
+				let x := 115792089237316195423570985008687907853269984665640564039457584007913129639935
+				mstore(0, x)
+			}
+		}
+		data "data1" hex"00ff"
+	}
+)";
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulObjectBinaryFormat)
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	YulStack original = parseYul(sourceWithSubObjects, "source", OptimiserSettings::none());
+	BOOST_REQUIRE(!original.hasErrors());
+	bytes const binary = original.binary();
+	BOOST_REQUIRE(ObjectBinaryReader::isObjectBinary(bytesConstRef(&binary)));
+
+	YulStack imported = importBinary(binary);
+	BOOST_REQUIRE(!imported.hasErrors());
+	BOOST_CHECK_EQUAL(imported.print(), original.print());
+
+	// Native locations are dropped on import, but everything else is stable.
+	bytes const reencoded = imported.binary();
+	BOOST_CHECK(importBinary(reencoded).binary() == reencoded);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_input)
+{
+	YulStack original = parseYul(sourceWithSubObjects, "source", OptimiserSettings::none());
+	BOOST_REQUIRE(!original.hasErrors());
+	bytes const binary = original.binary();
+
+	for (bytes const& invalid: {
+		bytes{},
+		bytes(binary.begin(), binary.begin() + 4),
+		bytes(binary.begin(), binary.end() - 1),
+		bytes(binary.begin(), binary.begin() + static_cast<ptrdiff_t>(binary.size() / 2)),
+		binary + bytes{0x00}
+	})
+		checkImportFails(invalid);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_code)
+{
+	BOOST_REQUIRE(!importBinary(binaryOf(Block{{}, {}})).hasErrors());
+	BOOST_REQUIRE(!importBinary(binaryOf(Block{{}, {declaration("x", number(1))}})).hasErrors());
+
+	// Empty name.
+	checkImportFails(binaryOf(Block{{}, {declaration("", number(1))}}));
+	// Hint that does not match the value.
+	checkImportFails(binaryOf(Block{{}, {declaration("x", Literal{{}, LiteralKind::Number, LiteralValue(1, std::string{"2"})})}}));
+	// Unlimited value outside of a literal argument, with and without a matching kind.
+	checkImportFails(binaryOf(Block{{}, {declaration("x", Literal{{}, LiteralKind::Number, LiteralValue(std::string{"1"})})}}));
+	checkImportFails(binaryOf(Block{{}, {declaration("x", Literal{{}, LiteralKind::String, LiteralValue(std::string{"abc"})})}}));
+	// Declaration and assignment without variables.
+	checkImportFails(binaryOf(Block{{}, {VariableDeclaration{{}, {}, std::make_unique<Expression>(number(1))}}}));
+	checkImportFails(binaryOf(Block{{}, {
+		declaration("x", number(1)),
+		Assignment{{}, {}, std::make_unique<Expression>(number(2))}
+	}}));
+	// Break, continue and leave outside of a loop body or function.
+	checkImportFails(binaryOf(Block{{}, {Break{}}}));
+	checkImportFails(binaryOf(Block{{}, {Continue{}}}));
+	checkImportFails(binaryOf(Block{{}, {Leave{}}}));
+	checkImportFails(binaryOf(Block{{}, {
+		ForLoop{{}, Block{{}, {}}, std::make_unique<Expression>(number(1)), Block{{}, {Break{}}}, Block{{}, {}}}
+	}}));
+	checkImportFails(binaryOf(Block{{}, {
+		ForLoop{{}, Block{{}, {}}, std::make_unique<Expression>(number(1)), Block{{}, {}}, Block{{}, {
+			FunctionDefinition{{}, YulName{"f"}, {}, {}, Block{{}, {Break{}}}}
+		}}}
+	}}));
+	BOOST_REQUIRE(!importBinary(binaryOf(Block{{}, {
+		ForLoop{{}, Block{{}, {}}, std::make_unique<Expression>(number(1)), Block{{}, {}}, Block{{}, {
+			Block{{}, {Break{}, Continue{}}}
+		}}}
+	}}))).hasErrors());
+	// Switch without cases and with a default case that is not the last one.
+	checkImportFails(binaryOf(Block{{}, {Switch{{}, std::make_unique<Expression>(number(1)), {}}}}));
+	Switch defaultFirst{{}, std::make_unique<Expression>(number(1)), {}};
+	defaultFirst.cases.emplace_back(Case{{}, nullptr, Block{{}, {}}});
+	defaultFirst.cases.emplace_back(Case{{}, std::make_unique<Literal>(number(0)), Block{{}, {}}});
+	checkImportFails(binaryOf(Block{{}, {std::move(defaultFirst)}}));
+
+	// Nesting deeper than the parser allows.
+	Block nested{{}, {}};
+	for (size_t i = 0; i < 2000; ++i)
+		nested = Block{{}, {std::move(nested)}};
+	checkImportFails(binaryOf(std::move(nested)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,136 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the stack compressor with the legacy code generator, which only re-checks
+ * the functions changed by the previous iteration.
+ */
+
+#include <test/Common.h>
+
+#include <test/libsolidity/util/SoltestErrors.h>
+
+#include <libyul/optimiser/StackCompressor.h>
+#include <libyul/AST.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/Object.h>
+#include <libyul/YulStack.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+/// Runs the stack compressor on @a _source, which has to be disambiguated and grouped already.
+/// Homestead is used so that the legacy code generator determines the stack deficit.
+/// @returns whether the compressor succeeded and the names of the functions of the result
+/// together with their code, in the order of their definition.
+std::pair<bool, std::vector<std::pair<YulName, std::string>>> compress(std::string const& _source)
+{
+	YulStack yulStack(
+		langutil::EVMVersion::homestead(),
+		std::nullopt,
+		YulStack::Language::StrictAssembly,
+		frontend::OptimiserSettings::minimal(),
+		langutil::DebugInfoSelection::None()
+	);
+	soltestAssert(yulStack.parseAndAnalyze("", _source));
+	Object const& object = *yulStack.parserResult();
+	auto [success, block] = StackCompressor::run(object, true, 16);
+	BOOST_REQUIRE(!block.statements.empty());
+	BOOST_CHECK(std::holds_alternative<Block>(block.statements.front()));
+
+	AsmPrinter printer(*object.dialect(), {}, langutil::DebugInfoSelection::None());
+	std::vector<std::pair<YulName, std::string>> functions;
+	for (Statement const& statement: block.statements)
+		if (auto const* function = std::get_if<FunctionDefinition>(&statement))
+			functions.emplace_back(function->name, printer(*function));
+	return {success, functions};
+}
+
+/// Needs a second iteration: the unused variables are the cheapest candidates and are all chosen
+/// in the first iteration, which does not change the stack height at which @a b is accessed.
+std::string const deepFunction = R"(
+	function f() {
+		let u1 := calldataload(1)
+		let u2 := calldataload(2)
+		let u3 := calldataload(3)
+		let u4 := calldataload(4)
+		let u5 := calldataload(5)
+		let u6 := calldataload(6)
+		let a := calldataload(0)
+		let b := calldataload(a)
+		mstore(b, add(add(add(add(add(add(add(add(add(add(add(add(add(add(add(add(add(add(b, 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1))
+	}
+)";
+
+/// Compilable after the first iteration.
+std::string const shallowFunction = R"(
+	function g() {
+		let y := calldataload(calldataload(9))
+		mstore(y, add(add(add(add(add(add(add(add(add(add(add(add(add(add(add(add(add(add(y, 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1), 1))
+	}
+)";
+
+/// Compilable from the start.
+std::string const compilableFunction = R"(
+	function h(x) -> r {
+		let z := calldataload(x)
+		r := add(z, x)
+	}
+)";
+}
+
+BOOST_AUTO_TEST_SUITE(StackCompressorTest)
+
+BOOST_AUTO_TEST_CASE(only_one_function_needs_second_iteration)
+{
+	auto [success, functions] = compress(
+		"{ { f() g() sstore(0, h(1)) }" + deepFunction + shallowFunction + compilableFunction + "}"
+	);
+	BOOST_REQUIRE(success);
+	BOOST_REQUIRE_EQUAL(functions.size(), 3);
+	BOOST_CHECK_EQUAL(functions[0].first.str(), "f");
+	BOOST_CHECK_EQUAL(functions[1].first.str(), "g");
+	BOOST_CHECK_EQUAL(functions[2].first.str(), "h");
+
+	// Only changed functions are checked and pruned again, which has to yield the same code as
+	// compressing every function on its own.
+	for (auto const& [mainBlock, function, index]: {
+		std::tuple{"{ f() }", deepFunction, size_t(0)},
+		std::tuple{"{ g() }", shallowFunction, size_t(1)},
+		std::tuple{"{ sstore(0, h(1)) }", compilableFunction, size_t(2)}
+	})
+	{
+		auto [successAlone, functionsAlone] = compress("{ " + std::string(mainBlock) + function + "}");
+		BOOST_REQUIRE(successAlone);
+		BOOST_REQUIRE_EQUAL(functionsAlone.size(), 1);
+		BOOST_CHECK_EQUAL(functions[index].second, functionsAlone[0].second);
+	}
+
+	BOOST_CHECK(functions[0].second.find("let u1") == std::string::npos);
+	BOOST_CHECK(functions[0].second.find("let b") == std::string::npos);
+	BOOST_CHECK(functions[1].second.find("let y") == std::string::npos);
+	BOOST_CHECK(functions[2].second.find("let z") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -31,6 +31,7 @@
 #include <libsolutil/Visitor.h>
 
 #include <range/v3/view/reverse.hpp>
+#include <range/v3/view/zip.hpp>
 
 #ifdef ISOLTEST
 #include <boost/process.hpp>
@@ -129,12 +130,13 @@ private:
 				}
 			}, entry->exit);
 
-		auto const& blockInfo = m_stackLayout.blockInfos.at(&_block);
+		auto const& blockInfo = m_stackLayout.blockInfo(_block);
 		m_stream << stackToString(blockInfo.entryLayout, m_dialect) << "\\l\\\n";
-		for (auto const& operation: _block.operations)
+		soltestAssert(_block.operations.size() == blockInfo.operationEntryLayouts.size());
+		for (auto&& [operation, operationEntryLayout]: ranges::zip_view(_block.operations, blockInfo.operationEntryLayouts))
 		{
-			auto entryLayout = m_stackLayout.operationEntryLayout.at(&operation);
-			m_stream << stackToString(m_stackLayout.operationEntryLayout.at(&operation), m_dialect) << "\\l\\\n";
+			auto entryLayout = operationEntryLayout;
+			m_stream << stackToString(operationEntryLayout, m_dialect) << "\\l\\\n";
 			std::visit(util::GenericVisitor{
 				[&](CFG::FunctionCall const& _call) {
 					m_stream << _call.function.get().name.str();
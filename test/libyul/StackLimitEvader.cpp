@@ -0,0 +1,118 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the choice of variables moved to memory by the stack limit evader.
+ */
+
+#include <test/Common.h>
+
+#include <test/libsolidity/util/SoltestErrors.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/Disambiguator.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/StackLimitEvader.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/Object.h>
+#include <libyul/YulStack.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+/// Runs the stack limit evader with the given stack too deep errors instead of the ones reported
+/// by the code generator, so that the choice among the variables is under control of the test.
+std::string evade(
+	std::string const& _source,
+	std::map<YulName, std::vector<StackLayoutGenerator::StackTooDeep>> const& _stackTooDeepErrors
+)
+{
+	YulStack yulStack = parseYul(_source);
+	soltestAssert(!yulStack.hasErrorsWarningsOrInfos());
+	Dialect const& dialect = yulStack.dialect();
+	Block block = std::get<Block>(Disambiguator(
+		dialect,
+		*yulStack.parserResult()->analysisInfo,
+		{}
+	)(yulStack.parserResult()->code()->root()));
+
+	std::set<YulName> const reservedIdentifiers;
+	NameDispenser nameDispenser(dialect, block, reservedIdentifiers);
+	OptimiserStepContext context{
+		dialect,
+		nameDispenser,
+		reservedIdentifiers,
+		frontend::OptimiserSettings::standard().expectedExecutionsPerDeployment
+	};
+	StackLimitEvader::run(context, block, _stackTooDeepErrors);
+	return AsmPrinter(dialect)(block);
+}
+
+std::string const loopSource = R"({
+	mstore(0x40, memoryguard(0x80))
+	sstore(0, f(calldataload(0)))
+	function f(n) -> r {
+		let cold := calldataload(32)
+		let hot := 0
+		for { let i := 0 } lt(i, n) { i := add(i, 1) } {
+			hot := add(hot, i)
+		}
+		r := add(hot, cold)
+	}
+})";
+}
+
+BOOST_AUTO_TEST_SUITE(StackLimitEvader)
+
+BOOST_AUTO_TEST_CASE(prefers_variable_outside_of_loop)
+{
+	// The order of the choices must not matter, the variable accessed in the loop stays on the stack.
+	for (std::vector<YulName> choices: {
+		std::vector<YulName>{YulName{"hot"}, YulName{"cold"}},
+		std::vector<YulName>{YulName{"cold"}, YulName{"hot"}}
+	})
+	{
+		std::string const result = evade(loopSource, {{YulName{"f"}, {{1, choices}}}});
+		BOOST_CHECK(result.find("let hot") != std::string::npos);
+		BOOST_CHECK(result.find("let cold") == std::string::npos);
+		BOOST_CHECK(result.find("memoryguard(0xa0)") != std::string::npos);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(prefers_variable_already_in_memory)
+{
+	// Once cold is moved to memory for the first error, it resolves the second one for free,
+	// even though it is listed last.
+	std::string const result = evade(loopSource, {{YulName{"f"}, {
+		{1, {YulName{"hot"}, YulName{"cold"}}},
+		{1, {YulName{"r"}, YulName{"cold"}}}
+	}}});
+	BOOST_CHECK(result.find("let hot") != std::string::npos);
+	BOOST_CHECK(result.find("let cold") == std::string::npos);
+	BOOST_CHECK(result.find("memoryguard(0xa0)") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
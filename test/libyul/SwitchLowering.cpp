@@ -0,0 +1,259 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the lowering of switches to a binary search over the case values
+ * by the control flow graph builders.
+ */
+
+#include <test/Common.h>
+
+#include <test/libsolidity/util/SoltestErrors.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/backends/evm/ControlFlow.h>
+#include <libyul/backends/evm/ControlFlowGraph.h>
+#include <libyul/backends/evm/ControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/SSAControlFlowGraph.h>
+#include <libyul/backends/evm/SSAControlFlowGraphBuilder.h>
+#include <libyul/backends/evm/SwitchLowering.h>
+#include <libyul/Object.h>
+#include <libyul/YulStack.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <range/v3/view/reverse.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+/// Key stored by the code following the switch, i.e. if no case and no default case is taken.
+u256 const afterSwitch = 1000;
+
+/// @returns a switch over ``calldataload(0)`` whose cases store their value as key and are
+/// followed by a store with key ``afterSwitch``.
+/// If @a _defaultKey is given, the default case stores this key.
+std::string switchSource(std::vector<unsigned> const& _values, std::optional<unsigned> _defaultKey = std::nullopt)
+{
+	std::string source = "{ switch calldataload(0)\n";
+	for (unsigned value: _values)
+		source += "case " + std::to_string(value) + " { sstore(" + std::to_string(value) + ", 0) }\n";
+	if (_defaultKey)
+		source += "default { sstore(" + std::to_string(*_defaultKey) + ", 0) }\n";
+	source += "sstore(" + afterSwitch.str() + ", 0) }";
+	return source;
+}
+
+/// Evaluates the builtins used for selecting the case of the switch.
+u256 evaluate(std::string const& _builtin, std::vector<u256> const& _arguments, u256 const& _switchValue)
+{
+	if (_builtin == "calldataload")
+		return _switchValue;
+	soltestAssert(_arguments.size() == 2);
+	if (_builtin == "eq")
+		return _arguments[0] == _arguments[1] ? 1 : 0;
+	soltestAssert(_builtin == "lt");
+	return _arguments[0] < _arguments[1] ? 1 : 0;
+}
+
+/// Follows the control flow of @a _cfg for the value @a _switchValue of the switch expression.
+/// @returns the key of the first ``sstore`` reached and the values compared against by ``lt``
+/// on the way.
+std::pair<u256, std::vector<u256>> selectCase(CFG const& _cfg, u256 const& _switchValue)
+{
+	std::map<StackSlot, u256> values;
+	auto valueOf = [&](StackSlot const& _slot) {
+		if (auto const* literal = std::get_if<LiteralSlot>(&_slot))
+			return literal->value;
+		return values.at(_slot);
+	};
+	std::vector<u256> pivots;
+	CFG::BasicBlock const* block = _cfg.entry;
+	while (true)
+	{
+		for (CFG::Operation const& operation: block->operations)
+			if (auto const* assignment = std::get_if<CFG::Assignment>(&operation.operation))
+				for (size_t index = 0; index < assignment->variables.size(); ++index)
+					values[assignment->variables[index]] = valueOf(operation.input.at(index));
+			else
+			{
+				std::string const& name = std::get<CFG::BuiltinCall>(operation.operation).builtin.get().name;
+				// The first argument is at the top of the stack.
+				std::vector<u256> arguments;
+				for (StackSlot const& slot: operation.input | ranges::views::reverse)
+					arguments.emplace_back(valueOf(slot));
+				if (name == "sstore")
+					return {arguments.front(), pivots};
+				if (name == "lt")
+					pivots.emplace_back(arguments.back());
+				values[operation.output.front()] = evaluate(name, arguments, _switchValue);
+			}
+		if (auto const* jump = std::get_if<CFG::BasicBlock::Jump>(&block->exit))
+			block = jump->target;
+		else
+		{
+			auto const& conditionalJump = std::get<CFG::BasicBlock::ConditionalJump>(block->exit);
+			block = valueOf(conditionalJump.condition) != 0 ? conditionalJump.nonZero : conditionalJump.zero;
+		}
+	}
+}
+
+/// Follows the control flow of the main graph of @a _controlFlow like the overload above.
+std::pair<u256, std::vector<u256>> selectCase(ControlFlow const& _controlFlow, u256 const& _switchValue)
+{
+	SSACFG const& cfg = *_controlFlow.mainGraph;
+	std::map<SSACFG::ValueId, u256> values;
+	auto valueOf = [&](SSACFG::ValueId _value) {
+		if (auto const* literal = std::get_if<SSACFG::LiteralValue>(&cfg.valueInfo(_value)))
+			return literal->value;
+		return values.at(_value);
+	};
+	std::vector<u256> pivots;
+	SSACFG::BlockId block = cfg.entry;
+	while (true)
+	{
+		for (SSACFG::Operation const& operation: cfg.block(block).operations)
+		{
+			std::string const& name = std::get<SSACFG::BuiltinCall>(operation.kind).builtin.get().name;
+			// The inputs are in reverse order of the arguments.
+			std::vector<u256> arguments;
+			for (SSACFG::ValueId input: operation.inputs | ranges::views::reverse)
+				arguments.emplace_back(valueOf(input));
+			if (name == "sstore")
+				return {arguments.front(), pivots};
+			if (name == "lt")
+				pivots.emplace_back(arguments.back());
+			values[operation.outputs.front()] = evaluate(name, arguments, _switchValue);
+		}
+		if (auto const* jump = std::get_if<SSACFG::BasicBlock::Jump>(&cfg.block(block).exit))
+			block = jump->target;
+		else
+		{
+			auto const& conditionalJump = std::get<SSACFG::BasicBlock::ConditionalJump>(cfg.block(block).exit);
+			block = valueOf(conditionalJump.condition) != 0 ? conditionalJump.nonZero : conditionalJump.zero;
+		}
+	}
+}
+
+/// Checks that both control flow graph builders select the right case of the switch with the
+/// values @a _values for all values from zero to one above the largest and compare against the same
+/// values using ``lt`` on the way. @returns these values indexed by the value of the switch expression.
+std::vector<std::vector<u256>> checkSwitch(
+	std::vector<unsigned> const& _values,
+	std::optional<unsigned> _defaultKey,
+	std::optional<size_t> _expectedExecutionsPerDeployment
+)
+{
+	YulStack yulStack = parseYul(switchSource(_values, _defaultKey));
+	soltestAssert(!yulStack.hasErrorsWarningsOrInfos());
+	Object const& object = *yulStack.parserResult();
+	std::unique_ptr<CFG> cfg = ControlFlowGraphBuilder::build(
+		*object.analysisInfo,
+		yulStack.dialect(),
+		object.code()->root(),
+		_expectedExecutionsPerDeployment
+	);
+	std::unique_ptr<ControlFlow> controlFlow = SSAControlFlowGraphBuilder::build(
+		*object.analysisInfo,
+		yulStack.dialect(),
+		object.code()->root(),
+		_expectedExecutionsPerDeployment
+	);
+
+	std::vector<std::vector<u256>> pivotsByValue;
+	unsigned const maxValue = *std::max_element(_values.begin(), _values.end());
+	for (unsigned switchValue = 0; switchValue <= maxValue + 1; ++switchValue)
+	{
+		u256 expectedKey = _defaultKey ? u256(*_defaultKey) : afterSwitch;
+		if (std::find(_values.begin(), _values.end(), switchValue) != _values.end())
+			expectedKey = switchValue;
+		auto [key, pivots] = selectCase(*cfg, switchValue);
+		BOOST_CHECK_EQUAL(key, expectedKey);
+		auto [ssaKey, ssaPivots] = selectCase(*controlFlow, switchValue);
+		BOOST_CHECK_EQUAL(ssaKey, expectedKey);
+		BOOST_CHECK(pivots == ssaPivots);
+		pivotsByValue.emplace_back(std::move(pivots));
+	}
+	return pivotsByValue;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(SwitchLowering)
+
+BOOST_AUTO_TEST_CASE(cost_model)
+{
+	// Never split few cases, nor creation code without enough cases to make up for the code size.
+	BOOST_CHECK(!splitSwitchCases(4, std::numeric_limits<size_t>::max()));
+	BOOST_CHECK(!splitSwitchCases(7, std::nullopt));
+	BOOST_CHECK(splitSwitchCases(1000, std::nullopt));
+	// The default number of runs splits starting at seven cases.
+	BOOST_CHECK(!splitSwitchCases(6, 200));
+	BOOST_CHECK(splitSwitchCases(7, 200));
+	BOOST_CHECK(splitSwitchCases(5, std::numeric_limits<size_t>::max()));
+}
+
+BOOST_AUTO_TEST_CASE(sequential_comparisons)
+{
+	for (auto const& pivots: checkSwitch({3, 1, 2}, std::nullopt, 200))
+		BOOST_CHECK(pivots.empty());
+	for (auto const& pivots: checkSwitch({70, 10, 40, 20, 60, 30, 50}, 4, std::nullopt))
+		BOOST_CHECK(pivots.empty());
+}
+
+BOOST_AUTO_TEST_CASE(pivot_is_median_of_sorted_values)
+{
+	// Seven cases are split once at the fourth of the sorted values, the halves are compared
+	// one after the other.
+	for (auto const& pivots: checkSwitch({70, 10, 40, 20, 60, 30, 50}, std::nullopt, 200))
+		BOOST_CHECK(pivots == std::vector<u256>{40});
+	// With an even number of cases, the upper half starts at the middle value.
+	for (auto const& pivots: checkSwitch({80, 10, 40, 20, 60, 30, 50, 70}, std::nullopt, 200))
+		BOOST_CHECK(pivots == std::vector<u256>{50});
+}
+
+BOOST_AUTO_TEST_CASE(odd_number_of_cases)
+{
+	// Nine cases are split into four and five cases. Only the upper five cases are split again
+	// if every split pays off.
+	auto pivotsByValue = checkSwitch({9, 1, 8, 2, 7, 3, 6, 4, 5}, std::nullopt, std::numeric_limits<size_t>::max());
+	for (unsigned value = 0; value < pivotsByValue.size(); ++value)
+		if (value < 5)
+			BOOST_CHECK(pivotsByValue[value] == std::vector<u256>{5});
+		else
+			BOOST_CHECK((pivotsByValue[value] == std::vector<u256>{5, 7}));
+}
+
+BOOST_AUTO_TEST_CASE(default_case)
+{
+	for (auto const& pivots: checkSwitch({1, 3, 5, 7, 9, 11, 13}, 999, 200))
+		BOOST_CHECK(pivots == std::vector<u256>{7});
+	auto pivotsByValue = checkSwitch({1, 3, 5, 7, 9, 11, 13, 15, 17}, 999, std::numeric_limits<size_t>::max());
+	for (unsigned value = 0; value < pivotsByValue.size(); ++value)
+		if (value < 9)
+			BOOST_CHECK(pivotsByValue[value] == std::vector<u256>{9});
+		else
+			BOOST_CHECK((pivotsByValue[value] == std::vector<u256>{9, 13}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -20,6 +20,7 @@
 
 #include <test/libyul/Common.h>
 
+#include <test/tools/yulInterpreter/CompiledInterpreter.h>
 #include <test/tools/yulInterpreter/Interpreter.h>
 
 #include <test/Common.h>
@@ -31,6 +32,8 @@
 #include <liblangutil/DebugInfoSelection.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <libsolutil/AnsiColorized.h>
+
 #include <boost/test/unit_test.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -63,12 +66,21 @@ TestCase::TestResult YulInterpreterTest::run(std::ostream& _stream, std::string
 		return TestResult::FatalError;
 	}
 
-	m_obtainedResult = interpret(yulStack.parserResult());
+	m_obtainedResult = interpret(yulStack.parserResult(), /*_compiled=*/ false);
+
+	std::string const compiledResult = interpret(yulStack.parserResult(), /*_compiled=*/ true);
+	if (compiledResult != m_obtainedResult)
+	{
+		AnsiColorized(_stream, _formatted, {formatting::BOLD, formatting::RED}) <<
+			_linePrefix << "Compiled interpreter produced a different result:" << std::endl;
+		printPrefixed(_stream, compiledResult, _linePrefix + "  ");
+		return TestResult::FatalError;
+	}
 
 	return checkResult(_stream, _linePrefix, _formatted);
 }
 
-std::string YulInterpreterTest::interpret(std::shared_ptr<Object const> const& _object)
+std::string YulInterpreterTest::interpret(std::shared_ptr<Object const> const& _object, bool _compiled)
 {
 	solAssert(_object && _object->hasCode());
 
@@ -78,7 +90,7 @@ std::string YulInterpreterTest::interpret(std::shared_ptr<Object const> const& _
 	state.maxExprNesting = 64;
 	try
 	{
-		Interpreter::run(
+		(_compiled ? CompiledInterpreter::run : Interpreter::run)(
 			state,
 			*_object->dialect(),
 			_object->code()->root(),
@@ -41,7 +41,8 @@ public:
 	TestResult run(std::ostream& _stream, std::string const& _linePrefix = "", bool const _formatted = false) override;
 
 private:
-	std::string interpret(std::shared_ptr<Object const> const& _object);
+	/// Runs the code of @a _object with the AST-walking or, if @a _compiled is set, with the compiled interpreter.
+	std::string interpret(std::shared_ptr<Object const> const& _object, bool _compiled);
 
 	bool m_simulateExternalCallsToSelf = false;
 };
@@ -57,6 +57,7 @@
 #include <libyul/optimiser/UnusedStoreEliminator.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/StackCompressor.h>
+#include <libyul/optimiser/StorageUpdateCombiner.h>
 #include <libyul/optimiser/Suite.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/backends/evm/EVMDialect.h>
@@ -326,6 +327,14 @@ YulOptimizerTestCommon::YulOptimizerTestCommon(std::shared_ptr<Object const> _ob
 			EqualStoreEliminator::run(*m_context, block);
 			return block;
 		}},
+		{"storageUpdateCombiner", [&]() {
+			auto block = disambiguate();
+			updateContext(block);
+			FunctionHoister::run(*m_context, block);
+			ForLoopInitRewriter::run(*m_context, block);
+			StorageUpdateCombiner::run(*m_context, block);
+			return block;
+		}},
 		{"ssaPlusCleanup", [&]() {
 			auto block = disambiguate();
 			updateContext(block);
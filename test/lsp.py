@@ -990,16 +990,21 @@ class SolidityLSPTestSuite: # {{{
         self.expect_equal(message['method'], method_name, description="Ensure expected method name")
         return message['params']
 
-    def wait_for_diagnostics(self, solc: JsonRpcProcess) -> List[dict]:
+    def wait_for_diagnostics(self, solc: JsonRpcProcess, received: Optional[List[dict]] = None) -> List[dict]:
         """
         Return all published diagnostic reports sorted by file URI.
+        Messages in `received` that were already read from the server are consumed first.
         """
         reports = []
+        pending = list(received) if received is not None else []
 
-        num_files = solc.receive_message()["params"]["openFileCount"]
+        def next_message():
+            return pending.pop(0) if len(pending) > 0 else solc.receive_message()
+
+        num_files = next_message()["params"]["openFileCount"]
 
         for _ in range(0, num_files):
-            message = solc.receive_message()
+            message = next_message()
 
             assert message is not None # This can happen if the server aborts early.
 
@@ -1012,6 +1017,25 @@ class SolidityLSPTestSuite: # {{{
 
         return sorted(reports, key=lambda x: x['uri'])
 
+    def call_method_collecting_notifications(
+        self,
+        solc: JsonRpcProcess,
+        method_name: str,
+        params: Optional[dict]
+    ) -> Tuple[dict, List[dict]]:
+        """
+        Calls the given method and returns its response together with all notifications received
+        before it, e.g. the diagnostics of a compilation running in the background.
+        """
+        solc.send_message(method_name, params)
+        notifications = []
+        while True:
+            message = solc.receive_message()
+            assert message is not None # This can happen if the server aborts early.
+            if 'method' not in message:
+                return message, notifications
+            notifications.append(message)
+
     def normalizeUri(self, uri):
         return uri.replace(self.project_root_uri + "/", "")[:-len(".sol")]
 
@@ -2051,6 +2075,290 @@ class SolidityLSPTestSuite: # {{{
             "diagnostic: check range"
         )
 
+    def test_textDocument_definition_and_hover_while_compilation_pending(self, solc: JsonRpcProcess) -> None:
+        """
+        Requests right after a change are answered from the previous analysis,
+        since the compilation of the change is delayed.
+        """
+        self.setup_lsp(solc)
+        FILE_URI = 'file:///pending.sol'
+        lines = [
+            '// SPDX-License-Identifier: UNLICENSED\n',
+            'pragma solidity >=0.8.0;\n',
+            'contract C {\n',
+            '    function f() public pure returns (uint) { return g(); }\n',
+            '    function g() internal pure returns (uint) { return 1; }\n',
+            '}\n',
+        ]
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': FILE_URI,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': ''.join(lines)
+            }
+        })
+        self.expect_empty_diagnostics(self.wait_for_diagnostics(solc))
+
+        call_column = lines[3].index('g()')
+        definition_columns = (lines[4].index('g()'), lines[4].index('g()') + 1)
+
+        # Insert a line above both functions.
+        solc.send_message('textDocument/didChange', {
+            'textDocument': { 'uri': FILE_URI },
+            'contentChanges': [
+                {
+                    'range': {
+                        'start': { 'line': 3, 'character': 0 },
+                        'end': { 'line': 3, 'character': 0 }
+                    },
+                    'text': '    uint x;\n'
+                }
+            ]
+        })
+        notifications = []
+        response, received = self.call_method_collecting_notifications(solc, 'textDocument/definition', {
+            'textDocument': { 'uri': FILE_URI },
+            'position': { 'line': 3, 'character': call_column }
+        })
+        notifications += received
+        self.expect_equal(len(response['result']), 1, "definition from the previous analysis")
+        self.expect_location(response['result'][0], FILE_URI, 4, definition_columns)
+
+        response, received = self.call_method_collecting_notifications(solc, 'textDocument/hover', {
+            'textDocument': { 'uri': FILE_URI },
+            'position': { 'line': 3, 'character': call_column }
+        })
+        notifications += received
+        self.expect_equal(
+            response['result']['range'],
+            {
+                'start': { 'line': 3, 'character': call_column },
+                'end': { 'line': 3, 'character': call_column + 1 }
+            },
+            "hover from the previous analysis"
+        )
+
+        self.expect_empty_diagnostics(self.wait_for_diagnostics(solc, notifications))
+
+        # Once the change is compiled, the shifted positions are used.
+        response, received = self.call_method_collecting_notifications(solc, 'textDocument/definition', {
+            'textDocument': { 'uri': FILE_URI },
+            'position': { 'line': 4, 'character': call_column }
+        })
+        self.expect_equal(received, [], "no further notifications")
+        self.expect_equal(len(response['result']), 1, "definition from the new analysis")
+        self.expect_location(response['result'][0], FILE_URI, 5, definition_columns)
+
+    def test_textDocument_didChange_superseded_compilation(self, solc: JsonRpcProcess) -> None:
+        """
+        Changes in quick succession only publish the diagnostics of the final state.
+        """
+        self.setup_lsp(solc)
+        FILE_URI = 'file:///superseded.sol'
+        header = '// SPDX-License-Identifier: UNLICENSED\npragma solidity >=0.8.0;\n'
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': FILE_URI,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': header + 'contract C {}\n'
+            }
+        })
+        self.expect_empty_diagnostics(self.wait_for_diagnostics(solc))
+
+        for body in [
+            'contract C { function f() public pure { uint a = ; } }\n',
+            'contract C { function f() public pure { return 1; } }\n',
+            'contract C {\n    function f() public pure {\n        uint unused;\n    }\n}\n',
+        ]:
+            solc.send_message('textDocument/didChange', {
+                'textDocument': { 'uri': FILE_URI },
+                'contentChanges': [{ 'text': header + body }]
+            })
+
+        reports = self.wait_for_diagnostics(solc)
+        self.expect_equal(len(reports), 1, "one publish diagnostics notification")
+        self.expect_equal(len(reports[0]['diagnostics']), 1, "diagnostics of the final state only")
+        diagnostic = reports[0]['diagnostics'][0]
+        self.expect_equal(diagnostic['code'], 2072, "unused local variable")
+        self.expect_equal(diagnostic['range']['start']['line'], 4, "line of the unused variable")
+
+        # Nothing else is published for the earlier states.
+        response, notifications = self.call_method_collecting_notifications(solc, 'textDocument/semanticTokens/full', {
+            'textDocument': { 'uri': FILE_URI }
+        })
+        self.expect_equal(notifications, [], "no further notifications")
+        self.expect_true('result' in response, "semantic tokens of the final state")
+
+    def test_textDocument_rename_after_didChange(self, solc: JsonRpcProcess) -> None:
+        """
+        Renaming right after a change waits for the compilation of the changed sources.
+        """
+        self.setup_lsp(solc)
+        FILE_URI = 'file:///rename_after_change.sol'
+        lines = [
+            '// SPDX-License-Identifier: UNLICENSED\n',
+            'pragma solidity >=0.8.0;\n',
+            'contract C {\n',
+            '    function f(uint a) public pure returns (uint) { return a + 1; }\n',
+            '}\n',
+        ]
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': FILE_URI,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': ''.join(lines)
+            }
+        })
+        self.expect_empty_diagnostics(self.wait_for_diagnostics(solc))
+
+        solc.send_message('textDocument/didChange', {
+            'textDocument': { 'uri': FILE_URI },
+            'contentChanges': [
+                {
+                    'range': {
+                        'start': { 'line': 3, 'character': 0 },
+                        'end': { 'line': 3, 'character': 0 }
+                    },
+                    'text': '    uint constant K = 1;\n'
+                }
+            ]
+        })
+        parameter_column = lines[3].index('a)')
+        use_column = lines[3].index('a + 1')
+        response, notifications = self.call_method_collecting_notifications(solc, 'textDocument/rename', {
+            'textDocument': { 'uri': FILE_URI },
+            'position': { 'line': 4, 'character': parameter_column },
+            'newName': 'b'
+        })
+        self.expect_empty_diagnostics(self.wait_for_diagnostics(solc, notifications))
+
+        edits = sorted(response['result']['changes'][FILE_URI], key=lambda edit: edit['range']['start']['character'])
+        self.expect_equal(
+            edits,
+            [
+                {
+                    'newText': 'b',
+                    'range': {
+                        'start': { 'line': 4, 'character': column },
+                        'end': { 'line': 4, 'character': column + 1 }
+                    }
+                }
+                for column in [parameter_column, use_column]
+            ],
+            "rename in the changed sources"
+        )
+
+    def test_textDocument_semanticTokens_delta_and_range(self, solc: JsonRpcProcess) -> None:
+        """
+        Requests the semantic tokens of a file, changes it and checks that the delta, a delta
+        for an unknown result ID and a range starting in the middle of a line all agree with
+        the full tokens of the changed file.
+        """
+        TOKEN_SIZE = 5
+
+        def decode(data):
+            """Converts relative token positions into absolute ones."""
+            tokens = []
+            line = 0
+            column = 0
+            for i in range(0, len(data), TOKEN_SIZE):
+                column = column + data[i + 1] if data[i] == 0 else data[i + 1]
+                line += data[i]
+                tokens.append((line, column, *data[i + 2:i + TOKEN_SIZE]))
+            return tokens
+
+        def encode(tokens):
+            data = []
+            last_line = 0
+            last_column = 0
+            for line, column, *rest in tokens:
+                data += [line - last_line, column - last_column if line == last_line else column, *rest]
+                last_line = line
+                last_column = column
+            return data
+
+        self.setup_lsp(solc)
+        FILE_URI = 'file:///semantic_tokens.sol'
+        lines = [
+            '// SPDX-License-Identifier: UNLICENSED\n',
+            'pragma solidity >=0.8.0;\n',
+            'contract C {\n',
+            '    uint value; uint other;\n',
+            '    function f(uint a) public view returns (uint) { return a + value + other; }\n',
+            '}\n',
+        ]
+        solc.send_message('textDocument/didOpen', {
+            'textDocument': {
+                'uri': FILE_URI,
+                'languageId': 'Solidity',
+                'version': 1,
+                'text': ''.join(lines)
+            }
+        })
+        self.expect_empty_diagnostics(self.wait_for_diagnostics(solc))
+
+        response, _ = self.call_method_collecting_notifications(solc, 'textDocument/semanticTokens/full', {
+            'textDocument': { 'uri': FILE_URI }
+        })
+        previous = response['result']
+        self.expect_true('resultId' in previous, "full result has an ID")
+
+        solc.send_message('textDocument/didChange', {
+            'textDocument': { 'uri': FILE_URI },
+            'contentChanges': [
+                {
+                    'range': {
+                        'start': { 'line': 4, 'character': 0 },
+                        'end': { 'line': 4, 'character': 0 }
+                    },
+                    'text': '    uint inserted;\n'
+                }
+            ]
+        })
+        self.expect_empty_diagnostics(self.wait_for_diagnostics(solc))
+
+        response, _ = self.call_method_collecting_notifications(solc, 'textDocument/semanticTokens/full/delta', {
+            'textDocument': { 'uri': FILE_URI },
+            'previousResultId': previous['resultId']
+        })
+        delta = response['result']
+        self.expect_true('edits' in delta and 'data' not in delta, "delta contains edits")
+        self.expect_true(delta['resultId'] != previous['resultId'], "delta has a new result ID")
+        patched = list(previous['data'])
+        for edit in sorted(delta['edits'], key=lambda edit: edit['start'], reverse=True):
+            patched[edit['start']:edit['start'] + edit['deleteCount']] = edit.get('data', [])
+
+        response, _ = self.call_method_collecting_notifications(solc, 'textDocument/semanticTokens/full', {
+            'textDocument': { 'uri': FILE_URI }
+        })
+        current = response['result']
+        self.expect_equal(patched, current['data'], "delta applied to the previous result")
+
+        # The first result ID is no longer known, so the full result is sent instead of edits.
+        response, _ = self.call_method_collecting_notifications(solc, 'textDocument/semanticTokens/full/delta', {
+            'textDocument': { 'uri': FILE_URI },
+            'previousResultId': previous['resultId']
+        })
+        self.expect_true('edits' not in response['result'], "no edits for an unknown result ID")
+        self.expect_equal(response['result'].get('data'), current['data'], "full result for an unknown result ID")
+
+        # A range starting in the middle of a line, the position of its first token is absolute.
+        start = (3, lines[3].index('uint other'))
+        end = (5, 0)
+        response, _ = self.call_method_collecting_notifications(solc, 'textDocument/semanticTokens/range', {
+            'textDocument': { 'uri': FILE_URI },
+            'range': {
+                'start': { 'line': start[0], 'character': start[1] },
+                'end': { 'line': end[0], 'character': end[1] }
+            }
+        })
+        expected = [token for token in decode(current['data']) if start <= (token[0], token[1]) < end]
+        self.expect_true(len(expected) > 0 and expected[0][:2] == start, "range starts with a token")
+        self.expect_equal(response['result']['data'], encode(expected), "tokens in range")
+
     # }}}
     # }}}
 
@@ -130,7 +130,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 				"dir1/file1.sol:L=0x1234567890123456789012345678901234567890,"
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
 			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
-			"--ir", "--ir-ast-json", "--ir-optimized", "--ir-optimized-ast-json", "--hashes", "--userdoc", "--devdoc", "--metadata",
+			"--ir", "--ir-ast-json", "--ir-optimized", "--ir-optimized-ast-json", "--ir-optimized-binary", "--hashes", "--userdoc", "--devdoc", "--metadata",
 			"--yul-cfg-json",
 			"--storage-layout", "--transient-storage-layout",
 			"--gas",
@@ -194,7 +194,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true, true, true, true, true,
 			true, true, true, true, true,
 			true, true, true, true, true,
-			true, true, true,
+			true, true, true, true,
 		};
 		expectedOptions.compiler.estimateGas = true;
 		expectedOptions.compiler.combinedJsonRequests = {
@@ -417,6 +417,33 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	BOOST_TEST(parsedOptions == expectedOptions);
 }
 
+BOOST_AUTO_TEST_CASE(server_mode_options)
+{
+	std::vector<std::string> commandLine = {
+		"solc",
+		"--server",
+		"--base-path=/home/user/",
+		"--include-path=/usr/lib/include/",
+		"--allow-paths=/tmp,project",
+		"--server-memory-budget=64",
+	};
+
+	CommandLineOptions expectedOptions;
+
+	expectedOptions.input.mode = InputMode::Server;
+	expectedOptions.input.basePath = "/home/user/";
+	expectedOptions.input.includePaths = {"/usr/lib/include/"};
+	expectedOptions.input.allowedDirectories = {"/tmp", "project"};
+	expectedOptions.server.memoryBudget = 64 * 1024 * 1024;
+
+	CommandLineOptions parsedOptions = parseCommandLine(commandLine);
+
+	BOOST_TEST(parsedOptions == expectedOptions);
+
+	BOOST_CHECK_THROW(parseCommandLine({"solc", "--server", "input.json"}), CommandLineValidationError);
+	BOOST_CHECK_THROW(parseCommandLine({"solc", "input.sol", "--server-memory-budget=64"}), CommandLineValidationError);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 {
 	std::map<std::string, std::vector<std::string>> invalidOptionInputModeCombinations = {
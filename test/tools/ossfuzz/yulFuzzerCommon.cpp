@@ -52,7 +52,7 @@ yulFuzzerUtil::TerminationReason yulFuzzerUtil::interpret(
 	TerminationReason reason = TerminationReason::None;
 	try
 	{
-		Interpreter::run(state, _dialect, _astRoot, true, _disableMemoryTracing);
+		CompiledInterpreter::run(state, _dialect, _astRoot, true, _disableMemoryTracing);
 	}
 	catch (StepLimitReached const&)
 	{
@@ -0,0 +1,268 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Microbenchmark for matching Yul expressions against the simplification rules.
+ *
+ * Measures the time per expression of SimplificationRules::findFirstMatch, which uses
+ * the rule index, and of trying all rules for the root instruction one after the other,
+ * which is how rules were matched before. Also checks that both find the same replacements.
+ *
+ * Input is a Yul object or block, preferably optimized code, e.g. the output of
+ * solc --ir-optimized.
+ */
+
+#include <libyul/AST.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/Object.h>
+#include <libyul/ObjectParser.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/DataFlowAnalyzer.h>
+#include <libyul/optimiser/SimplificationRules.h>
+#include <libyul/optimiser/SSAValueTracker.h>
+
+#include <libevmasm/RuleList.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/ErrorReporter.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Expressions to match together with the SSA values available at the point they were found.
+struct Workload
+{
+	std::vector<Expression const*> expressions;
+	std::map<YulName, AssignedValue> ssaValues;
+	/// Kept alive since the values of zero-initialized variables are owned by the trackers.
+	std::vector<std::unique_ptr<SSAValueTracker>> trackers;
+};
+
+class WorkloadCollector: public ASTWalker
+{
+public:
+	explicit WorkloadCollector(Workload& _workload): m_workload(_workload) {}
+
+	using ASTWalker::visit;
+	void visit(Expression const& _expression) override
+	{
+		if (std::holds_alternative<FunctionCall>(_expression))
+			m_workload.expressions.push_back(&_expression);
+		ASTWalker::visit(_expression);
+	}
+
+	void collect(Block const& _block)
+	{
+		SSAValueTracker& tracker = *m_workload.trackers.emplace_back(std::make_unique<SSAValueTracker>());
+		tracker(_block);
+		for (auto const& [name, value]: tracker.values())
+			m_workload.ssaValues[name] = AssignedValue{value, 0};
+		(*this)(_block);
+	}
+
+private:
+	Workload& m_workload;
+};
+
+void collectWorkload(Object const& _object, Workload& _workload)
+{
+	if (_object.hasCode())
+		WorkloadCollector{_workload}.collect(_object.code()->root());
+	for (auto const& subNode: _object.subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			collectWorkload(*subObject, _workload);
+}
+
+/// Tries all rules for the root instruction in order, without the index.
+class LinearRules
+{
+public:
+	using Rule = SimplificationRules::Rule;
+
+	explicit LinearRules(EVMVersion _evmVersion)
+	{
+		Pattern A(PatternKind::Constant);
+		Pattern B(PatternKind::Constant);
+		Pattern C(PatternKind::Constant);
+		Pattern W;
+		Pattern X;
+		Pattern Y;
+		Pattern Z;
+		A.setMatchGroup(1, m_matchGroups);
+		B.setMatchGroup(2, m_matchGroups);
+		C.setMatchGroup(3, m_matchGroups);
+		W.setMatchGroup(4, m_matchGroups);
+		X.setMatchGroup(5, m_matchGroups);
+		Y.setMatchGroup(6, m_matchGroups);
+		Z.setMatchGroup(7, m_matchGroups);
+		for (Rule const& rule: evmasm::simplificationRuleList(_evmVersion, A, B, C, W, X, Y, Z))
+			m_rules[static_cast<uint8_t>(rule.pattern.instruction())].push_back(rule);
+	}
+	LinearRules(LinearRules const&) = delete;
+
+	Rule const* findFirstMatch(
+		Expression const& _expr,
+		Dialect const& _dialect,
+		std::function<AssignedValue const*(YulName)> const& _ssaValues
+	)
+	{
+		auto instruction = SimplificationRules::instructionAndArguments(_dialect, _expr);
+		if (!instruction)
+			return nullptr;
+		for (Rule const& rule: m_rules[static_cast<uint8_t>(instruction->first)])
+		{
+			m_matchGroups.clear();
+			if (rule.pattern.matches(_expr, _dialect, _ssaValues))
+				if (!rule.feasible || rule.feasible())
+					return &rule;
+		}
+		return nullptr;
+	}
+
+private:
+	std::map<unsigned, Expression const*> m_matchGroups;
+	std::vector<Rule> m_rules[256];
+};
+
+template <class FindFirstMatch>
+double nanosecondsPerExpression(Workload const& _workload, size_t _repetitions, FindFirstMatch&& _findFirstMatch)
+{
+	auto const start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < _repetitions; ++i)
+		for (Expression const* expression: _workload.expressions)
+			_findFirstMatch(*expression);
+	std::chrono::duration<double, std::nano> const duration = std::chrono::steady_clock::now() - start;
+	return duration.count() / static_cast<double>(_repetitions * std::max<size_t>(_workload.expressions.size(), 1));
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		size_t repetitions = 100;
+		po::options_description options(
+			R"(rulebench, microbenchmark for matching Yul expressions against simplification rules.
+Usage: rulebench [Options] < input
+Reads a Yul object or block from stdin or the given file and reports the time
+spent per expression with and without the rule index.
+
+Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23
+		);
+		options.add_options()
+			("input-file", po::value<std::string>(), "input file")
+			("repetitions", po::value<size_t>(&repetitions)->default_value(repetitions), "how often to match every expression")
+			("help", "Show this help screen.");
+		po::positional_options_description filesPositions;
+		filesPositions.add("input-file", 1);
+
+		po::variables_map arguments;
+		po::store(po::command_line_parser(argc, argv).options(options).positional(filesPositions).run(), arguments);
+		po::notify(arguments);
+		if (arguments.count("help"))
+		{
+			std::cout << options;
+			return 0;
+		}
+
+		std::string const input = arguments.count("input-file") ?
+			util::readFileAsString(arguments["input-file"].as<std::string>()) :
+			util::readUntilEnd(std::cin);
+
+		EVMVersion const evmVersion;
+		EVMDialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(evmVersion, std::nullopt);
+		ErrorList errors;
+		ErrorReporter errorReporter(errors);
+		CharStream charStream(input, "");
+		std::shared_ptr<Object> object = ObjectParser(errorReporter, dialect).parse(
+			std::make_shared<Scanner>(charStream),
+			false
+		);
+		if (!object || errorReporter.hasErrors())
+		{
+			std::cerr << "Could not parse the input." << std::endl;
+			return 1;
+		}
+
+		Workload workload;
+		collectWorkload(*object, workload);
+		auto ssaValues = [&](YulName _name) -> AssignedValue const* {
+			auto it = workload.ssaValues.find(_name);
+			return it == workload.ssaValues.end() ? nullptr : &it->second;
+		};
+
+		LinearRules linearRules(evmVersion);
+		size_t matches = 0;
+		for (Expression const* expression: workload.expressions)
+		{
+			std::string indexedReplacement;
+			if (auto const* rule = SimplificationRules::findFirstMatch(*expression, dialect, ssaValues))
+				indexedReplacement = std::visit(AsmPrinter(dialect), rule->action().toExpression({}, dialect));
+			std::string linearReplacement;
+			if (auto const* rule = linearRules.findFirstMatch(*expression, dialect, ssaValues))
+				linearReplacement = std::visit(AsmPrinter(dialect), rule->action().toExpression({}, dialect));
+			if (indexedReplacement != linearReplacement)
+			{
+				std::cerr << "Mismatch: \"" << indexedReplacement << "\" vs. \"" << linearReplacement << "\"" << std::endl;
+				return 1;
+			}
+			if (!indexedReplacement.empty())
+				++matches;
+		}
+
+		double const indexed = nanosecondsPerExpression(workload, repetitions, [&](Expression const& _expression) {
+			return SimplificationRules::findFirstMatch(_expression, dialect, ssaValues);
+		});
+		double const linear = nanosecondsPerExpression(workload, repetitions, [&](Expression const& _expression) {
+			return linearRules.findFirstMatch(_expression, dialect, ssaValues);
+		});
+
+		std::cout << "Expressions: " << workload.expressions.size() << " (" << matches << " matching a rule)" << std::endl;
+		std::cout << "Linear:  " << linear << " ns per expression" << std::endl;
+		std::cout << "Indexed: " << indexed << " ns per expression" << std::endl;
+		return 0;
+	}
+	catch (...)
+	{
+		std::cerr << "Uncaught exception:" << std::endl;
+		std::cerr << boost::current_exception_diagnostic_information() << std::endl;
+		return 2;
+	}
+}
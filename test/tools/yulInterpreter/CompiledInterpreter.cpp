@@ -0,0 +1,644 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Yul interpreter that executes precompiled code.
+ */
+
+#include <test/tools/yulInterpreter/CompiledInterpreter.h>
+
+#include <test/tools/yulInterpreter/EVMInstructionInterpreter.h>
+
+#include <libyul/AST.h>
+#include <libyul/Dialect.h>
+#include <libyul/Utilities.h>
+#include <libyul/backends/evm/EVMDialect.h>
+
+#include <libevmasm/Instruction.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <deque>
+#include <functional>
+#include <optional>
+#include <variant>
+
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::yul::test;
+
+namespace
+{
+
+/// Values of the variables of a function call, indexed by the slots assigned during compilation.
+using Frame = std::vector<u256>;
+
+class Program;
+
+/// State shared by all code executed as part of a single contract invocation.
+struct Runtime
+{
+	Program const& program;
+	InterpreterState& state;
+	EVMInstructionInterpreter instructions;
+
+	/// Counts a statement, throwing if the step limit is reached.
+	void incrementStep();
+	/// Simulates an external call to the same contract, with the evaluated
+	/// arguments of the call instruction in @a _arguments.
+	void externalCall(evmasm::Instruction _instruction, std::vector<u256> const& _arguments);
+};
+
+/// Evaluation of a single expression that is not nested in another expression.
+struct Evaluation
+{
+	Runtime& runtime;
+	Frame& frame;
+	/// Number of sub-expressions evaluated so far.
+	unsigned nestingLevel = 0;
+
+	/// Counts a sub-expression, throwing if the expression nesting limit is reached.
+	void incrementStep();
+};
+
+using ExpressionCode = std::function<u256(Evaluation&)>;
+using MultiExpressionCode = std::function<std::vector<u256>(Evaluation&)>;
+using StatementCode = std::function<void(Runtime&, Frame&)>;
+
+struct BlockCode
+{
+	std::vector<StatementCode> statements;
+
+	void operator()(Runtime& _runtime, Frame& _frame) const
+	{
+		for (auto const& statement: statements)
+		{
+			_runtime.incrementStep();
+			statement(_runtime, _frame);
+			if (_runtime.state.controlFlowState != ControlFlowState::Default)
+				break;
+		}
+	}
+};
+
+struct CompiledFunction
+{
+	size_t numSlots = 0;
+	std::vector<size_t> parameterSlots;
+	std::vector<size_t> returnSlots;
+	BlockCode body;
+
+	std::vector<u256> call(Runtime& _runtime, std::vector<u256> const& _arguments) const
+	{
+		yulAssert(_arguments.size() == parameterSlots.size());
+		Frame frame(numSlots, 0);
+		for (size_t i = 0; i < _arguments.size(); ++i)
+			frame[parameterSlots[i]] = _arguments[i];
+
+		_runtime.state.controlFlowState = ControlFlowState::Default;
+		body(_runtime, frame);
+		_runtime.state.controlFlowState = ControlFlowState::Default;
+
+		std::vector<u256> returnValues;
+		returnValues.reserve(returnSlots.size());
+		for (size_t slot: returnSlots)
+			returnValues.emplace_back(frame[slot]);
+		return returnValues;
+	}
+};
+
+/**
+ * Compiled form of a Yul AST. The top-level block is compiled like the body of a function
+ * without parameters.
+ */
+class Program
+{
+public:
+	Program(Dialect const& _dialect, Block const& _ast, bool _disableExternalCalls, bool _disableMemoryTracing);
+
+	/// Executes the top-level block on @a _state.
+	void execute(InterpreterState& _state) const
+	{
+		Runtime runtime{
+			*this,
+			_state,
+			EVMInstructionInterpreter(m_evmVersion, _state, m_disableMemoryTracing)
+		};
+		Frame frame(m_main.numSlots, 0);
+		m_main.body(runtime, frame);
+	}
+
+private:
+	BlockCode compileBlock(Block const& _block);
+	void compileFunction(FunctionDefinition const& _definition, CompiledFunction& _function);
+
+	StatementCode compileStatement(Statement const& _statement);
+	StatementCode compile(ExpressionStatement const& _statement);
+	StatementCode compile(Assignment const& _assignment);
+	StatementCode compile(VariableDeclaration const& _declaration);
+	StatementCode compile(If const& _if);
+	StatementCode compile(Switch const& _switch);
+	StatementCode compile(FunctionDefinition const& _definition);
+	StatementCode compile(ForLoop const& _forLoop);
+	StatementCode compile(Break const&);
+	StatementCode compile(Continue const&);
+	StatementCode compile(Leave const&);
+	StatementCode compile(Block const& _block);
+
+	/// Compiles an expression that evaluates to exactly one value.
+	ExpressionCode compileExpression(Expression const& _expression);
+	/// Compiles an expression that evaluates to any number of values.
+	MultiExpressionCode compileMultiExpression(Expression const& _expression);
+	ExpressionCode compileBuiltinCall(FunctionCall const& _call, BuiltinFunctionForEVM const& _builtin);
+	MultiExpressionCode compileFunctionCall(FunctionCall const& _call);
+	std::vector<ExpressionCode> compileArguments(
+		std::vector<Expression> const& _arguments,
+		std::vector<std::optional<LiteralKind>> const* _literalArguments
+	);
+
+	/// Assigns a new slot in the frame of the current function to the variable @a _name.
+	size_t declareVariable(YulName _name);
+	size_t variableSlot(YulName _name) const;
+	CompiledFunction const& function(YulName _name) const;
+
+	EVMDialect const* m_evmDialect = nullptr;
+	langutil::EVMVersion m_evmVersion;
+	bool m_disableExternalCalls = false;
+	bool m_disableMemoryTracing = false;
+
+	CompiledFunction m_main;
+	/// All compiled functions. A deque, so that references to them stay valid.
+	std::deque<CompiledFunction> m_functions;
+
+	/// Compilation state.
+	/// @{
+	/// Functions visible in the current block, by block nesting level.
+	std::vector<std::map<YulName, CompiledFunction const*>> m_functionScopes;
+	/// Slots of the variables visible in the current block, by block nesting level
+	/// inside the current function.
+	std::vector<std::map<YulName, size_t>> m_variableScopes;
+	CompiledFunction* m_currentFunction = nullptr;
+	/// @}
+};
+
+Program::Program(
+	Dialect const& _dialect,
+	Block const& _ast,
+	bool _disableExternalCalls,
+	bool _disableMemoryTracing
+):
+	m_evmDialect(dynamic_cast<EVMDialect const*>(&_dialect)),
+	m_disableExternalCalls(_disableExternalCalls),
+	m_disableMemoryTracing(_disableMemoryTracing)
+{
+	if (m_evmDialect)
+		m_evmVersion = m_evmDialect->evmVersion();
+	m_currentFunction = &m_main;
+	m_variableScopes.emplace_back();
+	m_main.body = compileBlock(_ast);
+	m_variableScopes.clear();
+	m_currentFunction = nullptr;
+}
+
+BlockCode Program::compileBlock(Block const& _block)
+{
+	m_functionScopes.emplace_back();
+	m_variableScopes.emplace_back();
+
+	// Functions are visible in the whole block, so register them before compiling any code.
+	std::vector<std::pair<FunctionDefinition const*, CompiledFunction*>> functions;
+	for (auto const& statement: _block.statements)
+		if (auto const* definition = std::get_if<FunctionDefinition>(&statement))
+		{
+			CompiledFunction& compiledFunction = m_functions.emplace_back();
+			m_functionScopes.back().emplace(definition->name, &compiledFunction);
+			functions.emplace_back(definition, &compiledFunction);
+		}
+	for (auto const& [definition, compiledFunction]: functions)
+		compileFunction(*definition, *compiledFunction);
+
+	BlockCode code;
+	code.statements.reserve(_block.statements.size());
+	for (auto const& statement: _block.statements)
+		code.statements.emplace_back(compileStatement(statement));
+
+	m_variableScopes.pop_back();
+	m_functionScopes.pop_back();
+	return code;
+}
+
+void Program::compileFunction(FunctionDefinition const& _definition, CompiledFunction& _function)
+{
+	// Functions cannot access variables of enclosing functions.
+	std::vector<std::map<YulName, size_t>> outerVariableScopes = std::move(m_variableScopes);
+	CompiledFunction* outerFunction = m_currentFunction;
+	m_variableScopes = {{}};
+	m_currentFunction = &_function;
+
+	for (auto const& parameter: _definition.parameters)
+		_function.parameterSlots.emplace_back(declareVariable(parameter.name));
+	for (auto const& returnVariable: _definition.returnVariables)
+		_function.returnSlots.emplace_back(declareVariable(returnVariable.name));
+	_function.body = compileBlock(_definition.body);
+
+	m_variableScopes = std::move(outerVariableScopes);
+	m_currentFunction = outerFunction;
+}
+
+StatementCode Program::compileStatement(Statement const& _statement)
+{
+	return std::visit([&](auto const& _concreteStatement) { return compile(_concreteStatement); }, _statement);
+}
+
+StatementCode Program::compile(ExpressionStatement const& _statement)
+{
+	return [expression = compileMultiExpression(_statement.expression)](Runtime& _runtime, Frame& _frame) {
+		Evaluation evaluation{_runtime, _frame};
+		expression(evaluation);
+	};
+}
+
+StatementCode Program::compile(Assignment const& _assignment)
+{
+	yulAssert(_assignment.value);
+	std::vector<size_t> slots;
+	for (auto const& variable: _assignment.variableNames)
+		slots.emplace_back(variableSlot(variable.name));
+	return [value = compileMultiExpression(*_assignment.value), slots](Runtime& _runtime, Frame& _frame) {
+		Evaluation evaluation{_runtime, _frame};
+		std::vector<u256> values = value(evaluation);
+		yulAssert(values.size() == slots.size());
+		for (size_t i = 0; i < values.size(); ++i)
+			_frame[slots[i]] = values[i];
+	};
+}
+
+StatementCode Program::compile(VariableDeclaration const& _declaration)
+{
+	// The value cannot refer to the declared variables, so it is compiled before declaring them.
+	std::optional<MultiExpressionCode> value;
+	if (_declaration.value)
+		value = compileMultiExpression(*_declaration.value);
+	std::vector<size_t> slots;
+	for (auto const& variable: _declaration.variables)
+		slots.emplace_back(declareVariable(variable.name));
+	return [value = std::move(value), slots](Runtime& _runtime, Frame& _frame) {
+		if (!value)
+		{
+			// Slots are not reset when a block is re-entered, e.g. in a loop.
+			for (size_t slot: slots)
+				_frame[slot] = 0;
+			return;
+		}
+		Evaluation evaluation{_runtime, _frame};
+		std::vector<u256> values = (*value)(evaluation);
+		yulAssert(values.size() == slots.size());
+		for (size_t i = 0; i < values.size(); ++i)
+			_frame[slots[i]] = values[i];
+	};
+}
+
+StatementCode Program::compile(If const& _if)
+{
+	yulAssert(_if.condition);
+	return [condition = compileExpression(*_if.condition), body = compileBlock(_if.body)](Runtime& _runtime, Frame& _frame) {
+		Evaluation evaluation{_runtime, _frame};
+		if (condition(evaluation) != 0)
+			body(_runtime, _frame);
+	};
+}
+
+StatementCode Program::compile(Switch const& _switch)
+{
+	yulAssert(_switch.expression);
+	yulAssert(!_switch.cases.empty());
+	std::vector<std::pair<std::optional<u256>, BlockCode>> cases;
+	for (auto const& switchCase: _switch.cases)
+		cases.emplace_back(
+			switchCase.value ? std::make_optional(switchCase.value->value.value()) : std::nullopt,
+			compileBlock(switchCase.body)
+		);
+	return [expression = compileExpression(*_switch.expression), cases = std::move(cases)](Runtime& _runtime, Frame& _frame) {
+		Evaluation evaluation{_runtime, _frame};
+		u256 const value = expression(evaluation);
+		for (auto const& [caseValue, body]: cases)
+			// Default case has to be last.
+			if (!caseValue || *caseValue == value)
+			{
+				body(_runtime, _frame);
+				break;
+			}
+	};
+}
+
+StatementCode Program::compile(FunctionDefinition const&)
+{
+	// Compiled together with the enclosing block.
+	return [](Runtime&, Frame&) {};
+}
+
+StatementCode Program::compile(ForLoop const& _forLoop)
+{
+	yulAssert(_forLoop.condition);
+
+	// Variables declared in the pre block are visible in the rest of the loop.
+	m_variableScopes.emplace_back();
+	std::vector<StatementCode> pre;
+	for (auto const& statement: _forLoop.pre.statements)
+		pre.emplace_back(compileStatement(statement));
+	ExpressionCode condition = compileExpression(*_forLoop.condition);
+	BlockCode body = compileBlock(_forLoop.body);
+	BlockCode post = compileBlock(_forLoop.post);
+	m_variableScopes.pop_back();
+
+	bool const emptyLoop = _forLoop.body.statements.empty() && _forLoop.post.statements.empty();
+	return [pre = std::move(pre), condition = std::move(condition), body = std::move(body), post = std::move(post), emptyLoop](
+		Runtime& _runtime,
+		Frame& _frame
+	) {
+		ControlFlowState& controlFlowState = _runtime.state.controlFlowState;
+		for (auto const& statement: pre)
+		{
+			statement(_runtime, _frame);
+			if (controlFlowState == ControlFlowState::Leave)
+				return;
+		}
+		while (true)
+		{
+			Evaluation evaluation{_runtime, _frame};
+			if (condition(evaluation) == 0)
+				break;
+
+			// Increment step for each loop iteration for loops with
+			// an empty body and post blocks to prevent a deadlock.
+			if (emptyLoop)
+				_runtime.incrementStep();
+
+			controlFlowState = ControlFlowState::Default;
+			body(_runtime, _frame);
+			if (controlFlowState == ControlFlowState::Break || controlFlowState == ControlFlowState::Leave)
+				break;
+
+			controlFlowState = ControlFlowState::Default;
+			post(_runtime, _frame);
+			if (controlFlowState == ControlFlowState::Leave)
+				break;
+		}
+		if (controlFlowState != ControlFlowState::Leave)
+			controlFlowState = ControlFlowState::Default;
+	};
+}
+
+StatementCode Program::compile(Break const&)
+{
+	return [](Runtime& _runtime, Frame&) { _runtime.state.controlFlowState = ControlFlowState::Break; };
+}
+
+StatementCode Program::compile(Continue const&)
+{
+	return [](Runtime& _runtime, Frame&) { _runtime.state.controlFlowState = ControlFlowState::Continue; };
+}
+
+StatementCode Program::compile(Leave const&)
+{
+	return [](Runtime& _runtime, Frame&) { _runtime.state.controlFlowState = ControlFlowState::Leave; };
+}
+
+StatementCode Program::compile(Block const& _block)
+{
+	return [block = compileBlock(_block)](Runtime& _runtime, Frame& _frame) { block(_runtime, _frame); };
+}
+
+ExpressionCode Program::compileExpression(Expression const& _expression)
+{
+	if (auto const* literal = std::get_if<Literal>(&_expression))
+		return [value = literal->value.value()](Evaluation& _evaluation) {
+			_evaluation.incrementStep();
+			return value;
+		};
+	else if (auto const* identifier = std::get_if<Identifier>(&_expression))
+		return [slot = variableSlot(identifier->name)](Evaluation& _evaluation) {
+			_evaluation.incrementStep();
+			return _evaluation.frame[slot];
+		};
+
+	FunctionCall const& call = std::get<FunctionCall>(_expression);
+	if (m_evmDialect)
+		if (BuiltinFunctionForEVM const* builtin = resolveBuiltinFunctionForEVM(call.functionName, *m_evmDialect))
+			return compileBuiltinCall(call, *builtin);
+	return [call = compileFunctionCall(call)](Evaluation& _evaluation) {
+		std::vector<u256> values = call(_evaluation);
+		yulAssert(values.size() == 1);
+		return values.front();
+	};
+}
+
+MultiExpressionCode Program::compileMultiExpression(Expression const& _expression)
+{
+	if (auto const* call = std::get_if<FunctionCall>(&_expression))
+		if (!m_evmDialect || !resolveBuiltinFunctionForEVM(call->functionName, *m_evmDialect))
+			return compileFunctionCall(*call);
+	return [expression = compileExpression(_expression)](Evaluation& _evaluation) {
+		return std::vector<u256>{expression(_evaluation)};
+	};
+}
+
+std::vector<ExpressionCode> Program::compileArguments(
+	std::vector<Expression> const& _arguments,
+	std::vector<std::optional<LiteralKind>> const* _literalArguments
+)
+{
+	std::vector<ExpressionCode> arguments;
+	for (size_t i = 0; i < _arguments.size(); ++i)
+		if (!_literalArguments || !_literalArguments->at(i))
+			arguments.emplace_back(compileExpression(_arguments[i]));
+		else
+		{
+			// Literal arguments are not evaluated and thus do not count towards the nesting level.
+			Literal const& literal = std::get<Literal>(_arguments[i]);
+			u256 value;
+			if (literal.value.unlimited())
+			{
+				yulAssert(literal.kind == LiteralKind::String);
+				value = 0xdeadbeef;
+			}
+			else
+				value = literal.value.value();
+			arguments.emplace_back([value](Evaluation&) { return value; });
+		}
+	return arguments;
+}
+
+/// Evaluates the arguments of a function call from right to left.
+std::vector<u256> evaluateArguments(Evaluation& _evaluation, std::vector<ExpressionCode> const& _arguments)
+{
+	_evaluation.incrementStep();
+	std::vector<u256> values(_arguments.size());
+	for (size_t i = _arguments.size(); i > 0; --i)
+		values[i - 1] = _arguments[i - 1](_evaluation);
+	return values;
+}
+
+ExpressionCode Program::compileBuiltinCall(FunctionCall const& _call, BuiltinFunctionForEVM const& _builtin)
+{
+	std::vector<ExpressionCode> arguments = compileArguments(
+		_call.arguments,
+		_builtin.literalArguments.empty() ? nullptr : &_builtin.literalArguments
+	);
+	bool const isExternalCall =
+		!m_disableExternalCalls &&
+		_builtin.instruction &&
+		evmasm::isCallInstruction(*_builtin.instruction);
+	return [&_call, &_builtin, arguments = std::move(arguments), isExternalCall](Evaluation& _evaluation) {
+		std::vector<u256> values = evaluateArguments(_evaluation, arguments);
+		u256 const value = _evaluation.runtime.instructions.evalBuiltin(_builtin, _call.arguments, values);
+		if (isExternalCall)
+			_evaluation.runtime.externalCall(*_builtin.instruction, values);
+		return value;
+	};
+}
+
+MultiExpressionCode Program::compileFunctionCall(FunctionCall const& _call)
+{
+	yulAssert(!isBuiltinFunctionCall(_call));
+	CompiledFunction const& target = function(std::get<Identifier>(_call.functionName).name);
+	return [&target, arguments = compileArguments(_call.arguments, nullptr)](Evaluation& _evaluation) {
+		std::vector<u256> values = evaluateArguments(_evaluation, arguments);
+		return target.call(_evaluation.runtime, values);
+	};
+}
+
+size_t Program::declareVariable(YulName _name)
+{
+	yulAssert(m_currentFunction && !m_variableScopes.empty());
+	size_t const slot = m_currentFunction->numSlots++;
+	m_variableScopes.back()[_name] = slot;
+	return slot;
+}
+
+size_t Program::variableSlot(YulName _name) const
+{
+	for (auto scope = m_variableScopes.rbegin(); scope != m_variableScopes.rend(); ++scope)
+		if (size_t const* slot = util::valueOrNullptr(*scope, _name))
+			return *slot;
+	yulAssert(false, "Variable not found.");
+	util::unreachable();
+}
+
+CompiledFunction const& Program::function(YulName _name) const
+{
+	for (auto scope = m_functionScopes.rbegin(); scope != m_functionScopes.rend(); ++scope)
+		if (CompiledFunction const* const* compiledFunction = util::valueOrNullptr(*scope, _name))
+			return **compiledFunction;
+	yulAssert(false, "Function not found.");
+	util::unreachable();
+}
+
+void Runtime::incrementStep()
+{
+	state.numSteps++;
+	if (state.maxSteps > 0 && state.numSteps >= state.maxSteps)
+	{
+		state.trace.emplace_back("Interpreter execution step limit reached.");
+		BOOST_THROW_EXCEPTION(StepLimitReached());
+	}
+}
+
+void Runtime::externalCall(evmasm::Instruction _instruction, std::vector<u256> const& _arguments)
+{
+	u256 memOutOffset = 0;
+	u256 memOutSize = 0;
+	u256 callvalue = 0;
+	u256 memInOffset = 0;
+	u256 memInSize = 0;
+
+	if (
+		_instruction == evmasm::Instruction::CALL ||
+		_instruction == evmasm::Instruction::CALLCODE
+	)
+	{
+		memOutOffset = _arguments[5];
+		memOutSize = _arguments[6];
+		callvalue = _arguments[2];
+		memInOffset = _arguments[3];
+		memInSize = _arguments[4];
+	}
+	else if (
+		_instruction == evmasm::Instruction::DELEGATECALL ||
+		_instruction == evmasm::Instruction::STATICCALL
+	)
+	{
+		memOutOffset = _arguments[4];
+		memOutSize = _arguments[5];
+		memInOffset = _arguments[2];
+		memInSize = _arguments[3];
+	}
+	else
+		yulAssert(false);
+
+	// Don't execute external call if it isn't our own address
+	if (_arguments[1] != util::h160::Arith(state.address))
+		return;
+
+	InterpreterState calleeState;
+	calleeState.calldata = state.readMemory(memInOffset, memInSize);
+	calleeState.callvalue = callvalue;
+	calleeState.numInstance = state.numInstance + 1;
+
+	yulAssert(calleeState.numInstance < 1024, "Detected more than 1024 recursive calls, aborting...");
+
+	try
+	{
+		program.execute(calleeState);
+	}
+	catch (ExplicitlyTerminatedWithReturn const&)
+	{
+		// Copy return data to our memory
+		copyZeroExtended(
+			state.memory,
+			calleeState.returndata,
+			memOutOffset.convert_to<size_t>(),
+			0,
+			memOutSize.convert_to<size_t>()
+		);
+		state.returndata = calleeState.returndata;
+	}
+}
+
+void Evaluation::incrementStep()
+{
+	nestingLevel++;
+	InterpreterState& state = runtime.state;
+	if (state.maxExprNesting > 0 && nestingLevel > state.maxExprNesting)
+	{
+		state.trace.emplace_back("Maximum expression nesting level reached.");
+		BOOST_THROW_EXCEPTION(ExpressionNestingLimitReached());
+	}
+}
+
+}
+
+void CompiledInterpreter::run(
+	InterpreterState& _state,
+	Dialect const& _dialect,
+	Block const& _ast,
+	bool _disableExternalCalls,
+	bool _disableMemoryTracing
+)
+{
+	Program{_dialect, _ast, _disableExternalCalls, _disableMemoryTracing}.execute(_state);
+}
@@ -0,0 +1,53 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Yul interpreter that executes precompiled code.
+ */
+
+#pragma once
+
+#include <test/tools/yulInterpreter/Interpreter.h>
+
+namespace solidity::yul::test
+{
+
+/**
+ * High-throughput variant of the Yul interpreter.
+ *
+ * Before execution, every function (and the top-level block) is translated into a tree of
+ * closures in which all variable references are resolved to slots of a flat per-call frame
+ * and all function calls are resolved to their (precompiled) target. Execution then no longer
+ * walks the AST, does not look up names and does not create an interpreter per function call.
+ *
+ * Produces exactly the same trace and final state as the AST-walking Interpreter,
+ * including the points at which the step, trace and expression nesting limits are hit.
+ */
+class CompiledInterpreter
+{
+public:
+	/// Executes @a _ast. See Interpreter::run for the meaning of the parameters.
+	static void run(
+		InterpreterState& _state,
+		Dialect const& _dialect,
+		Block const& _ast,
+		bool _disableExternalCalls,
+		bool _disableMemoryTracing
+	);
+};
+
+}
@@ -35,6 +35,7 @@
 #include <libsolutil/Numeric.h>
 #include <libsolutil/picosha2.h>
 
+#include <algorithm>
 #include <limits>
 
 using namespace solidity;
@@ -78,31 +79,33 @@ namespace solidity::yul::test
 {
 
 void copyZeroExtended(
-	std::map<u256, uint8_t>& _target,
+	PagedMemory& _target,
 	bytes const& _source,
 	size_t _targetOffset,
 	size_t _sourceOffset,
 	size_t _size
 )
 {
-	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = (_sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0);
+	bytes data(_size, uint8_t(0));
+	if (_sourceOffset < _source.size())
+		std::copy_n(
+			_source.begin() + static_cast<std::ptrdiff_t>(_sourceOffset),
+			std::min(_size, _source.size() - _sourceOffset),
+			data.begin()
+		);
+	_target.write(_targetOffset, data);
 }
 
 void copyZeroExtendedWithOverlap(
-	std::map<u256, uint8_t>& _target,
-	std::map<u256, uint8_t> const& _source,
+	PagedMemory& _target,
+	PagedMemory const& _source,
 	size_t _targetOffset,
 	size_t _sourceOffset,
 	size_t _size
 )
 {
-	if (_targetOffset >= _sourceOffset)
-		for (size_t i = _size; i > 0; --i)
-			_target[_targetOffset + i - 1] = (_source.count(_sourceOffset + i - 1) != 0 ? _source.at(_sourceOffset + i - 1) : 0);
-	else
-		for (size_t i = 0; i < _size; ++i)
-			_target[_targetOffset + i] = (_source.count(_sourceOffset + i) != 0 ? _source.at(_sourceOffset + i) : 0);
+	// Reading everything first makes overlapping areas behave like an intermediate buffer.
+	_target.write(_targetOffset, _source.read(_sourceOffset, _size));
 }
 
 }
@@ -577,10 +580,7 @@ bool EVMInstructionInterpreter::accessMemory(u256 const& _offset, u256 const& _s
 bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _size)
 {
 	yulAssert(_size <= s_maxRangeSize, "Too large read.");
-	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
-	return data;
+	return m_state.memory.read(_offset, size_t(_size));
 }
 
 u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
@@ -590,8 +590,8 @@ u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 
 void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	h256 const word(_value);
+	m_state.memory.write(_offset, word.data(), h256::size);
 }
 
 
@@ -45,11 +45,13 @@ struct BuiltinFunctionForEVM;
 namespace solidity::yul::test
 {
 
+class PagedMemory;
+
 /// Copy @a _size bytes of @a _source at offset @a _sourceOffset to
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	std::map<u256, uint8_t>& _target,
+	PagedMemory& _target,
 	bytes const& _source,
 	size_t _targetOffset,
 	size_t _sourceOffset,
@@ -62,8 +64,8 @@ void copyZeroExtended(
 /// When target and source areas overlap, behaves as if the data was copied
 /// using an intermediate buffer.
 void copyZeroExtendedWithOverlap(
-	std::map<u256, uint8_t>& _target,
-	std::map<u256, uint8_t> const& _source,
+	PagedMemory& _target,
+	PagedMemory const& _source,
 	size_t _targetOffset,
 	size_t _sourceOffset,
 	size_t _size
@@ -66,8 +66,13 @@ void InterpreterState::dumpTraceAndState(std::ostream& _out, bool _disableMemory
 	{
 		_out << "Memory dump:\n";
 		std::map<u256, u256> words;
-		for (auto const& [offset, value]: memory)
-			words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
+		for (auto const& [pageIndex, page]: memory.pages())
+			for (size_t i = 0; i < page.size(); ++i)
+				if (page[i] != 0)
+				{
+					u256 const offset = pageIndex * PagedMemory::PageSize + i;
+					words[(offset / 0x20) * 0x20] |= u256(uint32_t(page[i])) << (256 - 8 - 8 * static_cast<size_t>(offset % 0x20));
+				}
 		for (auto const& [offset, value]: words)
 			if (value != 0)
 				_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << std::endl;
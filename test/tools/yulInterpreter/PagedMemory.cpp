@@ -0,0 +1,71 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Sparse byte-addressed memory of the Yul interpreter.
+ */
+
+#include <test/tools/yulInterpreter/PagedMemory.h>
+
+#include <algorithm>
+
+using namespace solidity;
+using namespace solidity::yul::test;
+
+uint8_t& PagedMemory::operator[](u256 const& _offset)
+{
+	return m_pages[pageIndex(_offset)][pageOffset(_offset)];
+}
+
+uint8_t PagedMemory::get(u256 const& _offset) const
+{
+	auto page = m_pages.find(pageIndex(_offset));
+	if (page == m_pages.end())
+		return 0;
+	return page->second[pageOffset(_offset)];
+}
+
+bytes PagedMemory::read(u256 const& _offset, size_t _size) const
+{
+	bytes data(_size, uint8_t(0));
+	size_t done = 0;
+	while (done < _size)
+	{
+		u256 const offset = _offset + done;
+		size_t const inPage = pageOffset(offset);
+		size_t const chunk = std::min(_size - done, PageSize - inPage);
+		auto page = m_pages.find(pageIndex(offset));
+		if (page != m_pages.end())
+			std::copy_n(page->second.begin() + static_cast<std::ptrdiff_t>(inPage), chunk, data.begin() + static_cast<std::ptrdiff_t>(done));
+		done += chunk;
+	}
+	return data;
+}
+
+void PagedMemory::write(u256 const& _offset, uint8_t const* _data, size_t _size)
+{
+	size_t done = 0;
+	while (done < _size)
+	{
+		u256 const offset = _offset + done;
+		size_t const inPage = pageOffset(offset);
+		size_t const chunk = std::min(_size - done, PageSize - inPage);
+		Page& page = m_pages[pageIndex(offset)];
+		std::copy_n(_data + done, chunk, page.begin() + static_cast<std::ptrdiff_t>(inPage));
+		done += chunk;
+	}
+}
@@ -0,0 +1,68 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Sparse byte-addressed memory of the Yul interpreter.
+ */
+
+#pragma once
+
+#include <libsolutil/Numeric.h>
+#include <libsolutil/CommonData.h>
+
+#include <array>
+#include <map>
+
+namespace solidity::yul::test
+{
+
+/**
+ * Sparse memory addressed by 256 bit offsets that stores its contents in
+ * fixed-size pages of contiguous bytes that are allocated (and zero-initialized)
+ * on first write.
+ * Reading from a location that was never written to yields zero.
+ *
+ * Offsets wrap around modulo 2**256, just like the arithmetic on u256 does.
+ */
+class PagedMemory
+{
+public:
+	static constexpr size_t PageSize = 0x1000;
+	using Page = std::array<uint8_t, PageSize>;
+
+	/// @returns a reference to the byte at @a _offset, allocating its page if necessary.
+	uint8_t& operator[](u256 const& _offset);
+	/// @returns the byte at @a _offset or zero if its page was never allocated.
+	uint8_t get(u256 const& _offset) const;
+
+	/// @returns @a _size bytes starting at @a _offset. Does not allocate pages.
+	bytes read(u256 const& _offset, size_t _size) const;
+	/// Writes @a _size bytes from @a _data to the memory starting at @a _offset.
+	void write(u256 const& _offset, uint8_t const* _data, size_t _size);
+	void write(u256 const& _offset, bytes const& _data) { write(_offset, _data.data(), _data.size()); }
+
+	/// @returns all allocated pages by page index, i.e. by offset divided by the page size.
+	std::map<u256, Page> const& pages() const { return m_pages; }
+
+private:
+	static u256 pageIndex(u256 const& _offset) { return _offset / PageSize; }
+	static size_t pageOffset(u256 const& _offset) { return static_cast<size_t>(_offset % PageSize); }
+
+	std::map<u256, Page> m_pages;
+};
+
+}